@@ -0,0 +1,617 @@
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cmath>
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <new>
+#include <numeric>
+#include <random>
+#include <string>
+#include <vector>
+
+#ifdef _WIN32
+#include <windows.h>
+#include <psapi.h>
+#else
+#include <sys/resource.h>
+#endif
+
+#include "hullcore/calipers.h"
+#include "hullcore/containment.h"
+#include "hullcore/dynamic_hull.h"
+#include "hullcore/gjk.h"
+#include "hullcore/hull.h"
+#include "hullcore/incremental_hull.h"
+#include "hullcore/intersection.h"
+#include "hullcore/minkowski.h"
+#include "hullcore/quickhull3.h"
+#include "hullcore/simd_kernels.h"
+#include "scene/picker.h"
+#include "scene/raster_canvas.h"
+#include "scene/shapes.h"
+
+using namespace std;
+using namespace hullcore;
+
+// Every allocation made by the process, the library included, goes through
+// these counters so each case can report how often and how much it allocated.
+namespace {
+
+struct AllocationCounters {
+    atomic<uint64_t> count{ 0 };
+    atomic<uint64_t> bytes{ 0 };
+    atomic<int64_t> live{ 0 };
+    atomic<int64_t> peak{ 0 };
+};
+
+AllocationCounters allocations;
+
+// Sits just below every block handed out, so delete knows what it frees.
+struct AllocationHeader {
+    void* raw;
+    size_t size;
+};
+
+void* countedAllocate(size_t size, size_t alignment)
+{
+    alignment = max(alignment, alignof(max_align_t));
+    void* raw = malloc(size + alignment + sizeof(AllocationHeader));
+    if (!raw) {
+        throw bad_alloc();
+    }
+    uintptr_t user = (reinterpret_cast<uintptr_t>(raw) + sizeof(AllocationHeader) + alignment - 1) / alignment * alignment;
+    AllocationHeader* header = reinterpret_cast<AllocationHeader*>(user) - 1;
+    header->raw = raw;
+    header->size = size;
+
+    allocations.count.fetch_add(1, memory_order_relaxed);
+    allocations.bytes.fetch_add(size, memory_order_relaxed);
+    int64_t live = allocations.live.fetch_add(int64_t(size), memory_order_relaxed) + int64_t(size);
+    int64_t peak = allocations.peak.load(memory_order_relaxed);
+    while (live > peak && !allocations.peak.compare_exchange_weak(peak, live, memory_order_relaxed)) {
+    }
+    return reinterpret_cast<void*>(user);
+}
+
+void countedFree(void* pointer)
+{
+    if (!pointer) {
+        return;
+    }
+    AllocationHeader* header = static_cast<AllocationHeader*>(pointer) - 1;
+    allocations.live.fetch_sub(int64_t(header->size), memory_order_relaxed);
+    free(header->raw);
+}
+
+}
+
+void* operator new(size_t size) { return countedAllocate(size, 0); }
+void* operator new[](size_t size) { return countedAllocate(size, 0); }
+void* operator new(size_t size, align_val_t alignment) { return countedAllocate(size, size_t(alignment)); }
+void* operator new[](size_t size, align_val_t alignment) { return countedAllocate(size, size_t(alignment)); }
+void operator delete(void* pointer) noexcept { countedFree(pointer); }
+void operator delete[](void* pointer) noexcept { countedFree(pointer); }
+void operator delete(void* pointer, size_t) noexcept { countedFree(pointer); }
+void operator delete[](void* pointer, size_t) noexcept { countedFree(pointer); }
+void operator delete(void* pointer, align_val_t) noexcept { countedFree(pointer); }
+void operator delete[](void* pointer, align_val_t) noexcept { countedFree(pointer); }
+void operator delete(void* pointer, size_t, align_val_t) noexcept { countedFree(pointer); }
+void operator delete[](void* pointer, size_t, align_val_t) noexcept { countedFree(pointer); }
+
+namespace {
+
+const char* usage =
+    "usage: hullcore_bench_suite [options]\n"
+    "  --format table|json   aligned table (default) or one JSON object per line\n"
+    "  --min-size N          smallest input, default 100\n"
+    "  --max-size N          largest input, default 100000000; sizes go up by 10x\n"
+    "  --distribution NAME   square, disk, gaussian, clustered or circle; repeatable\n"
+    "  --seconds S           time budget per case, default 0.5\n";
+
+enum class Distribution { Square, Disk, Gaussian, Clustered, Circle };
+
+const char* distributionNames[] = { "square", "disk", "gaussian", "clustered", "circle" };
+
+vector<Point2> generate(Distribution distribution, size_t count, uint32_t seed)
+{
+    const double pi = 3.141592653589793;
+    mt19937_64 rng(seed);
+    uniform_real_distribution<double> unit(0.0, 1.0);
+    normal_distribution<double> normal(0.0, 1.0);
+    vector<Point2> points(count);
+
+    Point2 centers[16];
+    for (Point2& center : centers) {
+        center = { float(2000 * unit(rng) - 1000), float(2000 * unit(rng) - 1000) };
+    }
+
+    for (Point2& point : points) {
+        switch (distribution) {
+        case Distribution::Square:
+            point = { float(2000 * unit(rng) - 1000), float(2000 * unit(rng) - 1000) };
+            break;
+        case Distribution::Disk: {
+            double radius = 1000 * sqrt(unit(rng));
+            double angle = 2 * pi * unit(rng);
+            point = { float(radius * cos(angle)), float(radius * sin(angle)) };
+            break;
+        }
+        case Distribution::Gaussian:
+            point = { float(333 * normal(rng)), float(333 * normal(rng)) };
+            break;
+        case Distribution::Clustered: {
+            Point2 center = centers[rng() % 16];
+            point = { float(center.x + 20 * normal(rng)), float(center.y + 20 * normal(rng)) };
+            break;
+        }
+        case Distribution::Circle: {
+            double angle = 2 * pi * unit(rng);
+            point = { float(1000 * cos(angle)), float(1000 * sin(angle)) };
+            break;
+        }
+        }
+    }
+    return points;
+}
+
+// The 3D counterparts: cube, ball, gaussian, clusters and sphere.
+vector<Point3> generate3(Distribution distribution, size_t count, uint32_t seed)
+{
+    mt19937_64 rng(seed);
+    uniform_real_distribution<double> unit(0.0, 1.0);
+    normal_distribution<double> normal(0.0, 1.0);
+    vector<Point3> points(count);
+
+    Point3 centers[16];
+    for (Point3& center : centers) {
+        center = { float(2000 * unit(rng) - 1000), float(2000 * unit(rng) - 1000), float(2000 * unit(rng) - 1000) };
+    }
+
+    for (Point3& point : points) {
+        switch (distribution) {
+        case Distribution::Square:
+            point = { float(2000 * unit(rng) - 1000), float(2000 * unit(rng) - 1000), float(2000 * unit(rng) - 1000) };
+            break;
+        case Distribution::Disk:
+        case Distribution::Circle: {
+            double x = normal(rng), y = normal(rng), z = normal(rng);
+            double radius = distribution == Distribution::Disk ? 1000 * cbrt(unit(rng)) : 1000.0;
+            double scale = radius / sqrt(x * x + y * y + z * z);
+            point = { float(x * scale), float(y * scale), float(z * scale) };
+            break;
+        }
+        case Distribution::Gaussian:
+            point = { float(333 * normal(rng)), float(333 * normal(rng)), float(333 * normal(rng)) };
+            break;
+        case Distribution::Clustered: {
+            Point3 center = centers[rng() % 16];
+            point = { float(center.x + 20 * normal(rng)), float(center.y + 20 * normal(rng)),
+                float(center.z + 20 * normal(rng)) };
+            break;
+        }
+        }
+    }
+    return points;
+}
+
+uint64_t peakResidentBytes()
+{
+#ifdef _WIN32
+    PROCESS_MEMORY_COUNTERS counters;
+    if (GetProcessMemoryInfo(GetCurrentProcess(), &counters, sizeof(counters))) {
+        return counters.PeakWorkingSetSize;
+    }
+    return 0;
+#else
+    rusage usage;
+    getrusage(RUSAGE_SELF, &usage);
+#ifdef __APPLE__
+    return uint64_t(usage.ru_maxrss);
+#else
+    return uint64_t(usage.ru_maxrss) * 1024;
+#endif
+#endif
+}
+
+struct Settings {
+    bool json = false;
+    size_t minSize = 100;
+    size_t maxSize = 100000000;
+    vector<Distribution> distributions;
+    double secondsPerCase = 0.5;
+};
+
+struct Measurement {
+    double seconds = 0;
+    uint64_t allocationCount = 0;
+    uint64_t allocatedBytes = 0;
+    int64_t peakHeapBytes = 0;
+};
+
+// One untimed run counts allocations and the heap high-water mark above
+// what was live before the case; timed runs follow until the budget is spent
+// (at least one, at most 20) and the fastest is kept.
+template <class F>
+Measurement measure(const Settings& settings, F&& body)
+{
+    Measurement result;
+    int64_t baseline = allocations.live.load();
+    allocations.peak.store(baseline);
+    uint64_t countBefore = allocations.count.load();
+    uint64_t bytesBefore = allocations.bytes.load();
+    body();
+    result.allocationCount = allocations.count.load() - countBefore;
+    result.allocatedBytes = allocations.bytes.load() - bytesBefore;
+    result.peakHeapBytes = allocations.peak.load() - baseline;
+
+    result.seconds = 1e300;
+    double spent = 0;
+    for (int run = 0; run < 20 && (run == 0 || spent < settings.secondsPerCase); run++) {
+        auto start = chrono::steady_clock::now();
+        body();
+        double seconds = chrono::duration<double>(chrono::steady_clock::now() - start).count();
+        result.seconds = min(result.seconds, seconds);
+        spent += seconds;
+    }
+    return result;
+}
+
+void report(const Settings& settings, const char* bench, const char* variant, Distribution distribution, size_t count,
+    size_t items, const char* unit, size_t resultSize, const Measurement& m)
+{
+    double nsPerItem = items ? m.seconds * 1e9 / items : 0.0;
+    if (settings.json) {
+        printf("{\"bench\":\"%s\",\"variant\":\"%s\",\"distribution\":\"%s\",\"n\":%zu,\"items\":%zu,\"unit\":\"%s\","
+               "\"ns_per_item\":%.4f,\"seconds\":%.9f,\"allocations\":%llu,\"allocated_bytes\":%llu,"
+               "\"peak_heap_bytes\":%lld,\"peak_rss_bytes\":%llu,\"result\":%zu}\n",
+            bench, variant, distributionNames[size_t(distribution)], count, items, unit, nsPerItem, m.seconds,
+            (unsigned long long)m.allocationCount, (unsigned long long)m.allocatedBytes, (long long)m.peakHeapBytes,
+            (unsigned long long)peakResidentBytes(), resultSize);
+    }
+    else {
+        printf("%-9s %-22s %-9s %11zu %10.3f ns/%-6s %8llu allocs %10.1f MB peak  (%zu)\n", bench, variant,
+            distributionNames[size_t(distribution)], count, nsPerItem, unit, (unsigned long long)m.allocationCount,
+            m.peakHeapBytes / 1048576.0, resultSize);
+    }
+    fflush(stdout);
+}
+
+// Strictly convex polygon with count vertices (rounded down to even) on the
+// integer grid: its edges are the shortest primitive vectors, each together
+// with its negation, in angle order. The coordinates stay exact in float up
+// to well past latticeMaxVertices.
+vector<Point2> latticePolygon(size_t count)
+{
+    vector<pair<int, int>> edges;
+    for (int norm = 1; edges.size() + 2 <= count; norm++) {
+        for (int a = -norm; a < norm && edges.size() + 2 <= count; a++) {
+            int b = norm - abs(a);
+            if (gcd(a, b) == 1) {
+                edges.push_back({ a, b });
+                edges.push_back({ -a, -b });
+            }
+        }
+    }
+    sort(edges.begin(), edges.end(), [](pair<int, int> u, pair<int, int> v) {
+        return atan2(u.second, u.first) < atan2(v.second, v.first);
+    });
+
+    vector<Point2> polygon;
+    int x = 0;
+    int y = 0;
+    for (pair<int, int> edge : edges) {
+        polygon.push_back({ float(x), float(y) });
+        x += edge.first;
+        y += edge.second;
+    }
+    return polygon;
+}
+
+vector<Point2> hullOf(const vector<Point2>& points)
+{
+    vector<size_t> indices;
+    CalculateHull(points.data(), points.size(), indices);
+    vector<Point2> hull;
+    for (size_t index : indices) {
+        hull.push_back(points[index]);
+    }
+    return hull;
+}
+
+const size_t dynamicHullMaxCount = 10000000;
+const size_t hull3MaxCount = 10000000;
+// On the sphere every point is a hull vertex, and the mesh costs about 2 KB
+// of peak memory per vertex.
+const size_t hull3SphereMaxCount = 1000000;
+const size_t dynamicHullMoves = 1000;
+const size_t latticeMaxVertices = 100000;
+// Every point of the render and pick cases is its own heap-allocated shape.
+const size_t renderMaxCount = 1000000;
+const size_t pickMaxCount = 1000000;
+const size_t pickQueries = 1000;
+const size_t linearPickQueries = 16;
+
+void runCase(const Settings& settings, Distribution distribution, size_t count)
+{
+    vector<Point2> points = generate(distribution, count, 1);
+
+    struct Engine { HullEngine engine; bool prefilter; const char* name; };
+    Engine engines[] = {
+        { HullEngine::QuickHull, false, "quickhull" },
+        { HullEngine::SimdQuickHull, false, "simd-quickhull" },
+        { HullEngine::ParallelQuickHull, false, "parallel-quickhull" },
+        { HullEngine::MonotoneChain, false, "monotone-chain" },
+        { HullEngine::Chan, false, "chan" },
+        { HullEngine::QuickHull, true, "quickhull+prefilter" },
+    };
+    vector<size_t> hull;
+    for (const Engine& engine : engines) {
+        HullOptions options;
+        options.prefilter = engine.prefilter;
+        Measurement m = measure(settings, [&] { CalculateHull(points.data(), count, hull, engine.engine, options); });
+        report(settings, "hull", engine.name, distribution, count, count, "point", hull.size(), m);
+    }
+
+    // The same points again, arriving one at a time.
+    IncrementalHull online;
+    Measurement m = measure(settings, [&] {
+        online.Reset();
+        for (Point2 point : points) {
+            online.Insert(point);
+        }
+    });
+    report(settings, "hull", "incremental", distribution, count, count, "point", online.VertexCount(), m);
+
+    // The dynamic hull takes about 110 bytes a point, so the largest inputs
+    // are left out. Each move sends a point to a position drawn from the same
+    // distribution; the targets are not reused within a case, as piling
+    // points onto occupied positions would leave the tree untouched.
+    if (count <= dynamicHullMaxCount) {
+        DynamicHull dynamic;
+        m = measure(settings, [&] { dynamic.Build(points.data(), count); });
+        vector<Point2> vertices;
+        dynamic.Vertices(vertices);
+        report(settings, "hull", "dynamic-build", distribution, count, count, "point", vertices.size(), m);
+
+        vector<Point2> targets = generate(distribution, 32 * dynamicHullMoves, 4);
+        size_t moveCount = 0;
+        m = measure(settings, [&] {
+            for (size_t i = 0; i < dynamicHullMoves; i++, moveCount++) {
+                dynamic.Move(moveCount % count, targets[moveCount % targets.size()]);
+            }
+        });
+        dynamic.Vertices(vertices);
+        report(settings, "dynamic", "move", distribution, count, dynamicHullMoves, "update", vertices.size(), m);
+    }
+
+    // Queries come from the same distribution as the hull's points, so the
+    // inside/outside mix is the one the distribution naturally produces.
+    vector<Point2> a = hullOf(points);
+    vector<Point2> queries = generate(distribution, count, 2);
+    ConvexHullQuery query;
+    query.Build(a.data(), a.size());
+    vector<Containment> labels(count);
+    m = measure(settings, [&] { query.ClassifyBatch(queries.data(), count, labels.data()); });
+    size_t inside = size_t(count_if(labels.begin(), labels.end(), [](Containment c) { return c != Containment::Outside; }));
+    report(settings, "contains", "classify-batch", distribution, count, count, "point", inside, m);
+    queries = vector<Point2>();
+    labels = vector<Containment>();
+
+    // Every caliper measurement from one sweep, then the diameter alone. Float
+    // rounding leaves only part of a dense circle in convex position, so the
+    // circle cases use a lattice polygon with count vertices instead, and so
+    // measure hulls as large as latticeMaxVertices.
+    vector<Point2> caliperHull = distribution == Distribution::Circle ? latticePolygon(min(count, latticeMaxVertices)) : a;
+    CaliperResult calipers;
+    m = measure(settings, [&] { RotatingCalipers(caliperHull.data(), caliperHull.size(), CALIPER_ALL, calipers); });
+    report(settings, "calipers", "all", distribution, count, caliperHull.size(), "vertex",
+        calipers.antipodalPairs.size(), m);
+    m = measure(settings, [&] { RotatingCalipers(caliperHull.data(), caliperHull.size(), CALIPER_DIAMETER, calipers); });
+    report(settings, "calipers", "diameter", distribution, count, caliperHull.size(), "vertex", caliperHull.size(), m);
+    caliperHull = vector<Point2>();
+
+    vector<Point2> b = hullOf(generate(distribution, count, 3));
+    for (Point2& point : b) {
+        point = { point.x * 0.5f + 1500.0f, point.y * 0.5f };
+    }
+    vector<Point2> result;
+    m = measure(settings, [&] { ConvexMinkowskiSum(a.data(), a.size(), b.data(), b.size(), result); });
+    report(settings, "minkowski", "sum", distribution, count, a.size() + b.size(), "vertex", result.size(), m);
+    m = measure(settings, [&] { ConvexMinkowskiDiff(a.data(), a.size(), b.data(), b.size(), result); });
+    report(settings, "minkowski", "diff", distribution, count, a.size() + b.size(), "vertex", result.size(), m);
+
+    // B is slid along x from overlapping a to well clear of it, and the
+    // time is per query over the whole sweep.
+    const size_t gjkQueries = 64;
+    vector<vector<Point2>> shifted(gjkQueries, b);
+    for (size_t q = 0; q < gjkQueries; q++) {
+        float offset = -1500.0f + 3000.0f * q / gjkQueries;
+        for (Point2& point : shifted[q]) {
+            point.x += offset;
+        }
+    }
+    size_t overlapping = 0;
+    m = measure(settings, [&] {
+        overlapping = 0;
+        for (const vector<Point2>& other : shifted) {
+            overlapping += GjkQuery(a.data(), a.size(), other.data(), other.size()).intersecting;
+        }
+    });
+    report(settings, "gjk", "query", distribution, count, gjkQueries, "query", overlapping, m);
+
+    // The same sweep asks for the shared polygon: once for a pair that
+    // overlaps by about half, then for the whole sweep as one batch.
+    const vector<Point2>& half = shifted[gjkQueries / 4];
+    vector<Point2> overlap;
+    m = measure(settings, [&] { ConvexIntersection(a.data(), a.size(), half.data(), half.size(), overlap); });
+    report(settings, "intersect", "pair", distribution, count, a.size() + half.size(), "vertex", overlap.size(), m);
+    vector<PolygonRef> others;
+    for (const vector<Point2>& other : shifted) {
+        others.push_back({ other.data(), other.size() });
+    }
+    vector<double> areas(gjkQueries);
+    m = measure(settings, [&] { ConvexIntersectionBatch(a.data(), a.size(), others.data(), gjkQueries, areas.data()); });
+    size_t sharing = size_t(count_if(areas.begin(), areas.end(), [](double area) { return area > 0; }));
+    report(settings, "intersect", "batch", distribution, count, gjkQueries, "query", sharing, m);
+    shifted = vector<vector<Point2>>();
+
+    if (count <= (distribution == Distribution::Circle ? hull3SphereMaxCount : hull3MaxCount)) {
+        vector<Point3> points3 = generate3(distribution, count, 5);
+        HalfEdgeMesh mesh;
+        m = measure(settings, [&] { CalculateQuickHull3(points3.data(), count, mesh); });
+        report(settings, "hull3", "quickhull3", distribution, count, count, "point", mesh.vertices.size(), m);
+    }
+
+    // One 1920x1080 frame of the QuickHull scene drawn headless: grid, every
+    // point, then the hull, which is already built so only drawing is timed.
+    if (count <= renderMaxCount) {
+        RasterCanvas canvas(1920, 1080);
+        Grid grid;
+        grid.lineSpacing = 50.0f;
+        grid.gridLinesStrokeWidth = 1.0f;
+        grid.axisLinesStrokeWidth = 2.0f;
+        grid.gridLinesColor = ColorFromRgb(0x808080);
+        grid.axisLinesColor = ColorFromRgb(0xFFFFFF);
+        QuickHull scene;
+        for (Point2 point : points) {
+            MoveablePoint* shape = new MoveablePoint();
+            shape->center = { 960.0f + point.x * 0.5f, 540.0f + point.y * 0.5f };
+            shape->radius = 2.0f;
+            shape->fillColor = ColorFromRgb(0x0000FF);
+            scene.points.push_back(shape);
+        }
+        scene.UpdateHull();
+        m = measure(settings, [&] {
+            canvas.Clear(ColorFromRgb(0x000000));
+            grid.Draw(canvas);
+            for (MoveablePoint* shape : scene.points) {
+                shape->Draw(canvas);
+            }
+            scene.Draw(canvas);
+        });
+        report(settings, "render", "frame", distribution, count, count, "point", scene.hullPoints.size(), m);
+        for (MoveablePoint* shape : scene.points) {
+            delete shape;
+        }
+    }
+
+    // Picking among count unit-radius points in the distribution's own
+    // coordinates, through the grid and, for comparison, the backwards walk
+    // over every shape that the window app used to do. Drags move a point to
+    // a query position and refile it.
+    if (count <= pickMaxCount) {
+        vector<Shape*> shapes;
+        for (Point2 point : points) {
+            MoveablePoint* shape = new MoveablePoint();
+            shape->center = point;
+            shape->radius = 1.0f;
+            shapes.push_back(shape);
+        }
+        vector<Point2> clicks = generate(distribution, pickQueries, 2);
+        ShapePicker picker(4.0f);
+        m = measure(settings, [&] { picker.Build(shapes); });
+        report(settings, "pick", "grid-build", distribution, count, count, "point", count, m);
+
+        size_t hits = 0;
+        m = measure(settings, [&] {
+            hits = 0;
+            for (Point2 click : clicks) {
+                hits += picker.Pick(click.x, click.y, NONE) >= 0;
+            }
+        });
+        report(settings, "pick", "grid", distribution, count, pickQueries, "query", hits, m);
+
+        m = measure(settings, [&] {
+            hits = 0;
+            for (size_t q = 0; q < linearPickQueries; q++) {
+                for (size_t i = shapes.size(); i-- > 0;) {
+                    if (shapes[i]->IsMouseOverlapping(clicks[q].x, clicks[q].y)) {
+                        hits++;
+                        break;
+                    }
+                }
+            }
+        });
+        report(settings, "pick", "linear", distribution, count, linearPickQueries, "query", hits, m);
+
+        size_t dragCount = 0;
+        m = measure(settings, [&] {
+            for (Point2 click : clicks) {
+                size_t index = dragCount++ % count;
+                shapes[index]->OnMouseDrag(click.x, click.y);
+                picker.Moved(int(index));
+            }
+        });
+        report(settings, "pick", "drag", distribution, count, pickQueries, "update", count, m);
+        for (Shape* shape : shapes) {
+            delete shape;
+        }
+    }
+}
+
+bool parseArguments(int argc, char** argv, Settings& settings)
+{
+    for (int i = 1; i < argc; i++) {
+        string argument = argv[i];
+        bool hasValue = i + 1 < argc;
+        if (argument == "--format" && hasValue) {
+            string format = argv[++i];
+            if (format != "table" && format != "json")
+                return false;
+            settings.json = format == "json";
+        }
+        else if (argument == "--min-size" && hasValue) {
+            settings.minSize = max<size_t>(1, strtoull(argv[++i], nullptr, 10));
+        }
+        else if (argument == "--max-size" && hasValue) {
+            settings.maxSize = strtoull(argv[++i], nullptr, 10);
+        }
+        else if (argument == "--seconds" && hasValue) {
+            settings.secondsPerCase = strtod(argv[++i], nullptr);
+        }
+        else if (argument == "--distribution" && hasValue) {
+            string name = argv[++i];
+            auto found = find(begin(distributionNames), end(distributionNames), name);
+            if (found == end(distributionNames))
+                return false;
+            settings.distributions.push_back(Distribution(found - begin(distributionNames)));
+        }
+        else {
+            return false;
+        }
+    }
+    if (settings.distributions.empty()) {
+        settings.distributions = { Distribution::Square, Distribution::Disk, Distribution::Gaussian,
+            Distribution::Clustered, Distribution::Circle };
+    }
+    return true;
+}
+
+}
+
+int main(int argc, char** argv)
+{
+    Settings settings;
+    if (!parseArguments(argc, argv, settings)) {
+        fputs(usage, stderr);
+        return 2;
+    }
+
+    if (settings.json) {
+        printf("{\"suite\":\"hullcore\",\"format\":1,\"simd\":\"%s\"}\n", SimdLevelName(DetectSimdLevel()));
+    }
+    else {
+        printf("detected simd level: %s\n", SimdLevelName(DetectSimdLevel()));
+    }
+    for (Distribution distribution : settings.distributions) {
+        for (size_t count = settings.minSize; count <= settings.maxSize; count *= 10) {
+            runCase(settings, distribution, count);
+            if (count > settings.maxSize / 10)
+                break;
+        }
+    }
+    return 0;
+}
@@ -0,0 +1,430 @@
+#include <chrono>
+#include <cmath>
+#include <cstdio>
+#include <cstdlib>
+#include <random>
+#include <vector>
+
+#include "hullcore/broad_phase.h"
+#include "hullcore/containment.h"
+#include "hullcore/gjk.h"
+#include "hullcore/hull.h"
+#include "hullcore/minkowski.h"
+#include "hullcore/point_set.h"
+#include "hullcore/simd_kernels.h"
+#include "hullcore/streaming_hull.h"
+#include "hullcore/task_pool.h"
+
+using namespace std;
+using namespace hullcore;
+
+namespace {
+
+template <class F>
+double timeBest(int repeats, F&& body)
+{
+    double best = 1e300;
+    for (int r = 0; r < repeats; r++) {
+        auto start = chrono::steady_clock::now();
+        body();
+        double seconds = chrono::duration<double>(chrono::steady_clock::now() - start).count();
+        best = min(best, seconds);
+    }
+    return best;
+}
+
+// hullSize points on a circle and the rest scattered in the thin band just
+// inside the polygon they form, so the hull size is fixed and many points
+// stay close to it, which is where output sensitivity matters.
+void benchByHullSize(size_t count, size_t hullSize)
+{
+    mt19937 rng(23);
+    uniform_real_distribution<double> unit(0.0, 1.0);
+    const double pi = 3.141592653589793;
+    vector<Point2> points(count);
+    for (size_t i = 0; i < count; i++) {
+        if (i < hullSize) {
+            double angle = 2 * pi * i / hullSize;
+            points[i] = { float(1000.0 * cos(angle)), float(1000.0 * sin(angle)) };
+            continue;
+        }
+        size_t edge = rng() % hullSize;
+        double a0 = 2 * pi * edge / hullSize;
+        double a1 = 2 * pi * (edge + 1) / hullSize;
+        double t = unit(rng);
+        double shrink = 1.0 - 0.01 * unit(rng);
+        double x = ((1 - t) * cos(a0) + t * cos(a1)) * 1000.0 * shrink;
+        double y = ((1 - t) * sin(a0) + t * sin(a1)) * 1000.0 * shrink;
+        points[i] = { float(x), float(y) };
+    }
+
+    struct Engine { HullEngine engine; const char* name; };
+    Engine engines[] = {
+        { HullEngine::QuickHull, "quickhull" },
+        { HullEngine::ParallelQuickHull, "parallel-quickhull" },
+        { HullEngine::MonotoneChain, "monotone-chain" },
+        { HullEngine::Chan, "chan" },
+    };
+    vector<size_t> hull;
+    for (const Engine& engine : engines) {
+        double seconds = timeBest(3, [&] { CalculateHull(points.data(), count, hull, engine.engine); });
+        printf("by-h      %-18s n=%-10zu h=%-7zu %8.3f ns/point  (%zu vertices)\n",
+            engine.name, count, hullSize, seconds * 1e9 / count, hull.size());
+    }
+}
+
+void benchFarthestKernel(size_t count)
+{
+    mt19937 rng(7);
+    uniform_real_distribution<float> coordinate(-1000.0f, 1000.0f);
+    vector<float> x(count), y(count);
+    for (size_t i = 0; i < count; i++) {
+        x[i] = coordinate(rng);
+        y[i] = coordinate(rng);
+    }
+
+    Point2 p1{ -1000.0f, -3.0f };
+    Point2 p2{ 1000.0f, 5.0f };
+    double scalarTime = 0;
+    SimdLevel levels[] = { SimdLevel::Scalar, SimdLevel::SSE2, SimdLevel::AVX2, SimdLevel::AVX512 };
+    for (SimdLevel level : levels) {
+        if (level > DetectSimdLevel())
+            continue;
+        FarthestPoint result{};
+        double seconds = timeBest(5, [&] { result = FindFarthest(x.data(), y.data(), count, p1, p2, level); });
+        if (level == SimdLevel::Scalar)
+            scalarTime = seconds;
+        printf("farthest  %-8s n=%-10zu %8.3f ns/point  speedup %5.2fx  (pos %zu)\n",
+            SimdLevelName(level), count, seconds * 1e9 / count, scalarTime / seconds, result.position);
+    }
+}
+
+void benchEngines(size_t count)
+{
+    mt19937 rng(11);
+    uniform_real_distribution<float> coordinate(-1000.0f, 1000.0f);
+    vector<Point2> points(count);
+    for (Point2& point : points) {
+        point = { coordinate(rng), coordinate(rng) };
+    }
+
+    struct Engine { HullEngine engine; const char* name; };
+    Engine engines[] = {
+        { HullEngine::QuickHull, "quickhull" },
+        { HullEngine::SimdQuickHull, "simd-quickhull" },
+        { HullEngine::ParallelQuickHull, "parallel-quickhull" },
+        { HullEngine::MonotoneChain, "monotone-chain" },
+        { HullEngine::Chan, "chan" },
+    };
+    vector<size_t> hull;
+    for (const Engine& engine : engines) {
+        double seconds = timeBest(3, [&] { CalculateHull(points.data(), count, hull, engine.engine); });
+        printf("hull      %-18s n=%-10zu %8.3f ns/point  (%zu vertices)\n",
+            engine.name, count, seconds * 1e9 / count, hull.size());
+    }
+
+    HullOptions options;
+    options.prefilter = true;
+    HullStats stats;
+    for (const Engine& engine : engines) {
+        double seconds = timeBest(3, [&] { CalculateHull(points.data(), count, hull, engine.engine, options, &stats); });
+        printf("filtered  %-18s n=%-10zu %8.3f ns/point  (%zu vertices, %.2f%% rejected)\n",
+            engine.name, count, seconds * 1e9 / count, hull.size(), stats.RejectionRatio() * 100);
+    }
+}
+
+ConvexHullQuery circleQuery(size_t hullSize)
+{
+    vector<Point2> points(hullSize);
+    for (size_t i = 0; i < hullSize; i++) {
+        double angle = 6.283185307179586 * i / hullSize;
+        points[i] = { float(1000.0 * cos(angle)), float(1000.0 * sin(angle)) };
+    }
+    vector<size_t> hull;
+    CalculateHull(points.data(), points.size(), hull);
+    vector<Point2> vertices;
+    for (size_t index : hull) {
+        vertices.push_back(points[index]);
+    }
+
+    ConvexHullQuery query;
+    query.Build(vertices.data(), vertices.size());
+    return query;
+}
+
+vector<Point2> querySamples(size_t queries)
+{
+    mt19937 rng(13);
+    uniform_real_distribution<float> coordinate(-1200.0f, 1200.0f);
+    vector<Point2> samples(queries);
+    for (Point2& sample : samples) {
+        sample = { coordinate(rng), coordinate(rng) };
+    }
+    return samples;
+}
+
+void benchContainment(size_t hullSize, size_t queries)
+{
+    ConvexHullQuery query = circleQuery(hullSize);
+    const vector<Point2>& vertices = query.vertices;
+    vector<Point2> samples = querySamples(queries);
+
+    size_t inside = 0;
+    double seconds = timeBest(3, [&] {
+        inside = 0;
+        for (const Point2& sample : samples) {
+            inside += query.Contains(sample);
+        }
+    });
+    printf("contains  h=%-10zu q=%-10zu %8.3f ns/query  (%zu inside)\n",
+        vertices.size(), queries, seconds * 1e9 / queries, inside);
+}
+
+void benchBatchContainment(size_t hullSize, size_t queries)
+{
+    ConvexHullQuery query = circleQuery(hullSize);
+    vector<Point2> samples = querySamples(queries);
+    vector<uint64_t> mask((queries + 63) / 64);
+
+    double seconds = timeBest(3, [&] { query.ContainsBatch(samples.data(), queries, mask.data()); });
+    printf("batch     h=%-10zu q=%-10zu %8.3f Mpoints/s  (%u threads)\n",
+        query.vertices.size(), queries, queries / seconds * 1e-6, TaskPool::Default().ThreadCount());
+}
+
+void benchMinkowski(size_t hullSize)
+{
+    vector<Point2> a = circleQuery(hullSize).vertices;
+    vector<Point2> b = a;
+    for (Point2& point : b) {
+        point = { point.x * 0.5f + 7.0f, point.y * 0.25f - 3.0f };
+    }
+
+    vector<Point2> result;
+    double seconds = timeBest(5, [&] { ConvexMinkowskiSum(a.data(), a.size(), b.data(), b.size(), result); });
+    printf("msum      h=%-10zu %8.3f us  (%zu vertices)\n", a.size(), seconds * 1e6, result.size());
+    seconds = timeBest(5, [&] { ConvexMinkowskiDiff(a.data(), a.size(), b.data(), b.size(), result); });
+    printf("mdiff     h=%-10zu %8.3f us  (%zu vertices)\n", a.size(), seconds * 1e6, result.size());
+}
+
+// GJK only touches the vertices its support walks visit, against building the
+// full Minkowski difference and locating the origin in it.
+void benchGjk(size_t hullSize)
+{
+    vector<Point2> a = circleQuery(hullSize).vertices;
+    for (float offset : { 1200.0f, 1600.0f }) {
+        vector<Point2> b = a;
+        for (Point2& point : b) {
+            point = { point.x * 0.5f + offset, point.y * 0.5f };
+        }
+
+        GjkResult result;
+        double seconds = timeBest(5, [&] { result = GjkQuery(a.data(), a.size(), b.data(), b.size()); });
+        printf("gjk       h=%-10zu %8.3f us  (%s, %zu support calls)\n", a.size(), seconds * 1e6,
+            result.intersecting ? "overlap" : "separated", result.supportCalls);
+
+        GjkCache cache;
+        GjkQuery(a.data(), a.size(), b.data(), b.size(), &cache);
+        seconds = timeBest(5, [&] { result = GjkQuery(a.data(), a.size(), b.data(), b.size(), &cache); });
+        printf("gjk warm  h=%-10zu %8.3f us\n", a.size(), seconds * 1e6);
+
+        vector<Point2> difference;
+        ConvexHullQuery query;
+        bool inside = false;
+        seconds = timeBest(5, [&] {
+            ConvexMinkowskiDiff(a.data(), a.size(), b.data(), b.size(), difference);
+            query.Build(difference.data(), difference.size());
+            inside = query.Contains({ 0, 0 });
+        });
+        printf("mdiff+loc h=%-10zu %8.3f us  (%s)\n", a.size(), seconds * 1e6, inside ? "overlap" : "separated");
+    }
+}
+
+// Moving hulls drifting through a square world: per frame the boxes are
+// refreshed, the broad phase yields candidates and GJK confirms them.
+void benchBroadPhase(size_t hullCount, int frames)
+{
+    mt19937 rng(19);
+    uniform_real_distribution<float> unit(-1.0f, 1.0f);
+    float world = 1000.0f;
+
+    vector<Point2> vertices;
+    vector<size_t> firstVertex;
+    vector<Point2> positions(hullCount);
+    vector<Point2> velocities(hullCount);
+    for (size_t h = 0; h < hullCount; h++) {
+        Point2 local[8];
+        for (Point2& point : local) {
+            point = { 6.0f * unit(rng), 6.0f * unit(rng) };
+        }
+        vector<size_t> hull;
+        CalculateHull(local, 8, hull);
+        firstVertex.push_back(vertices.size());
+        for (size_t index : hull) {
+            vertices.push_back(local[index]);
+        }
+        positions[h] = { world * 0.5f * (unit(rng) + 1.0f), world * 0.5f * (unit(rng) + 1.0f) };
+        velocities[h] = { unit(rng), unit(rng) };
+    }
+    firstVertex.push_back(vertices.size());
+
+    vector<Point2> placed(vertices.size());
+    auto place = [&](size_t h) {
+        for (size_t v = firstVertex[h]; v < firstVertex[h + 1]; v++) {
+            placed[v] = { vertices[v].x + positions[h].x, vertices[v].y + positions[h].y };
+        }
+        return ComputeAabb(&placed[firstVertex[h]], firstVertex[h + 1] - firstVertex[h]);
+    };
+
+    SweepAndPrune broadPhase;
+    for (size_t h = 0; h < hullCount; h++) {
+        broadPhase.AddProxy(place(h));
+    }
+
+    vector<ProxyPair> pairs;
+    double bruteSeconds = timeBest(1, [&] {
+        pairs.clear();
+        for (uint32_t a = 0; a < hullCount; a++) {
+            for (uint32_t b = a + 1; b < hullCount; b++) {
+                if (Overlaps(broadPhase.ProxyBox(a), broadPhase.ProxyBox(b)))
+                    pairs.push_back({ a, b });
+            }
+        }
+    });
+    size_t brutePairs = pairs.size();
+    broadPhase.FindPairs(pairs);
+    printf("broad     k=%-10zu brute force %8.3f ms  sweep %zu / brute %zu pairs\n",
+        hullCount, bruteSeconds * 1e3, pairs.size(), brutePairs);
+
+    double updateSeconds = 0, serialSeconds = 0, parallelSeconds = 0, narrowSeconds = 0;
+    size_t sortMoves = 0, candidates = 0, contacts = 0;
+    for (int frame = 0; frame < frames; frame++) {
+        updateSeconds += timeBest(1, [&] {
+            for (size_t h = 0; h < hullCount; h++) {
+                Point2& position = positions[h];
+                position = { position.x + velocities[h].x, position.y + velocities[h].y };
+                if (position.x < 0 || position.x > world)
+                    velocities[h].x = -velocities[h].x;
+                if (position.y < 0 || position.y > world)
+                    velocities[h].y = -velocities[h].y;
+                broadPhase.UpdateProxy(uint32_t(h), place(h));
+            }
+        });
+        serialSeconds += timeBest(1, [&] { broadPhase.FindPairs(pairs); });
+        sortMoves += broadPhase.LastSortMoves();
+        parallelSeconds += timeBest(1, [&] { broadPhase.FindPairs(pairs, TaskPool::Default()); });
+        candidates += pairs.size();
+        narrowSeconds += timeBest(1, [&] {
+            for (const ProxyPair& pair : pairs) {
+                const Point2* a = &placed[firstVertex[pair.first]];
+                const Point2* b = &placed[firstVertex[pair.second]];
+                contacts += GjkIntersect(a, firstVertex[pair.first + 1] - firstVertex[pair.first],
+                    b, firstVertex[pair.second + 1] - firstVertex[pair.second]);
+            }
+        });
+    }
+    printf("broad     k=%-10zu per frame: update %7.3f ms  sweep %7.3f ms  parallel sweep %7.3f ms (%u threads)  gjk %7.3f ms\n",
+        hullCount, updateSeconds * 1e3 / frames, serialSeconds * 1e3 / frames, parallelSeconds * 1e3 / frames,
+        TaskPool::Default().ThreadCount(), narrowSeconds * 1e3 / frames);
+    printf("broad     k=%-10zu per frame: %zu sort moves, %zu candidates, %zu contacts\n",
+        hullCount, sortMoves / frames, candidates / frames, contacts / frames);
+}
+
+// Writes count Gaussian points to a scratch file and streams it back through
+// both sources, against hulling the same points held in memory.
+void benchStreaming(size_t count)
+{
+    const char* path = "hullcore_bench_points.bin";
+    mt19937 rng(29);
+    normal_distribution<float> coordinate(0.0f, 100.0f);
+    vector<Point2> points(count);
+    for (Point2& point : points) {
+        point = { coordinate(rng), coordinate(rng) };
+    }
+    FILE* file = fopen(path, "wb");
+    if (!file) {
+        printf("stream    cannot write %s\n", path);
+        return;
+    }
+    fwrite(points.data(), sizeof(Point2), count, file);
+    fclose(file);
+
+    vector<size_t> hull;
+    double seconds = timeBest(3, [&] { CalculateHull(points.data(), count, hull); });
+    printf("stream    %-18s n=%-10zu %8.3f ns/point  (%zu vertices)\n", "in-memory", count, seconds * 1e9 / count, hull.size());
+
+    struct Source { StreamSource source; const char* name; };
+    Source sources[] = { { StreamSource::Read, "double-buffered" }, { StreamSource::Map, "mapped" } };
+    for (const Source& source : sources) {
+        StreamingOptions options;
+        options.source = source.source;
+        StreamingHull streamed;
+        seconds = timeBest(3, [&] {
+            streamed.Reset();
+            StreamFileHull(path, options, streamed);
+        });
+        printf("stream    %-18s n=%-10zu %8.3f ns/point  (%zu vertices, chunks of %zu)\n",
+            source.name, count, seconds * 1e9 / count, streamed.Vertices().size(), options.chunkPoints);
+    }
+    remove(path);
+}
+
+void benchPointSet(size_t count)
+{
+    const char* csvPath = "hullcore_bench_points.csv";
+    const char* setPath = "hullcore_bench_points.hps";
+    mt19937 rng(31);
+    normal_distribution<float> coordinate(0.0f, 100.0f);
+    FILE* csv = fopen(csvPath, "w");
+    if (!csv) {
+        printf("pointset  cannot write %s\n", csvPath);
+        return;
+    }
+    fprintf(csv, "x,y\n");
+    for (size_t i = 0; i < count; i++) {
+        fprintf(csv, "%.9g,%.9g\n", coordinate(rng), coordinate(rng));
+    }
+    fclose(csv);
+
+    CsvImportStats stats;
+    double seconds = timeBest(1, [&] { ImportCsv(csvPath, setPath, CsvImportOptions(), TaskPool::Default(), &stats); });
+    printf("pointset  %-18s n=%-10zu %8.3f ns/point  (%llu lines skipped)\n", "csv import", count, seconds * 1e9 / count,
+        (unsigned long long)stats.skippedCount);
+
+    PointSetFile pointSet;
+    vector<size_t> hull;
+    seconds = timeBest(3, [&] {
+        pointSet.Open(setPath);
+        pointSet.CalculateHull(hull);
+    });
+    printf("pointset  %-18s n=%-10zu %8.3f ns/point  (%zu vertices)\n", "open + hull", pointSet.Count(),
+        seconds * 1e9 / count, hull.size());
+
+    pointSet.Close();
+    remove(csvPath);
+    remove(setPath);
+}
+
+}
+
+int main(int argc, char** argv)
+{
+    size_t count = argc > 1 ? strtoull(argv[1], nullptr, 10) : 4000000;
+
+    printf("detected simd level: %s\n", SimdLevelName(DetectSimdLevel()));
+    benchFarthestKernel(count);
+    benchEngines(count);
+    for (size_t hullSize : { 8, 64, 512, 4096, 32768 }) {
+        benchByHullSize(count, hullSize);
+    }
+    benchContainment(1000, 1000000);
+    benchContainment(100000, 1000000);
+    benchBatchContainment(8, 10000000);
+    benchBatchContainment(32, 10000000);
+    benchBatchContainment(1000, 10000000);
+    benchStreaming(count);
+    benchPointSet(count);
+    benchMinkowski(10000);
+    benchGjk(10000);
+    benchBroadPhase(10000, 20);
+    return 0;
+}
@@ -0,0 +1,715 @@
+#include <chrono>
+#include <cmath>
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <vector>
+
+#include "hullcore/containment.h"
+#include "hullcore/hull.h"
+#include "hullcore/minkowski.h"
+#include "hullcore/point_set.h"
+#include "hullcore/task_pool.h"
+
+using namespace std;
+using namespace hullcore;
+
+namespace {
+
+const char* usage =
+    "usage: hullcore_cli [options] <job>...\n"
+    "\n"
+    "jobs:\n"
+    "  hull FILE...              hull of each file\n"
+    "  contains HULL QUERY...    classify each query file against the hull of HULL\n"
+    "  sum A B [A B]...          Minkowski sum of the hulls of each pair\n"
+    "  diff A B [A B]...         Minkowski difference A - B of each pair\n"
+    "  import CSV OUT [CSV OUT]...  convert text to a point set file\n"
+    "\n"
+    "Inputs are point set files, raw float32 x,y pairs (.bin, .f32) or text with\n"
+    "x and y columns. Jobs run concurrently, one file-level task each.\n"
+    "\n"
+    "options:\n"
+    "  --format json|binary      JSON lines (default) or binary records\n"
+    "  -o FILE                   write results to FILE instead of stdout\n"
+    "  --jobs FILE               read more jobs from FILE, same syntax\n"
+    "  --threads N               file-level workers (default: one per core)\n"
+    "  --engine NAME             quickhull, simd-quickhull, parallel-quickhull,\n"
+    "                            monotone-chain or chan (default quickhull)\n"
+    "  --prefilter               run the Akl-Toussaint filter before the engine\n"
+    "  --x-column N, --y-column N  text input columns (default 0 and 1)\n";
+
+enum class JobKind : uint32_t { Hull, Contains, Sum, Diff, Import };
+
+const char* jobKindNames[] = { "hull", "contains", "sum", "diff", "import" };
+
+// Hull of a contains job's HULL file with its query structure, built once
+// before the jobs run and then only read by every job querying it.
+struct SharedHull {
+    bool ok = true;
+    string error;
+    vector<Point2> vertices;
+    ConvexHullQuery query;
+    double loadSeconds = 0;
+    double computeSeconds = 0;
+};
+
+struct Job {
+    JobKind kind;
+    vector<string> inputs;
+    // Contains jobs only; the first job on a hull also reports its build time.
+    shared_ptr<SharedHull> hull = nullptr;
+    bool firstOnHull = false;
+};
+
+struct Settings {
+    bool binary = false;
+    string outputPath;
+    unsigned threadCount = 0;
+    HullEngine engine = HullEngine::QuickHull;
+    HullOptions hullOptions;
+    CsvImportOptions csvOptions;
+};
+
+struct JobResult {
+    bool ok = true;
+    string error;
+    uint64_t pointCount = 0;
+    vector<Point2> vertices;
+    vector<uint64_t> indices;
+    vector<Containment> labels;
+    uint64_t containmentCounts[3] = {};
+    uint64_t skippedCount = 0;
+    double loadSeconds = 0;
+    double computeSeconds = 0;
+};
+
+// Binary output: "HULLRES\0", uint32 version, uint32 reserved, then one
+// record per job in job order. Each record is this header followed by
+// vertexCount Point2, indexCount uint64, labelCount uint8 Containment values
+// and messageBytes of error text.
+struct RecordHeader {
+    uint32_t job;
+    uint32_t kind;
+    uint32_t ok;
+    uint32_t reserved;
+    uint64_t pointCount;
+    double loadSeconds;
+    double computeSeconds;
+    uint64_t vertexCount;
+    uint64_t indexCount;
+    uint64_t labelCount;
+    uint64_t messageBytes;
+};
+
+const char resultMagic[8] = { 'H', 'U', 'L', 'L', 'R', 'E', 'S', '\0' };
+const uint32_t resultVersion = 1;
+
+double secondsSince(chrono::steady_clock::time_point start)
+{
+    return chrono::duration<double>(chrono::steady_clock::now() - start).count();
+}
+
+bool hasExtension(const string& path, const char* extension)
+{
+    size_t length = strlen(extension);
+    return path.size() >= length && path.compare(path.size() - length, length, extension) == 0;
+}
+
+bool readRawPoints(const string& path, vector<Point2>& points, string& error)
+{
+    FILE* file = fopen(path.c_str(), "rb");
+    if (!file) {
+        error = "cannot open " + path;
+        return false;
+    }
+    points.clear();
+    Point2 buffer[4096];
+    size_t bytes;
+    bool partial = false;
+    while ((bytes = fread(buffer, 1, sizeof(buffer), file)) > 0) {
+        partial = bytes % sizeof(Point2) != 0;
+        points.insert(points.end(), buffer, buffer + bytes / sizeof(Point2));
+    }
+    fclose(file);
+    if (partial) {
+        error = path + " is not a whole number of points";
+        return false;
+    }
+    return true;
+}
+
+// Non-finite coordinates have no place on a hull and no JSON spelling, so
+// inputs holding any are refused.
+template <class PointAt>
+bool checkFinite(const string& path, size_t count, PointAt pointAt, string& error)
+{
+    for (size_t i = 0; i < count; i++) {
+        Point2 point = pointAt(i);
+        if (!isfinite(point.x) || !isfinite(point.y)) {
+            error = path + ": point " + to_string(i) + " is not finite";
+            return false;
+        }
+    }
+    return true;
+}
+
+bool readPoints(const string& path, const Settings& settings, vector<Point2>& points, string& error)
+{
+    if (IsPointSetFile(path.c_str())) {
+        PointSetFile pointSet;
+        if (!pointSet.Open(path.c_str(), &error)) {
+            error = path + ": " + error;
+            return false;
+        }
+        points.resize(pointSet.Count());
+        for (size_t i = 0; i < points.size(); i++) {
+            points[i] = { pointSet.X()[i], pointSet.Y()[i] };
+        }
+        return true;
+    }
+    if (hasExtension(path, ".bin") || hasExtension(path, ".f32")) {
+        return readRawPoints(path, points, error);
+    }
+    if (!ReadCsv(path.c_str(), settings.csvOptions, TaskPool::Default(), points)) {
+        error = "cannot read " + path;
+        return false;
+    }
+    return true;
+}
+
+bool loadPoints(const string& path, const Settings& settings, vector<Point2>& points, string& error)
+{
+    return readPoints(path, settings, points, error) &&
+        checkFinite(path, points.size(), [&](size_t i) { return points[i]; }, error);
+}
+
+void hullVertices(const vector<Point2>& points, const Settings& settings, JobResult& result)
+{
+    vector<size_t> hull;
+    CalculateHull(points.data(), points.size(), hull, settings.engine, settings.hullOptions);
+    result.vertices.clear();
+    for (size_t index : hull) {
+        result.vertices.push_back(points[index]);
+    }
+    result.indices.assign(hull.begin(), hull.end());
+}
+
+void runHull(const Job& job, const Settings& settings, JobResult& result)
+{
+    auto start = chrono::steady_clock::now();
+
+    // The SIMD engine reads point set files in place, without the copy to
+    // Point2 the other engines need.
+    if (settings.engine == HullEngine::SimdQuickHull && !settings.hullOptions.prefilter &&
+        IsPointSetFile(job.inputs[0].c_str())) {
+        PointSetFile pointSet;
+        if (!pointSet.Open(job.inputs[0].c_str(), &result.error)) {
+            result.ok = false;
+            result.error = job.inputs[0] + ": " + result.error;
+            return;
+        }
+        auto pointAt = [&](size_t i) { return Point2{ pointSet.X()[i], pointSet.Y()[i] }; };
+        if (!checkFinite(job.inputs[0], pointSet.Count(), pointAt, result.error)) {
+            result.ok = false;
+            return;
+        }
+        result.loadSeconds = secondsSince(start);
+        start = chrono::steady_clock::now();
+        vector<size_t> hull;
+        pointSet.CalculateHull(hull);
+        result.computeSeconds = secondsSince(start);
+        result.pointCount = pointSet.Count();
+        for (size_t index : hull) {
+            result.vertices.push_back({ pointSet.X()[index], pointSet.Y()[index] });
+        }
+        result.indices.assign(hull.begin(), hull.end());
+        return;
+    }
+
+    vector<Point2> points;
+    if (!loadPoints(job.inputs[0], settings, points, result.error)) {
+        result.ok = false;
+        return;
+    }
+    result.loadSeconds = secondsSince(start);
+    result.pointCount = points.size();
+
+    start = chrono::steady_clock::now();
+    hullVertices(points, settings, result);
+    result.computeSeconds = secondsSince(start);
+}
+
+void buildSharedHull(const string& path, const Settings& settings, SharedHull& hull)
+{
+    auto start = chrono::steady_clock::now();
+    vector<Point2> points;
+    if (!loadPoints(path, settings, points, hull.error)) {
+        hull.ok = false;
+        return;
+    }
+    hull.loadSeconds = secondsSince(start);
+
+    start = chrono::steady_clock::now();
+    JobResult result;
+    hullVertices(points, settings, result);
+    hull.vertices = move(result.vertices);
+    hull.query.Build(hull.vertices.data(), hull.vertices.size());
+    hull.computeSeconds = secondsSince(start);
+}
+
+void runContains(const Job& job, const Settings& settings, JobResult& result)
+{
+    const SharedHull& hull = *job.hull;
+    if (!hull.ok) {
+        result.ok = false;
+        result.error = hull.error;
+        return;
+    }
+
+    auto start = chrono::steady_clock::now();
+    vector<Point2> queries;
+    if (!loadPoints(job.inputs[1], settings, queries, result.error)) {
+        result.ok = false;
+        return;
+    }
+    result.loadSeconds = secondsSince(start) + (job.firstOnHull ? hull.loadSeconds : 0);
+    result.pointCount = queries.size();
+    result.vertices = hull.vertices;
+
+    start = chrono::steady_clock::now();
+    result.labels.resize(queries.size());
+    hull.query.ClassifyBatch(queries.data(), queries.size(), result.labels.data());
+    result.computeSeconds = secondsSince(start) + (job.firstOnHull ? hull.computeSeconds : 0);
+
+    for (Containment label : result.labels) {
+        result.containmentCounts[size_t(label)]++;
+    }
+}
+
+void runMinkowski(const Job& job, const Settings& settings, JobResult& result)
+{
+    auto start = chrono::steady_clock::now();
+    vector<Point2> a, b;
+    if (!loadPoints(job.inputs[0], settings, a, result.error) ||
+        !loadPoints(job.inputs[1], settings, b, result.error)) {
+        result.ok = false;
+        return;
+    }
+    result.loadSeconds = secondsSince(start);
+    result.pointCount = a.size() + b.size();
+
+    start = chrono::steady_clock::now();
+    JobResult hullA, hullB;
+    hullVertices(a, settings, hullA);
+    hullVertices(b, settings, hullB);
+    if (job.kind == JobKind::Sum) {
+        ConvexMinkowskiSum(hullA.vertices.data(), hullA.vertices.size(), hullB.vertices.data(), hullB.vertices.size(),
+            result.vertices);
+    }
+    else {
+        ConvexMinkowskiDiff(hullA.vertices.data(), hullA.vertices.size(), hullB.vertices.data(), hullB.vertices.size(),
+            result.vertices);
+    }
+    result.computeSeconds = secondsSince(start);
+}
+
+void runImport(const Job& job, const Settings& settings, JobResult& result)
+{
+    auto start = chrono::steady_clock::now();
+    CsvImportStats stats;
+    if (!ImportCsv(job.inputs[0].c_str(), job.inputs[1].c_str(), settings.csvOptions, TaskPool::Default(), &stats)) {
+        result.ok = false;
+        result.error = "cannot convert " + job.inputs[0] + " to " + job.inputs[1];
+        return;
+    }
+    result.computeSeconds = secondsSince(start);
+    result.pointCount = stats.pointCount;
+    result.skippedCount = stats.skippedCount;
+}
+
+void runJob(const Job& job, const Settings& settings, JobResult& result)
+{
+    switch (job.kind) {
+    case JobKind::Hull:
+        runHull(job, settings, result);
+        break;
+    case JobKind::Contains:
+        runContains(job, settings, result);
+        break;
+    case JobKind::Sum:
+    case JobKind::Diff:
+        runMinkowski(job, settings, result);
+        break;
+    case JobKind::Import:
+        runImport(job, settings, result);
+        break;
+    }
+}
+
+void appendJsonString(string& out, const string& text)
+{
+    out += '"';
+    for (char c : text) {
+        if (c == '"' || c == '\\') {
+            out += '\\';
+            out += c;
+        }
+        else if (static_cast<unsigned char>(c) < 0x20) {
+            char escape[8];
+            snprintf(escape, sizeof(escape), "\\u%04x", c);
+            out += escape;
+        }
+        else {
+            out += c;
+        }
+    }
+    out += '"';
+}
+
+template <class... Args>
+void appendFormat(string& out, const char* format, Args... args)
+{
+    char buffer[96];
+    snprintf(buffer, sizeof(buffer), format, args...);
+    out += buffer;
+}
+
+// JSON has no spelling for infinities or NaN. Inputs are finite, but a
+// Minkowski sum near the float limit can still overflow.
+void appendNumber(string& out, float value)
+{
+    if (isfinite(value)) {
+        appendFormat(out, "%.9g", value);
+    }
+    else {
+        out += "null";
+    }
+}
+
+string formatJson(size_t index, const Job& job, const JobResult& result)
+{
+    string out;
+    appendFormat(out, "{\"job\":%zu,\"op\":\"%s\",\"inputs\":[", index, jobKindNames[size_t(job.kind)]);
+    for (size_t i = 0; i < job.inputs.size(); i++) {
+        if (i > 0)
+            out += ',';
+        appendJsonString(out, job.inputs[i]);
+    }
+    appendFormat(out, "],\"ok\":%s", result.ok ? "true" : "false");
+    if (!result.ok) {
+        out += ",\"error\":";
+        appendJsonString(out, result.error);
+    }
+    else {
+        appendFormat(out, ",\"points\":%llu", (unsigned long long)result.pointCount);
+        if (job.kind == JobKind::Contains) {
+            appendFormat(out, ",\"hull_vertices\":%zu,\"inside\":%llu,\"boundary\":%llu,\"outside\":%llu",
+                result.vertices.size(),
+                (unsigned long long)result.containmentCounts[size_t(Containment::Inside)],
+                (unsigned long long)result.containmentCounts[size_t(Containment::Boundary)],
+                (unsigned long long)result.containmentCounts[size_t(Containment::Outside)]);
+        }
+        else if (job.kind == JobKind::Import) {
+            appendFormat(out, ",\"skipped_lines\":%llu", (unsigned long long)result.skippedCount);
+        }
+        else {
+            out += ",\"vertices\":[";
+            for (size_t i = 0; i < result.vertices.size(); i++) {
+                out += i > 0 ? ",[" : "[";
+                appendNumber(out, result.vertices[i].x);
+                out += ',';
+                appendNumber(out, result.vertices[i].y);
+                out += ']';
+            }
+            out += ']';
+            if (job.kind == JobKind::Hull) {
+                out += ",\"indices\":[";
+                for (size_t i = 0; i < result.indices.size(); i++) {
+                    appendFormat(out, i > 0 ? ",%llu" : "%llu", (unsigned long long)result.indices[i]);
+                }
+                out += ']';
+            }
+        }
+    }
+    appendFormat(out, ",\"load_ms\":%.3f,\"compute_ms\":%.3f}\n", result.loadSeconds * 1e3, result.computeSeconds * 1e3);
+    return out;
+}
+
+template <class T>
+void appendBytes(string& out, const T* data, size_t count)
+{
+    out.append(reinterpret_cast<const char*>(data), count * sizeof(T));
+}
+
+string formatBinary(size_t index, const Job& job, const JobResult& result)
+{
+    RecordHeader header = {};
+    header.job = uint32_t(index);
+    header.kind = uint32_t(job.kind);
+    header.ok = result.ok;
+    header.pointCount = result.pointCount;
+    header.loadSeconds = result.loadSeconds;
+    header.computeSeconds = result.computeSeconds;
+    header.vertexCount = result.vertices.size();
+    header.indexCount = result.indices.size();
+    header.labelCount = result.labels.size();
+    header.messageBytes = result.error.size();
+
+    string out;
+    appendBytes(out, &header, 1);
+    appendBytes(out, result.vertices.data(), result.vertices.size());
+    appendBytes(out, result.indices.data(), result.indices.size());
+    appendBytes(out, result.labels.data(), result.labels.size());
+    out += result.error;
+    return out;
+}
+
+bool isJobKind(const string& word, JobKind& kind)
+{
+    for (size_t k = 0; k < sizeof(jobKindNames) / sizeof(jobKindNames[0]); k++) {
+        if (word == jobKindNames[k]) {
+            kind = JobKind(k);
+            return true;
+        }
+    }
+    return false;
+}
+
+// Turns "op file... op file..." into jobs. Hull takes one file per job,
+// contains one job per query file after its HULL, and the others take their
+// files in pairs. Contains jobs on the same HULL file share one SharedHull.
+bool parseJobs(const vector<string>& words, vector<Job>& jobs)
+{
+    map<string, shared_ptr<SharedHull>> hulls;
+    size_t i = 0;
+    while (i < words.size()) {
+        JobKind kind, next;
+        if (!isJobKind(words[i], kind)) {
+            fprintf(stderr, "expected a job, got '%s'\n", words[i].c_str());
+            return false;
+        }
+        size_t first = ++i;
+        while (i < words.size() && !isJobKind(words[i], next)) {
+            i++;
+        }
+        vector<string> files(words.begin() + first, words.begin() + i);
+        if (files.empty() || (kind == JobKind::Contains && files.size() < 2)) {
+            fprintf(stderr, "'%s' is missing its files\n", jobKindNames[size_t(kind)]);
+            return false;
+        }
+
+        if (kind == JobKind::Hull) {
+            for (const string& file : files) {
+                jobs.push_back({ kind, { file } });
+            }
+        }
+        else if (kind == JobKind::Contains) {
+            shared_ptr<SharedHull>& hull = hulls[files[0]];
+            bool first = !hull;
+            if (first) {
+                hull = make_shared<SharedHull>();
+            }
+            for (size_t q = 1; q < files.size(); q++) {
+                jobs.push_back({ kind, { files[0], files[q] }, hull, first && q == 1 });
+            }
+        }
+        else {
+            if (files.size() % 2 != 0) {
+                fprintf(stderr, "'%s' needs its files in pairs\n", jobKindNames[size_t(kind)]);
+                return false;
+            }
+            for (size_t p = 0; p < files.size(); p += 2) {
+                jobs.push_back({ kind, { files[p], files[p + 1] } });
+            }
+        }
+    }
+    return true;
+}
+
+bool readJobFile(const char* path, vector<string>& words)
+{
+    FILE* file = fopen(path, "r");
+    if (!file) {
+        fprintf(stderr, "cannot open job file %s\n", path);
+        return false;
+    }
+    char word[4096];
+    while (fscanf(file, "%4095s", word) == 1) {
+        words.push_back(word);
+    }
+    fclose(file);
+    return true;
+}
+
+bool parseEngine(const char* name, HullEngine& engine)
+{
+    struct Named { HullEngine engine; const char* name; };
+    Named engines[] = {
+        { HullEngine::QuickHull, "quickhull" },
+        { HullEngine::SimdQuickHull, "simd-quickhull" },
+        { HullEngine::ParallelQuickHull, "parallel-quickhull" },
+        { HullEngine::MonotoneChain, "monotone-chain" },
+        { HullEngine::Chan, "chan" },
+    };
+    for (const Named& named : engines) {
+        if (strcmp(name, named.name) == 0) {
+            engine = named.engine;
+            return true;
+        }
+    }
+    return false;
+}
+
+bool parseArguments(int argc, char** argv, Settings& settings, vector<Job>& jobs)
+{
+    vector<string> words;
+    for (int i = 1; i < argc; i++) {
+        string argument = argv[i];
+        bool hasValue = i + 1 < argc;
+        if (argument == "--format" && hasValue) {
+            string format = argv[++i];
+            if (format != "json" && format != "binary") {
+                fprintf(stderr, "unknown format '%s'\n", format.c_str());
+                return false;
+            }
+            settings.binary = format == "binary";
+        }
+        else if (argument == "-o" && hasValue) {
+            settings.outputPath = argv[++i];
+        }
+        else if (argument == "--jobs" && hasValue) {
+            if (!readJobFile(argv[++i], words))
+                return false;
+        }
+        else if (argument == "--threads" && hasValue) {
+            settings.threadCount = unsigned(strtoul(argv[++i], nullptr, 10));
+        }
+        else if (argument == "--engine" && hasValue) {
+            if (!parseEngine(argv[++i], settings.engine)) {
+                fprintf(stderr, "unknown engine '%s'\n", argv[i]);
+                return false;
+            }
+        }
+        else if (argument == "--prefilter") {
+            settings.hullOptions.prefilter = true;
+        }
+        else if (argument == "--x-column" && hasValue) {
+            settings.csvOptions.xColumn = strtoull(argv[++i], nullptr, 10);
+        }
+        else if (argument == "--y-column" && hasValue) {
+            settings.csvOptions.yColumn = strtoull(argv[++i], nullptr, 10);
+        }
+        else if (argument.size() > 1 && argument[0] == '-') {
+            fprintf(stderr, "unknown option '%s'\n", argument.c_str());
+            return false;
+        }
+        else {
+            words.push_back(argument);
+        }
+    }
+    return parseJobs(words, jobs) && !jobs.empty();
+}
+
+// Records are written in job order as soon as every earlier job has finished,
+// so the output never holds more than the jobs still running ahead of it.
+class OrderedWriter {
+public:
+    OrderedWriter(FILE* file, size_t count) : file(file), records(count), done(count) { }
+
+    void Finish(size_t index, string record)
+    {
+        lock_guard<mutex> hold(lock);
+        records[index] = move(record);
+        done[index] = true;
+        while (next < records.size() && done[next]) {
+            fwrite(records[next].data(), 1, records[next].size(), file);
+            string().swap(records[next]);
+            next++;
+        }
+    }
+
+private:
+    FILE* file;
+    mutex lock;
+    vector<string> records;
+    vector<bool> done;
+    size_t next = 0;
+};
+
+}
+
+int main(int argc, char** argv)
+{
+    Settings settings;
+    vector<Job> jobs;
+    if (!parseArguments(argc, argv, settings, jobs)) {
+        fputs(usage, stderr);
+        return 2;
+    }
+
+    FILE* output = stdout;
+    if (!settings.outputPath.empty()) {
+        output = fopen(settings.outputPath.c_str(), settings.binary ? "wb" : "w");
+        if (!output) {
+            fprintf(stderr, "cannot write %s\n", settings.outputPath.c_str());
+            return 2;
+        }
+    }
+    if (settings.binary) {
+        uint32_t versionAndReserved[2] = { resultVersion, 0 };
+        fwrite(resultMagic, 1, sizeof(resultMagic), output);
+        fwrite(versionAndReserved, sizeof(uint32_t), 2, output);
+    }
+
+    // Jobs share the file-level pool; the engines they call fork onto the
+    // default pool, whose waiting threads keep working, so nesting is safe.
+    unique_ptr<TaskPool> ownPool;
+    if (settings.threadCount > 0) {
+        ownPool = make_unique<TaskPool>(settings.threadCount);
+    }
+    TaskPool& pool = ownPool ? *ownPool : TaskPool::Default();
+
+    OrderedWriter writer(output, jobs.size());
+    size_t failed = 0;
+    mutex failedLock;
+    auto start = chrono::steady_clock::now();
+
+    // Each HULL of the contains jobs is loaded and hulled once, up front; the
+    // jobs then only read its query structure.
+    vector<const Job*> hullBuilds;
+    for (const Job& job : jobs) {
+        if (job.firstOnHull) {
+            hullBuilds.push_back(&job);
+        }
+    }
+    pool.ParallelFor(0, hullBuilds.size(), 1, [&](size_t first, size_t last) {
+        for (size_t h = first; h < last; h++) {
+            buildSharedHull(hullBuilds[h]->inputs[0], settings, *hullBuilds[h]->hull);
+        }
+    });
+
+    pool.ParallelFor(0, jobs.size(), 1, [&](size_t first, size_t last) {
+        for (size_t j = first; j < last; j++) {
+            JobResult result;
+            runJob(jobs[j], settings, result);
+            if (!result.ok) {
+                lock_guard<mutex> hold(failedLock);
+                failed++;
+            }
+            writer.Finish(j, settings.binary ? formatBinary(j, jobs[j], result) : formatJson(j, jobs[j], result));
+        }
+    });
+    double seconds = secondsSince(start);
+
+    if (output != stdout) {
+        fclose(output);
+    }
+    fprintf(stderr, "%zu jobs, %zu failed, %.3f s\n", jobs.size(), failed, seconds);
+    return failed > 0 ? 1 : 0;
+}
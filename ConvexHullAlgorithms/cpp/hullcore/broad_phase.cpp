@@ -0,0 +1,147 @@
+#include "broad_phase.h"
+
+#include <algorithm>
+
+#include "task_pool.h"
+
+using namespace std;
+
+namespace hullcore {
+
+namespace {
+
+// Sweep positions per task in the parallel pair search.
+const size_t sweepGrain = 1 << 10;
+
+}
+
+Aabb ComputeAabb(const Point2* points, size_t count)
+{
+    if (count == 0) {
+        return { 0, 0, 0, 0 };
+    }
+
+    Aabb box = { points[0].x, points[0].y, points[0].x, points[0].y };
+    for (size_t i = 1; i < count; i++) {
+        box.minX = min(box.minX, points[i].x);
+        box.minY = min(box.minY, points[i].y);
+        box.maxX = max(box.maxX, points[i].x);
+        box.maxY = max(box.maxY, points[i].y);
+    }
+    return box;
+}
+
+uint32_t SweepAndPrune::AddProxy(const Aabb& box)
+{
+    uint32_t id;
+    if (!freeIds.empty()) {
+        id = freeIds.back();
+        freeIds.pop_back();
+        boxes[id] = box;
+    }
+    else {
+        id = uint32_t(boxes.size());
+        boxes.push_back(box);
+        positions.push_back(deadPosition);
+    }
+
+    // New proxies go to the end; the next re-sort moves them into place.
+    positions[id] = uint32_t(order.size());
+    order.push_back(id);
+    return id;
+}
+
+void SweepAndPrune::RemoveProxy(uint32_t id)
+{
+    if (!IsProxy(id)) {
+        return;
+    }
+    order[positions[id]] = deadPosition;
+    positions[id] = deadPosition;
+    removedSlots++;
+    freeIds.push_back(id);
+}
+
+void SweepAndPrune::UpdateProxy(uint32_t id, const Aabb& box)
+{
+    boxes[id] = box;
+}
+
+void SweepAndPrune::sortOrder()
+{
+    if (removedSlots) {
+        order.erase(remove(order.begin(), order.end(), deadPosition), order.end());
+        removedSlots = 0;
+    }
+
+    lastSortMoves = 0;
+    for (size_t i = 1; i < order.size(); i++) {
+        uint32_t id = order[i];
+        float key = boxes[id].minX;
+        size_t k = i;
+        while (k > 0 && boxes[order[k - 1]].minX > key) {
+            order[k] = order[k - 1];
+            k--;
+        }
+        order[k] = id;
+        lastSortMoves += i - k;
+    }
+
+    sorted.resize(order.size());
+    for (size_t i = 0; i < order.size(); i++) {
+        sorted[i] = boxes[order[i]];
+        positions[order[i]] = uint32_t(i);
+    }
+}
+
+// Pairs every box in [begin, end) of the sweep with the boxes after it that
+// start before it ends on x, keeping those that also overlap on y.
+void SweepAndPrune::sweep(size_t begin, size_t end, vector<ProxyPair>& pairs) const
+{
+    for (size_t i = begin; i < end; i++) {
+        const Aabb& box = sorted[i];
+        for (size_t k = i + 1; k < sorted.size() && sorted[k].minX <= box.maxX; k++) {
+            const Aabb& other = sorted[k];
+            if (other.minY <= box.maxY && box.minY <= other.maxY) {
+                uint32_t a = order[i];
+                uint32_t b = order[k];
+                pairs.push_back(a < b ? ProxyPair{ a, b } : ProxyPair{ b, a });
+            }
+        }
+    }
+}
+
+void SweepAndPrune::FindPairs(vector<ProxyPair>& pairs)
+{
+    sortOrder();
+    pairs.clear();
+    sweep(0, sorted.size(), pairs);
+}
+
+void SweepAndPrune::FindPairs(vector<ProxyPair>& pairs, TaskPool& pool)
+{
+    sortOrder();
+    pairs.clear();
+    if (sorted.size() < 2 * sweepGrain) {
+        sweep(0, sorted.size(), pairs);
+        return;
+    }
+
+    chunkPairs.resize((sorted.size() + sweepGrain - 1) / sweepGrain);
+    pool.ParallelFor(0, sorted.size(), sweepGrain, [&](size_t chunkBegin, size_t chunkEnd) {
+        vector<ProxyPair>& chunk = chunkPairs[chunkBegin / sweepGrain];
+        chunk.clear();
+        sweep(chunkBegin, chunkEnd, chunk);
+    });
+
+    size_t total = 0;
+    for (const vector<ProxyPair>& chunk : chunkPairs) {
+        total += chunk.size();
+    }
+    pairs.reserve(total);
+    for (const vector<ProxyPair>& chunk : chunkPairs) {
+        pairs.insert(pairs.end(), chunk.begin(), chunk.end());
+    }
+}
+
+}
@@ -0,0 +1,81 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+#include "point.h"
+
+namespace hullcore {
+
+class TaskPool;
+
+struct Aabb {
+    float minX;
+    float minY;
+    float maxX;
+    float maxY;
+};
+
+Aabb ComputeAabb(const Point2* points, size_t count);
+
+inline bool Overlaps(const Aabb& a, const Aabb& b)
+{
+    return a.minX <= b.maxX && b.minX <= a.maxX && a.minY <= b.maxY && b.minY <= a.maxY;
+}
+
+// Candidate pair for the narrow phase, first < second.
+struct ProxyPair {
+    uint32_t first;
+    uint32_t second;
+};
+
+// Sweep-and-prune over the x extents of proxy boxes. The sorted order is kept
+// between calls and repaired with an insertion sort, so when boxes move a
+// little per frame re-sorting costs close to O(n) instead of O(n log n).
+class SweepAndPrune {
+public:
+    // Returns the id of the new proxy; ids of removed proxies are reused.
+    uint32_t AddProxy(const Aabb& box);
+    // Removing an id that is not a live proxy does nothing.
+    void RemoveProxy(uint32_t id);
+    void UpdateProxy(uint32_t id, const Aabb& box);
+
+    const Aabb& ProxyBox(uint32_t id) const { return boxes[id]; }
+    size_t ProxyCount() const { return order.size() - removedSlots; }
+    bool IsProxy(uint32_t id) const { return id < positions.size() && positions[id] != deadPosition; }
+
+    // Replaces pairs with every pair of live proxies whose boxes overlap, in
+    // sweep order. The pool overload splits the sweep into chunks of the
+    // sorted order and gives the same pairs in the same order.
+    void FindPairs(std::vector<ProxyPair>& pairs);
+    void FindPairs(std::vector<ProxyPair>& pairs, TaskPool& pool);
+
+    // Element moves done by the last re-sort, a measure of frame coherence.
+    size_t LastSortMoves() const { return lastSortMoves; }
+
+private:
+    static constexpr uint32_t deadPosition = UINT32_MAX;
+
+    void sortOrder();
+    void sweep(size_t begin, size_t end, std::vector<ProxyPair>& pairs) const;
+
+    std::vector<Aabb> boxes;
+    std::vector<uint32_t> freeIds;
+    std::vector<uint32_t> order;
+
+    // Slot of each proxy in order, or deadPosition once it is removed. A
+    // removal only marks its slot, and the next re-sort drops marked slots,
+    // so removing is O(1).
+    std::vector<uint32_t> positions;
+    size_t removedSlots = 0;
+
+    // Boxes copied into sweep order so the inner loop reads contiguous memory.
+    std::vector<Aabb> sorted;
+
+    // Per-chunk output of the parallel sweep, kept so frames reuse the storage.
+    std::vector<std::vector<ProxyPair>> chunkPairs;
+    size_t lastSortMoves = 0;
+};
+
+}
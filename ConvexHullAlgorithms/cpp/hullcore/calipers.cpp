@@ -0,0 +1,207 @@
+#include "calipers.h"
+
+#include <algorithm>
+#include <cmath>
+
+#include "predicates.h"
+
+using namespace std;
+
+namespace hullcore {
+
+namespace {
+
+struct Vec {
+    double x;
+    double y;
+};
+
+Vec operator-(Vec a, Vec b) { return { a.x - b.x, a.y - b.y }; }
+Vec operator+(Vec a, Vec b) { return { a.x + b.x, a.y + b.y }; }
+Vec operator*(double s, Vec a) { return { s * a.x, s * a.y }; }
+double dot(Vec a, Vec b) { return a.x * b.x + a.y * b.y; }
+double cross(Vec a, Vec b) { return a.x * b.y - a.y * b.x; }
+
+Vec toVec(const Point2& p) { return { p.x, p.y }; }
+Point2 toPoint(Vec v) { return { float(v.x), float(v.y) }; }
+
+// The sweep's vertex counters run past count, so every lookup wraps.
+struct Polygon {
+    const Point2* points;
+    size_t count;
+
+    const Point2& operator[](size_t i) const { return points[i % count]; }
+    Vec at(size_t i) const { return toVec((*this)[i]); }
+    Vec edge(size_t i) const { return at(i + 1) - at(i); }
+
+    // True while edge k still turns left of edge i, that is while vertex
+    // k + 1 is farther from the line through edge i than vertex k. Exact, so
+    // a parallel opposite edge is recognised as such.
+    bool ahead(size_t i, size_t k) const
+    {
+        return CrossEdges((*this)[i], (*this)[i + 1], (*this)[k], (*this)[k + 1]) > 0;
+    }
+
+    bool parallel(size_t i, size_t k) const
+    {
+        return CrossEdges((*this)[i], (*this)[i + 1], (*this)[k], (*this)[k + 1]) == 0;
+    }
+};
+
+void setRect(CaliperRect& rect, Vec origin, Vec axis, double lower, double upper, double breadth, size_t edge)
+{
+    Vec normal = { -axis.y, axis.x };
+    rect.corners[0] = toPoint(origin + lower * axis);
+    rect.corners[1] = toPoint(origin + upper * axis);
+    rect.corners[2] = toPoint(origin + upper * axis + breadth * normal);
+    rect.corners[3] = toPoint(origin + lower * axis + breadth * normal);
+    rect.axisX = axis.x;
+    rect.axisY = axis.y;
+    rect.length = upper - lower;
+    rect.breadth = breadth;
+    rect.area = rect.length * breadth;
+    rect.perimeter = 2 * (rect.length + breadth);
+    rect.edge = edge;
+}
+
+// A point or a segment has no edge to put a caliper against; the segment's
+// rectangle is the segment itself.
+void measureDegenerate(const Point2* hull, size_t count, unsigned queries, CaliperResult& result)
+{
+    Vec a = toVec(hull[0]);
+    Vec b = toVec(hull[count - 1]);
+    double length = sqrt(dot(b - a, b - a));
+    Vec axis = length > 0 ? (1 / length) * (b - a) : Vec { 1, 0 };
+
+    if (queries & CALIPER_DIAMETER) {
+        result.diameter = length;
+        result.diameterB = count - 1;
+    }
+    if (queries & CALIPER_WIDTH) {
+        result.widthVertex = count - 1;
+    }
+    if (queries & CALIPER_MIN_AREA_RECT) {
+        setRect(result.minAreaRect, a, axis, 0, length, 0, 0);
+    }
+    if (queries & CALIPER_MIN_PERIMETER_RECT) {
+        setRect(result.minPerimeterRect, a, axis, 0, length, 0, 0);
+    }
+    if ((queries & CALIPER_ANTIPODAL_PAIRS) && count == 2) {
+        result.antipodalPairs.push_back({ 0, 1 });
+    }
+}
+
+}
+
+void RotatingCalipers(const Point2* hull, size_t count, unsigned queries, CaliperResult& result)
+{
+    vector<pair<size_t, size_t>> pairs = std::move(result.antipodalPairs);
+    pairs.clear();
+    result = CaliperResult();
+    result.antipodalPairs = std::move(pairs);
+
+    if (count == 0) {
+        return;
+    }
+    if (count < 3) {
+        measureDegenerate(hull, count, queries, result);
+        return;
+    }
+
+    Polygon polygon = { hull, count };
+    bool wantPairs = (queries & (CALIPER_DIAMETER | CALIPER_ANTIPODAL_PAIRS)) != 0;
+    bool wantRects = (queries & (CALIPER_MIN_AREA_RECT | CALIPER_MIN_PERIMETER_RECT)) != 0;
+
+    // Farthest vertex from the closing edge, where the sweep picks up.
+    size_t top = 0;
+    while (polygon.ahead(count - 1, top)) {
+        top++;
+    }
+    size_t right = 1;
+    size_t left = 0;
+
+    double farthestSquared = -1;
+    double minWidth = HUGE_VAL;
+    double minArea = HUGE_VAL;
+    double minPerimeter = HUGE_VAL;
+
+    for (size_t i = 0; i < count; i++) {
+        size_t firstTop = top;
+        while (polygon.ahead(i, top)) {
+            top++;
+        }
+
+        // Vertex i sees, across the hull, every vertex from the one farthest
+        // from edge i - 1 to the one farthest from edge i; both ends of an
+        // opposite edge parallel to edge i count.
+        if (wantPairs) {
+            size_t lastTop = polygon.parallel(i, top) ? top + 1 : top;
+            Vec p = polygon.at(i);
+            for (size_t w = firstTop; w <= lastTop; w++) {
+                size_t j = w % count;
+                if (j <= i) {
+                    continue;
+                }
+                if (queries & CALIPER_ANTIPODAL_PAIRS) {
+                    result.antipodalPairs.push_back({ i, j });
+                }
+                Vec d = polygon.at(j) - p;
+                double squared = dot(d, d);
+                if (squared > farthestSquared) {
+                    farthestSquared = squared;
+                    result.diameterA = i;
+                    result.diameterB = j;
+                }
+            }
+        }
+
+        Vec origin = polygon.at(i);
+        Vec edge = polygon.edge(i);
+        double edgeLength = sqrt(dot(edge, edge));
+        Vec axis = (1 / edgeLength) * edge;
+        double breadth = cross(axis, polygon.at(top) - origin);
+        if (breadth < minWidth) {
+            minWidth = breadth;
+            result.widthEdge = i;
+            result.widthVertex = top % count;
+        }
+
+        if (wantRects) {
+            right = max(right, i + 1);
+            while (dot(polygon.edge(right), edge) > 0) {
+                right++;
+            }
+            left = max(left, top);
+            while (dot(polygon.edge(left), edge) < 0) {
+                left++;
+            }
+            double lower = dot(polygon.at(left) - origin, axis);
+            double upper = dot(polygon.at(right) - origin, axis);
+            double area = (upper - lower) * breadth;
+            double perimeter = 2 * (upper - lower + breadth);
+            if ((queries & CALIPER_MIN_AREA_RECT) && area < minArea) {
+                minArea = area;
+                setRect(result.minAreaRect, origin, axis, lower, upper, breadth, i);
+            }
+            if ((queries & CALIPER_MIN_PERIMETER_RECT) && perimeter < minPerimeter) {
+                minPerimeter = perimeter;
+                setRect(result.minPerimeterRect, origin, axis, lower, upper, breadth, i);
+            }
+        }
+    }
+
+    if (queries & CALIPER_DIAMETER) {
+        result.diameter = sqrt(farthestSquared);
+    }
+    else {
+        result.diameterA = result.diameterB = 0;
+    }
+    if (queries & CALIPER_WIDTH) {
+        result.width = minWidth;
+    }
+    else {
+        result.widthEdge = result.widthVertex = 0;
+    }
+}
+
+}
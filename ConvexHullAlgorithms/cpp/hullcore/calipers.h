@@ -0,0 +1,76 @@
+#pragma once
+
+#include <cstddef>
+#include <utility>
+#include <vector>
+
+#include "point.h"
+
+namespace hullcore {
+
+// Measurements RotatingCalipers can take; combine with |.
+enum CaliperQuery : unsigned {
+    CALIPER_DIAMETER = 1,
+    CALIPER_WIDTH = 2,
+    CALIPER_MIN_AREA_RECT = 4,
+    CALIPER_MIN_PERIMETER_RECT = 8,
+    CALIPER_ANTIPODAL_PAIRS = 16,
+    CALIPER_ALL = 31,
+};
+
+// Rectangle with one side flush with hull edge (edge, edge + 1), corners
+// counter-clockwise starting from the one at the lower end of that side.
+struct CaliperRect {
+    Point2 corners[4] = {};
+    // Unit direction of the flush side.
+    double axisX = 1;
+    double axisY = 0;
+    double length = 0;
+    double breadth = 0;
+    double area = 0;
+    double perimeter = 0;
+    size_t edge = 0;
+};
+
+struct CaliperResult {
+    // Farthest pair of vertices.
+    double diameter = 0;
+    size_t diameterA = 0;
+    size_t diameterB = 0;
+
+    // Smallest distance between two parallel lines enclosing the hull, taken
+    // between edge (widthEdge, widthEdge + 1) and vertex widthVertex.
+    double width = 0;
+    size_t widthEdge = 0;
+    size_t widthVertex = 0;
+
+    CaliperRect minAreaRect;
+    CaliperRect minPerimeterRect;
+
+    // Every pair of vertices admitting parallel supporting lines, each pair
+    // once with the smaller index first.
+    std::vector<std::pair<size_t, size_t>> antipodalPairs;
+};
+
+// Rotating calipers over a polygon given counter-clockwise without collinear
+// vertices, as produced by CalculateHull. All requested queries come out of
+// one O(h) sweep: the vertex farthest from each edge and, when a rectangle
+// is asked for, the extreme vertices along it each only ever move forward.
+// Fields not asked for keep their defaults.
+void RotatingCalipers(const Point2* hull, size_t count, unsigned queries, CaliperResult& result);
+
+inline double HullDiameter(const Point2* hull, size_t count)
+{
+    CaliperResult result;
+    RotatingCalipers(hull, count, CALIPER_DIAMETER, result);
+    return result.diameter;
+}
+
+inline double HullWidth(const Point2* hull, size_t count)
+{
+    CaliperResult result;
+    RotatingCalipers(hull, count, CALIPER_WIDTH, result);
+    return result.width;
+}
+
+}
@@ -0,0 +1,379 @@
+#include "chan.h"
+
+#include <algorithm>
+#include <cassert>
+#include <cmath>
+#include <iterator>
+
+#include "quickhull.h"
+#include "task_pool.h"
+
+using namespace std;
+
+namespace hullcore {
+
+namespace {
+
+// Group hulls built per task, and group tangents searched per task once a
+// Jarvis step has this many groups to look at.
+const size_t hullGrain = 1 << 16;
+const size_t tangentGrain = 1 << 12;
+
+// Rounds guess 16, 256, 65536 and 2^32 points per group, and the last one
+// takes all points as one group.
+const unsigned lastRound = 6;
+
+struct IndexedPoint {
+    Point2 point;
+    size_t index;
+};
+
+// The hulls of all groups of one round, group g occupying
+// [g * groupSize, g * groupSize + sizes[g]) of vertices and indices.
+struct GroupHulls {
+    size_t groupSize;
+    size_t groupCount;
+    vector<Point2> vertices;
+    vector<size_t> indices;
+    vector<size_t> sizes;
+
+    // Groups that may still hold hull vertices; the march only visits these.
+    vector<size_t> active;
+};
+
+struct Vertex {
+    size_t group;
+    size_t position;
+};
+
+bool lexicographicLess(const Point2& a, const Point2& b)
+{
+    return a.x < b.x || (a.x == b.x && a.y < b.y);
+}
+
+// Whether a is a better next hull vertex after p than b: further clockwise as
+// seen from p, or in the same direction and beyond b. Copies of p lose to
+// everything. Both tests are exact, so while the other points lie within a
+// half-plane at p, as they do around a hull vertex, this is a strict order
+// and the tangent climbs cannot cycle.
+bool isBetter(const Point2& p, const Point2& a, const Point2& b)
+{
+    if (a == p)
+        return false;
+    if (b == p)
+        return true;
+    double side = signedLineDist(p, b, a);
+    if (side != 0)
+        return side < 0;
+    return DotEdges(p, b, b, a) > 0;
+}
+
+// Monotone chain over the count gathered points in sorted, written
+// counter-clockwise from the lowest leftmost one; chain is scratch of
+// 2 * count elements.
+size_t buildGroupHull(IndexedPoint* sorted, size_t count, size_t* chain, Point2* vertices, size_t* indices)
+{
+    std::sort(sorted, sorted + count, [](const IndexedPoint& a, const IndexedPoint& b) {
+        return lexicographicLess(a.point, b.point);
+    });
+
+    if (sorted[0].point == sorted[count - 1].point) {
+        vertices[0] = sorted[0].point;
+        indices[0] = sorted[0].index;
+        return 1;
+    }
+
+    size_t k = 0;
+    for (size_t i = 0; i < count; i++) {
+        while (k >= 2 && signedLineDist(sorted[chain[k - 2]].point, sorted[chain[k - 1]].point, sorted[i].point) <= 0)
+            k--;
+        chain[k++] = i;
+    }
+    size_t lowerSize = k + 1;
+    for (size_t i = count - 1; i > 0; i--) {
+        while (k >= lowerSize && signedLineDist(sorted[chain[k - 2]].point, sorted[chain[k - 1]].point, sorted[i - 1].point) <= 0)
+            k--;
+        chain[k++] = i - 1;
+    }
+
+    for (size_t i = 0; i + 1 < k; i++) {
+        vertices[i] = sorted[chain[i]].point;
+        indices[i] = sorted[chain[i]].index;
+    }
+    return k - 1;
+}
+
+// Builds the hulls of groups of hulls.groupSize points. Group sizes of
+// successive rounds divide each other, so after the first round a group is
+// the hull of the previous round's hulls it covers, which are stored inside
+// its own slot; only their vertices are sorted again, not the raw points.
+void buildGroupHulls(const Point2* points, size_t count, size_t previousSize, GroupHulls& hulls, TaskPool& pool)
+{
+    size_t groupSize = hulls.groupSize;
+    size_t previousCount = hulls.groupCount;
+    hulls.groupCount = (count + groupSize - 1) / groupSize;
+    vector<size_t> sizes(hulls.groupCount);
+
+    // Whole groups per task so every task can keep one scratch buffer.
+    size_t groupsPerTask = max<size_t>(1, hullGrain / groupSize);
+    pool.ParallelFor(0, hulls.groupCount, groupsPerTask, [&](size_t firstGroup, size_t lastGroup) {
+        vector<IndexedPoint> sorted(groupSize);
+        vector<size_t> chain(2 * groupSize);
+        for (size_t g = firstGroup; g < lastGroup; g++) {
+            size_t begin = g * groupSize;
+            size_t gathered = 0;
+            if (previousSize == 0) {
+                for (size_t i = begin; i < min(begin + groupSize, count); i++) {
+                    sorted[gathered++] = { points[i], i };
+                }
+            }
+            else {
+                size_t firstPrevious = begin / previousSize;
+                size_t lastPrevious = min((min(begin + groupSize, count) + previousSize - 1) / previousSize, previousCount);
+                for (size_t previous = firstPrevious; previous < lastPrevious; previous++) {
+                    size_t slot = previous * previousSize;
+                    for (size_t v = slot; v < slot + hulls.sizes[previous]; v++) {
+                        sorted[gathered++] = { hulls.vertices[v], hulls.indices[v] };
+                    }
+                }
+            }
+            sizes[g] = buildGroupHull(sorted.data(), gathered, chain.data(),
+                hulls.vertices.data() + begin, hulls.indices.data() + begin);
+        }
+    });
+    hulls.sizes.swap(sizes);
+}
+
+// Directions whose extreme points, taken in this counter-clockwise order,
+// span a convex polygon inside the hull.
+const double extremeDirections[8][2] = {
+    { 0, -1 }, { 1, -1 }, { 1, 0 }, { 1, 1 }, { 0, 1 }, { -1, 1 }, { -1, 0 }, { -1, -1 },
+};
+
+struct Extremes {
+    Point2 points[8];
+    double values[8];
+};
+
+void addToExtremes(Extremes& extremes, const Point2& point)
+{
+    for (int d = 0; d < 8; d++) {
+        double value = extremeDirections[d][0] * point.x + extremeDirections[d][1] * point.y;
+        if (value > extremes.values[d]) {
+            extremes.values[d] = value;
+            extremes.points[d] = point;
+        }
+    }
+}
+
+// Group hulls strictly inside the polygon of the extreme points can neither
+// hold a hull vertex nor change a tangent, so they are left out of the march.
+// On inputs with few hull vertices this drops nearly every group.
+void cullGroups(GroupHulls& hulls, TaskPool& pool)
+{
+    size_t groupsPerTask = max<size_t>(1, hullGrain / hulls.groupSize);
+    size_t chunkCount = (hulls.groupCount + groupsPerTask - 1) / groupsPerTask;
+    vector<Extremes> chunks(chunkCount);
+    pool.ParallelFor(0, hulls.groupCount, groupsPerTask, [&](size_t firstGroup, size_t lastGroup) {
+        Extremes& extremes = chunks[firstGroup / groupsPerTask];
+        fill(begin(extremes.values), end(extremes.values), -INFINITY);
+        for (size_t g = firstGroup; g < lastGroup; g++) {
+            for (size_t v = g * hulls.groupSize; v < g * hulls.groupSize + hulls.sizes[g]; v++) {
+                addToExtremes(extremes, hulls.vertices[v]);
+            }
+        }
+    });
+
+    Extremes extremes = chunks[0];
+    for (const Extremes& chunk : chunks) {
+        for (int d = 0; d < 8; d++) {
+            addToExtremes(extremes, chunk.points[d]);
+        }
+    }
+
+    Point2 polygon[8];
+    size_t polygonSize = 0;
+    for (const Point2& point : extremes.points) {
+        if (polygonSize == 0 || (point != polygon[polygonSize - 1] && point != polygon[0]))
+            polygon[polygonSize++] = point;
+    }
+
+    vector<char> keep(hulls.groupCount, 1);
+    if (polygonSize >= 3) {
+        pool.ParallelFor(0, hulls.groupCount, groupsPerTask, [&](size_t firstGroup, size_t lastGroup) {
+            for (size_t g = firstGroup; g < lastGroup; g++) {
+                bool inside = true;
+                for (size_t v = g * hulls.groupSize; inside && v < g * hulls.groupSize + hulls.sizes[g]; v++) {
+                    for (size_t e = 0; inside && e < polygonSize; e++) {
+                        const Point2& to = polygon[e + 1 == polygonSize ? 0 : e + 1];
+                        inside = signedLineDist(polygon[e], to, hulls.vertices[v]) > 0;
+                    }
+                }
+                keep[g] = !inside;
+            }
+        });
+    }
+
+    hulls.active.clear();
+    for (size_t g = 0; g < hulls.groupCount; g++) {
+        if (keep[g])
+            hulls.active.push_back(g);
+    }
+}
+
+// Best vertex of one group hull after p. Along a convex polygon seen from an
+// outside point the isBetter order rises to the tangent and falls back once,
+// so the tangent is found by binary search against vertex 0; a short climb
+// afterwards settles ties along edges through p. Each climb is bounded by
+// the hull size in case p is not where a hull vertex should be.
+size_t findTangent(const Point2* hull, size_t size, const Point2& p)
+{
+    if (size == 1) {
+        return 0;
+    }
+
+    auto next = [&](size_t i) { return i + 1 == size ? 0 : i + 1; };
+    auto prev = [&](size_t i) { return i == 0 ? size - 1 : i - 1; };
+    auto rising = [&](size_t i) { return isBetter(p, hull[next(i)], hull[i]); };
+
+    // Rising at 0: the answer is the first falling vertex that still beats
+    // vertex 0. Falling at 0: the first falling vertex that beats vertex 0,
+    // or vertex 0 itself if none does.
+    bool risingAtStart = rising(0);
+    size_t low = 1;
+    size_t high = size;
+    while (low < high) {
+        size_t mid = low + (high - low) / 2;
+        bool beatsStart = isBetter(p, hull[mid], hull[0]);
+        bool found = risingAtStart ? (!rising(mid) || !beatsStart) : (!rising(mid) && beatsStart);
+        if (found)
+            high = mid;
+        else
+            low = mid + 1;
+    }
+
+    size_t tangent = low == size ? 0 : low;
+    for (size_t step = 0; step < size && isBetter(p, hull[next(tangent)], hull[tangent]); step++)
+        tangent = next(tangent);
+    for (size_t step = 0; step < size && isBetter(p, hull[prev(tangent)], hull[tangent]); step++)
+        tangent = prev(tangent);
+    return tangent;
+}
+
+// Best candidate after current among the active groups [first, last). The
+// group current belongs to simply offers its next vertex.
+bool bestCandidate(const GroupHulls& hulls, const Vertex& current, size_t first, size_t last, Vertex& best)
+{
+    const Point2& p = hulls.vertices[current.group * hulls.groupSize + current.position];
+    bool found = false;
+    for (size_t a = first; a < last; a++) {
+        size_t g = hulls.active[a];
+        const Point2* hull = hulls.vertices.data() + g * hulls.groupSize;
+        size_t size = hulls.sizes[g];
+        Vertex candidate{ g, 0 };
+        if (g == current.group)
+            candidate.position = current.position + 1 == size ? 0 : current.position + 1;
+        else
+            candidate.position = findTangent(hull, size, p);
+
+        const Point2& point = hull[candidate.position];
+        if (point == p)
+            continue;
+        if (!found || isBetter(p, point, hulls.vertices[best.group * hulls.groupSize + best.position])) {
+            best = candidate;
+            found = true;
+        }
+    }
+    return found;
+}
+
+bool nextVertex(const GroupHulls& hulls, const Vertex& current, TaskPool& pool, Vertex& next)
+{
+    size_t activeCount = hulls.active.size();
+    if (activeCount < 2 * tangentGrain) {
+        return bestCandidate(hulls, current, 0, activeCount, next);
+    }
+
+    struct Chunk {
+        Vertex best;
+        bool found;
+    };
+    vector<Chunk> chunks((activeCount + tangentGrain - 1) / tangentGrain);
+    pool.ParallelFor(0, activeCount, tangentGrain, [&](size_t first, size_t last) {
+        Chunk& chunk = chunks[first / tangentGrain];
+        chunk.found = bestCandidate(hulls, current, first, last, chunk.best);
+    });
+
+    const Point2& p = hulls.vertices[current.group * hulls.groupSize + current.position];
+    bool found = false;
+    for (const Chunk& chunk : chunks) {
+        if (!chunk.found)
+            continue;
+        const Point2& point = hulls.vertices[chunk.best.group * hulls.groupSize + chunk.best.position];
+        if (!found || isBetter(p, point, hulls.vertices[next.group * hulls.groupSize + next.position])) {
+            next = chunk.best;
+            found = true;
+        }
+    }
+    return found;
+}
+
+// Runs at most maxSteps Jarvis steps; false if the hull did not close.
+bool marchHull(const GroupHulls& hulls, size_t maxSteps, TaskPool& pool, vector<size_t>& hullIndices)
+{
+    hullIndices.clear();
+
+    Vertex start{ hulls.active[0], 0 };
+    for (size_t g : hulls.active) {
+        if (lexicographicLess(hulls.vertices[g * hulls.groupSize], hulls.vertices[start.group * hulls.groupSize]))
+            start = { g, 0 };
+    }
+    const Point2& startPoint = hulls.vertices[start.group * hulls.groupSize];
+
+    Vertex current = start;
+    for (size_t step = 0; step < maxSteps; step++) {
+        hullIndices.push_back(hulls.indices[current.group * hulls.groupSize + current.position]);
+
+        Vertex next{ 0, 0 };
+        if (!nextVertex(hulls, current, pool, next))
+            return true;
+        if (hulls.vertices[next.group * hulls.groupSize + next.position] == startPoint)
+            return true;
+        current = next;
+    }
+    return false;
+}
+
+}
+
+void CalculateChanHull(const Point2* points, size_t count, vector<size_t>& hullIndices, TaskPool& pool)
+{
+    hullIndices.clear();
+    if (count == 0) {
+        return;
+    }
+
+    GroupHulls hulls;
+    hulls.vertices.resize(count);
+    hulls.indices.resize(count);
+
+    // Guesses 16, 256, 65536, ... capped at count; the last round is a
+    // single group whose own hull closes the march.
+    size_t previousSize = 0;
+    hulls.groupCount = 0;
+    for (unsigned round = 2; round <= lastRound; round++) {
+        size_t guess = round < lastRound ? size_t(1) << (size_t(1) << round) : count;
+        hulls.groupSize = min(guess, count);
+        buildGroupHulls(points, count, previousSize, hulls, pool);
+        cullGroups(hulls, pool);
+        previousSize = hulls.groupSize;
+        bool closed = marchHull(hulls, hulls.groupSize, pool, hullIndices);
+        // One group spanning every point is walked along its own hull, which
+        // with exact tangents always closes.
+        assert(closed || hulls.groupSize < count);
+        if (closed || hulls.groupSize == count)
+            return;
+    }
+}
+
+}
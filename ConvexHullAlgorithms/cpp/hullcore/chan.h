@@ -0,0 +1,19 @@
+#pragma once
+
+#include <cstddef>
+#include <vector>
+
+#include "point.h"
+
+namespace hullcore {
+
+class TaskPool;
+
+// Chan's output-sensitive algorithm, O(n log h). Each round guesses a hull
+// size m, builds monotone-chain hulls of groups of m points in parallel and
+// runs at most m Jarvis steps that find the tangent of every group hull by
+// binary search; the guess is squared until the march closes. Same output
+// order as CalculateQuickHull.
+void CalculateChanHull(const Point2* points, size_t count, std::vector<size_t>& hullIndices, TaskPool& pool);
+
+}
@@ -0,0 +1,153 @@
+#include "containment.h"
+
+#include <algorithm>
+
+#include "predicates.h"
+#include "quickhull.h"
+#include "quickhull3.h"
+#include "simd_kernels.h"
+
+using namespace std;
+
+namespace hullcore {
+
+static_assert(uint8_t(Containment::Outside) == POLYGON_OUTSIDE &&
+    uint8_t(Containment::Boundary) == POLYGON_BOUNDARY &&
+    uint8_t(Containment::Inside) == POLYGON_INSIDE, "polygon kernel labels must match Containment");
+
+namespace {
+
+// Above this many vertices the per-point binary search beats testing all edges.
+const size_t edgeKernelLimit = 48;
+
+// Multiple of 64 so every chunk of ContainsBatch owns whole mask words.
+const size_t batchGrain = 1 << 14;
+
+void classifyRange(const ConvexHullQuery& query, const Point2* points, size_t count, Containment* labels)
+{
+    const vector<Point2>& vertices = query.vertices;
+    if (vertices.size() >= 3 && vertices.size() <= edgeKernelLimit) {
+        ClassifyPolygon(vertices.data(), vertices.size(), points, count, reinterpret_cast<uint8_t*>(labels));
+        return;
+    }
+    for (size_t i = 0; i < count; i++) {
+        labels[i] = query.Classify(points[i]);
+    }
+}
+
+}
+
+void ConvexHullQuery::Build(const Point2* hull, size_t count)
+{
+    vertices.assign(hull, hull + count);
+}
+
+Containment ConvexHullQuery::Classify(Point2 point) const
+{
+    size_t count = vertices.size();
+    if (count == 0) {
+        return Containment::Outside;
+    }
+    const Point2& origin = vertices[0];
+    if (count == 1) {
+        return point == origin ? Containment::Boundary : Containment::Outside;
+    }
+    if (count == 2) {
+        const Point2& end = vertices[1];
+        if (findSide(origin, end, point) != 0)
+            return Containment::Outside;
+        // On the line, the point lies between the ends exactly when they are
+        // not on the same side of it; products of tiny float offsets would
+        // underflow, so the sign comes from the exact predicate.
+        return DotEdges(point, origin, point, end) <= 0 ? Containment::Boundary : Containment::Outside;
+    }
+
+    int firstSide = findSide(origin, vertices[1], point);
+    int lastSide = findSide(origin, vertices[count - 1], point);
+    if (firstSide < 0 || lastSide > 0) {
+        return Containment::Outside;
+    }
+
+    // Largest wedge start whose ray from origin still has the point on its left.
+    size_t low = 1;
+    size_t high = count - 2;
+    while (low < high) {
+        size_t mid = (low + high + 1) / 2;
+        if (findSide(origin, vertices[mid], point) >= 0)
+            low = mid;
+        else
+            high = mid - 1;
+    }
+
+    int edgeSide = findSide(vertices[low], vertices[low + 1], point);
+    if (edgeSide < 0) {
+        return Containment::Outside;
+    }
+    if (edgeSide == 0) {
+        return Containment::Boundary;
+    }
+    if ((low == 1 && firstSide == 0) || (low == count - 2 && lastSide == 0)) {
+        return Containment::Boundary;
+    }
+    return Containment::Inside;
+}
+
+void ConvexHullQuery::ClassifyBatch(const Point2* points, size_t count, Containment* labels, TaskPool& pool) const
+{
+    pool.ParallelFor(0, count, batchGrain, [&](size_t begin, size_t end) {
+        classifyRange(*this, points + begin, end - begin, labels + begin);
+    });
+}
+
+void ConvexHull3Query::Build(const HalfEdgeMesh& hull)
+{
+    faceVertices.clear();
+    for (uint32_t edge : hull.faces) {
+        for (uint32_t k = 0; k < 3; k++) {
+            faceVertices.push_back(hull.vertices[hull.edges[edge].vertex]);
+            edge = hull.edges[edge].next;
+        }
+    }
+}
+
+Containment ConvexHull3Query::Classify(Point3 point) const
+{
+    if (faceVertices.empty()) {
+        return Containment::Outside;
+    }
+    bool onPlane = false;
+    for (size_t f = 0; f < faceVertices.size(); f += 3) {
+        double side = Orient3d(faceVertices[f], faceVertices[f + 1], faceVertices[f + 2], point);
+        if (side > 0)
+            return Containment::Outside;
+        onPlane = onPlane || side == 0;
+    }
+    return onPlane ? Containment::Boundary : Containment::Inside;
+}
+
+void ConvexHull3Query::ClassifyBatch(const Point3* points, size_t count, Containment* labels, TaskPool& pool) const
+{
+    pool.ParallelFor(0, count, batchGrain, [&](size_t begin, size_t end) {
+        for (size_t i = begin; i < end; i++) {
+            labels[i] = Classify(points[i]);
+        }
+    });
+}
+
+void ConvexHullQuery::ContainsBatch(const Point2* points, size_t count, uint64_t* mask, TaskPool& pool) const
+{
+    pool.ParallelFor(0, count, batchGrain, [&](size_t begin, size_t end) {
+        Containment labels[batchGrain];
+        classifyRange(*this, points + begin, end - begin, labels);
+        for (size_t word = begin; word < end; word += 64) {
+            uint64_t bits = 0;
+            size_t wordEnd = min(end, word + 64);
+            for (size_t i = word; i < wordEnd; i++) {
+                bits |= uint64_t(labels[i - begin] != Containment::Outside) << (i - word);
+            }
+            mask[word / 64] = bits;
+        }
+    });
+}
+
+}
@@ -0,0 +1,59 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+#include "point.h"
+#include "task_pool.h"
+
+namespace hullcore {
+
+struct HalfEdgeMesh;
+
+enum class Containment : uint8_t { Outside, Boundary, Inside };
+
+// Point location against a convex polygon given counter-clockwise without
+// collinear vertices, as produced by CalculateHull. Build copies the vertices
+// once; every Classify is a binary search over the fan of triangles around
+// vertices[0], so O(log h) per query.
+struct ConvexHullQuery {
+
+    std::vector<Point2> vertices;
+
+    void Build(const Point2* hull, size_t count);
+
+    Containment Classify(Point2 point) const;
+
+    bool Contains(Point2 point) const { return Classify(point) != Containment::Outside; }
+
+    // Writes Classify(points[i]) to labels[i] for the whole batch, split into
+    // chunks across the pool. Small hulls test blocks of points against every
+    // edge with the vector kernels; larger ones binary search per point.
+    void ClassifyBatch(const Point2* points, size_t count, Containment* labels,
+        TaskPool& pool = TaskPool::Default()) const;
+
+    // Sets bit i % 64 of mask[i / 64] when points[i] is inside or on the
+    // boundary and clears it otherwise; mask needs (count + 63) / 64 words.
+    void ContainsBatch(const Point2* points, size_t count, uint64_t* mask,
+        TaskPool& pool = TaskPool::Default()) const;
+};
+
+// Point location against a 3D hull from CalculateQuickHull3, one exact side
+// test per face, so O(faces) per query.
+struct ConvexHull3Query {
+
+    // Three per face, counter-clockwise seen from outside.
+    std::vector<Point3> faceVertices;
+
+    void Build(const HalfEdgeMesh& hull);
+
+    Containment Classify(Point3 point) const;
+
+    bool Contains(Point3 point) const { return Classify(point) != Containment::Outside; }
+
+    void ClassifyBatch(const Point3* points, size_t count, Containment* labels,
+        TaskPool& pool = TaskPool::Default()) const;
+};
+
+}
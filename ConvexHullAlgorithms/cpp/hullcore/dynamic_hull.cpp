@@ -0,0 +1,451 @@
+#include "dynamic_hull.h"
+
+#include <algorithm>
+
+#include "predicates.h"
+
+using namespace std;
+
+namespace hullcore {
+
+namespace {
+
+const uint32_t none = UINT32_MAX;
+
+// Ordering the points lexicographically amounts to shearing them by an
+// infinitesimal x += e*y, which gives every point its own x and leaves all
+// orientations alone. The chains are Andrew's lower and upper chains from
+// the first leaf to the last, and every argument below is the one for
+// distinct x, with above and below swapped on the lower chain.
+bool pointLess(Point2 a, Point2 b)
+{
+    return a.x < b.x || (a.x == b.x && a.y < b.y);
+}
+
+// Positive when c is strictly on the hull's side of a -> b: below it for the
+// upper chain, above it for the lower one.
+double inward(bool upper, Point2 a, Point2 b, Point2 c)
+{
+    double orientation = Orient2d(a, b, c);
+    return upper ? -orientation : orientation;
+}
+
+}
+
+bool DynamicHull::lexLess(uint32_t a, uint32_t b) const
+{
+    return pointLess(nodes[a].point, nodes[b].point);
+}
+
+uint32_t DynamicHull::newNode()
+{
+    uint32_t node;
+    if (!freeNodes.empty()) {
+        node = freeNodes.back();
+        freeNodes.pop_back();
+    }
+    else {
+        node = uint32_t(nodes.size());
+        nodes.emplace_back();
+    }
+    Node& fresh = nodes[node];
+    fresh.point = {};
+    fresh.parent = fresh.left = fresh.right = none;
+    fresh.height = 0;
+    fresh.last = node;
+    fresh.firstId = none;
+    return node;
+}
+
+uint32_t DynamicHull::newLeaf(Point2 point)
+{
+    uint32_t leaf = newNode();
+    nodes[leaf].point = point;
+    return leaf;
+}
+
+void DynamicHull::freeNode(uint32_t node)
+{
+    freeNodes.push_back(node);
+}
+
+void DynamicHull::attachId(uint32_t id, uint32_t leaf)
+{
+    uint32_t head = nodes[leaf].firstId;
+    ids[id] = { leaf, none, head };
+    if (head != none) {
+        ids[head].previous = id;
+    }
+    nodes[leaf].firstId = id;
+}
+
+bool DynamicHull::detachId(uint32_t id)
+{
+    IdEntry entry = ids[id];
+    if (entry.previous != none)
+        ids[entry.previous].next = entry.next;
+    else
+        nodes[entry.leaf].firstId = entry.next;
+    if (entry.next != none)
+        ids[entry.next].previous = entry.previous;
+    ids[id].leaf = none;
+    return nodes[entry.leaf].firstId == none;
+}
+
+int32_t DynamicHull::heightOf(uint32_t node) const
+{
+    return nodes[node].height;
+}
+
+// Tangent from a point lexicographically before the whole subtree to the
+// chain of the subtree: the vertex t with the subtree on or right of from
+// -> t for the upper chain, taking the farthest of several collinear ones.
+// [low, high] is the part of the current node's chain that also belongs to
+// the subtree's chain; an edge outside it is not on the chain searched.
+uint32_t DynamicHull::tangentLeaf(Chain chain, Point2 from, uint32_t subtree) const
+{
+    uint32_t node = subtree;
+    uint32_t low = none;
+    uint32_t high = none;
+    while (nodes[node].left != none) {
+        uint32_t a = nodes[node].bridges[chain][0];
+        uint32_t b = nodes[node].bridges[chain][1];
+        bool goRight;
+        if (high != none && (high == a || lexLess(high, a)))
+            goRight = false;
+        else if (low != none && (low == b || lexLess(b, low)))
+            goRight = true;
+        else
+            goRight = inward(chain == UPPER, from, nodes[a].point, nodes[b].point) <= 0;
+        if (goRight) {
+            if (low == none || lexLess(low, b))
+                low = b;
+            node = nodes[node].right;
+        }
+        else {
+            if (high == none || lexLess(a, high))
+                high = a;
+            node = nodes[node].left;
+        }
+    }
+    return node;
+}
+
+// The bridge joins the last vertex p of the left chain whose tangent line to
+// the right chain has the whole left chain on or below it. For an edge a ->
+// a' of the left chain p lies beyond a exactly when a' is strictly above the
+// tangent from a, so the same descent as above finds it, with one tangent
+// search per step.
+void DynamicHull::findBridge(Chain chain, uint32_t node)
+{
+    uint32_t right = nodes[node].right;
+    uint32_t current = nodes[node].left;
+    uint32_t low = none;
+    uint32_t high = none;
+    while (nodes[current].left != none) {
+        uint32_t a = nodes[current].bridges[chain][0];
+        uint32_t b = nodes[current].bridges[chain][1];
+        bool goRight;
+        if (high != none && (high == a || lexLess(high, a)))
+            goRight = false;
+        else if (low != none && (low == b || lexLess(b, low)))
+            goRight = true;
+        else
+            goRight = inward(chain == UPPER, nodes[a].point, nodes[tangentLeaf(chain, nodes[a].point, right)].point,
+                nodes[b].point) < 0;
+        if (goRight) {
+            if (low == none || lexLess(low, b))
+                low = b;
+            current = nodes[current].right;
+        }
+        else {
+            if (high == none || lexLess(a, high))
+                high = a;
+            current = nodes[current].left;
+        }
+    }
+    nodes[node].bridges[chain][0] = current;
+    nodes[node].bridges[chain][1] = tangentLeaf(chain, nodes[current].point, right);
+}
+
+void DynamicHull::update(uint32_t node)
+{
+    Node& n = nodes[node];
+    n.height = 1 + max(heightOf(n.left), heightOf(n.right));
+    n.last = nodes[n.right].last;
+    findBridge(LOWER, node);
+    findBridge(UPPER, node);
+}
+
+void DynamicHull::replaceChild(uint32_t parent, uint32_t from, uint32_t to)
+{
+    nodes[to].parent = parent;
+    if (parent == none)
+        root = to;
+    else if (nodes[parent].left == from)
+        nodes[parent].left = to;
+    else
+        nodes[parent].right = to;
+}
+
+// Lifts one child of node above it. Node is updated in its new place; the
+// lifted child, now the subtree's root, is left to the caller.
+uint32_t DynamicHull::rotate(uint32_t node, bool promoteLeft)
+{
+    uint32_t child = promoteLeft ? nodes[node].left : nodes[node].right;
+    uint32_t moved = promoteLeft ? nodes[child].right : nodes[child].left;
+    replaceChild(nodes[node].parent, node, child);
+    if (promoteLeft) {
+        nodes[node].left = moved;
+        nodes[child].right = node;
+    }
+    else {
+        nodes[node].right = moved;
+        nodes[child].left = node;
+    }
+    nodes[moved].parent = node;
+    nodes[node].parent = child;
+    update(node);
+    return child;
+}
+
+uint32_t DynamicHull::rebalance(uint32_t node)
+{
+    int32_t balance = heightOf(nodes[node].left) - heightOf(nodes[node].right);
+    if (balance > 1) {
+        uint32_t child = nodes[node].left;
+        if (heightOf(nodes[child].right) > heightOf(nodes[child].left))
+            update(rotate(child, false));
+        return rotate(node, true);
+    }
+    if (balance < -1) {
+        uint32_t child = nodes[node].right;
+        if (heightOf(nodes[child].left) > heightOf(nodes[child].right))
+            update(rotate(child, true));
+        return rotate(node, false);
+    }
+    return node;
+}
+
+void DynamicHull::repairPath(uint32_t node)
+{
+    while (node != none) {
+        node = rebalance(node);
+        update(node);
+        node = nodes[node].parent;
+    }
+}
+
+uint32_t DynamicHull::neighbourLeaf(uint32_t leaf, bool right) const
+{
+    uint32_t node = leaf;
+    uint32_t parent = nodes[node].parent;
+    while (parent != none && (right ? nodes[parent].right : nodes[parent].left) == node) {
+        node = parent;
+        parent = nodes[node].parent;
+    }
+    if (parent == none)
+        return none;
+    node = right ? nodes[parent].right : nodes[parent].left;
+    while (nodes[node].left != none) {
+        node = right ? nodes[node].left : nodes[node].right;
+    }
+    return node;
+}
+
+void DynamicHull::insertPoint(uint32_t id, Point2 point)
+{
+    pointCount++;
+    if (root == none) {
+        root = newLeaf(point);
+        attachId(id, root);
+        return;
+    }
+
+    uint32_t leaf = root;
+    while (nodes[leaf].left != none) {
+        uint32_t left = nodes[leaf].left;
+        leaf = pointLess(nodes[nodes[left].last].point, point) ? nodes[leaf].right : left;
+    }
+    if (nodes[leaf].point == point) {
+        attachId(id, leaf);
+        return;
+    }
+
+    uint32_t added = newLeaf(point);
+    uint32_t inner = newNode();
+    attachId(id, added);
+    replaceChild(nodes[leaf].parent, leaf, inner);
+    bool addedFirst = pointLess(point, nodes[leaf].point);
+    nodes[inner].left = addedFirst ? added : leaf;
+    nodes[inner].right = addedFirst ? leaf : added;
+    nodes[added].parent = inner;
+    nodes[leaf].parent = inner;
+    repairPath(inner);
+}
+
+void DynamicHull::removeLeaf(uint32_t leaf)
+{
+    uint32_t parent = nodes[leaf].parent;
+    freeNode(leaf);
+    if (parent == none) {
+        root = none;
+        return;
+    }
+    uint32_t sibling = nodes[parent].left == leaf ? nodes[parent].right : nodes[parent].left;
+    uint32_t grandparent = nodes[parent].parent;
+    replaceChild(grandparent, parent, sibling);
+    freeNode(parent);
+    repairPath(grandparent);
+}
+
+void DynamicHull::Build(const Point2* points, size_t count)
+{
+    Reset();
+    ids.resize(count);
+    nodes.reserve(2 * count);
+
+    vector<uint32_t> order(count);
+    for (size_t i = 0; i < count; i++) {
+        order[i] = uint32_t(i);
+    }
+    sort(order.begin(), order.end(), [&](uint32_t a, uint32_t b) { return pointLess(points[a], points[b]); });
+
+    vector<uint32_t> leaves;
+    for (uint32_t id : order) {
+        if (leaves.empty() || nodes[leaves.back()].point != points[id]) {
+            leaves.push_back(newLeaf(points[id]));
+        }
+        attachId(id, leaves.back());
+    }
+    pointCount = count;
+    if (!leaves.empty()) {
+        root = buildTree(leaves.data(), leaves.size());
+    }
+}
+
+uint32_t DynamicHull::buildTree(const uint32_t* leaves, size_t count)
+{
+    if (count == 1) {
+        return leaves[0];
+    }
+    uint32_t left = buildTree(leaves, count / 2);
+    uint32_t right = buildTree(leaves + count / 2, count - count / 2);
+    uint32_t node = newNode();
+    nodes[node].left = left;
+    nodes[node].right = right;
+    nodes[left].parent = node;
+    nodes[right].parent = node;
+    update(node);
+    return node;
+}
+
+size_t DynamicHull::Insert(Point2 point)
+{
+    uint32_t id;
+    if (!freeIds.empty()) {
+        id = freeIds.back();
+        freeIds.pop_back();
+    }
+    else {
+        id = uint32_t(ids.size());
+        ids.emplace_back();
+    }
+    insertPoint(id, point);
+    return id;
+}
+
+void DynamicHull::Erase(size_t id)
+{
+    uint32_t leaf = ids[id].leaf;
+    pointCount--;
+    if (detachId(uint32_t(id))) {
+        removeLeaf(leaf);
+    }
+    freeIds.push_back(uint32_t(id));
+}
+
+void DynamicHull::Move(size_t id, Point2 point)
+{
+    uint32_t leaf = ids[id].leaf;
+    if (nodes[leaf].point == point) {
+        return;
+    }
+
+    // A point alone at its leaf that keeps its place in the order is
+    // updated in place, which repairs one path instead of two.
+    if (nodes[leaf].firstId == id && ids[id].next == none) {
+        uint32_t previous = neighbourLeaf(leaf, false);
+        uint32_t next = neighbourLeaf(leaf, true);
+        if ((previous == none || pointLess(nodes[previous].point, point)) &&
+            (next == none || pointLess(point, nodes[next].point))) {
+            nodes[leaf].point = point;
+            repairPath(nodes[leaf].parent);
+            return;
+        }
+    }
+
+    pointCount--;
+    if (detachId(uint32_t(id))) {
+        removeLeaf(leaf);
+    }
+    insertPoint(uint32_t(id), point);
+}
+
+void DynamicHull::Reset()
+{
+    nodes.clear();
+    freeNodes.clear();
+    ids.clear();
+    freeIds.clear();
+    root = none;
+    pointCount = 0;
+}
+
+// Appends the vertices of the node's chain within [low, high], in order.
+void DynamicHull::collectChain(Chain chain, uint32_t node, uint32_t low, uint32_t high, vector<uint32_t>& out) const
+{
+    if (nodes[node].left == none) {
+        out.push_back(node);
+        return;
+    }
+    uint32_t a = nodes[node].bridges[chain][0];
+    uint32_t b = nodes[node].bridges[chain][1];
+    if (low == none || low == a || lexLess(low, a)) {
+        bool highInLeft = high != none && (high == a || lexLess(high, a));
+        collectChain(chain, nodes[node].left, low, highInLeft ? high : a, out);
+    }
+    if (high == none || high == b || lexLess(b, high)) {
+        bool lowInRight = low != none && lexLess(b, low);
+        collectChain(chain, nodes[node].right, lowInRight ? low : b, high, out);
+    }
+}
+
+void DynamicHull::Vertices(vector<Point2>& vertices, vector<size_t>* vertexIds) const
+{
+    vertices.clear();
+    if (vertexIds) {
+        vertexIds->clear();
+    }
+    if (root == none) {
+        return;
+    }
+
+    // Both chains run from the first leaf to the last, so the upper one is
+    // walked backwards without its two ends.
+    vector<uint32_t> lower;
+    vector<uint32_t> upper;
+    collectChain(LOWER, root, none, none, lower);
+    collectChain(UPPER, root, none, none, upper);
+    for (size_t i = upper.size() - 1; i > 1; i--) {
+        lower.push_back(upper[i - 1]);
+    }
+    for (uint32_t leaf : lower) {
+        vertices.push_back(nodes[leaf].point);
+        if (vertexIds) {
+            vertexIds->push_back(nodes[leaf].firstId);
+        }
+    }
+}
+
+}
@@ -0,0 +1,91 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+#include "point.h"
+
+namespace hullcore {
+
+// Hull of a point set under arbitrary insertions, deletions and moves. The
+// distinct points are the leaves of an AVL tree in lexicographic order, and
+// every inner node keeps the bridges that join the upper and the lower hulls
+// of its two subtrees (Overmars and van Leeuwen). A bridge is found by a
+// binary search over one child's implicit hull with a nested search over the
+// other's, using nothing but Orient2d, so an update recomputes one root path
+// in O(log^3 n) and never looks at the interior points it hides.
+class DynamicHull {
+public:
+    // Replaces the contents with points[0, count), point i getting id i. The
+    // bridges of a freshly balanced tree cost O(n) in total after the sort.
+    void Build(const Point2* points, size_t count);
+
+    // Ids stay valid until the point is erased and are then reused.
+    size_t Insert(Point2 point);
+    void Erase(size_t id);
+    void Move(size_t id, Point2 point);
+    void Reset();
+
+    size_t Size() const { return pointCount; }
+    Point2 Position(size_t id) const { return nodes[ids[id].leaf].point; }
+
+    // Counter-clockwise from the lowest of the leftmost points, as
+    // CalculateHull, in O(h log n); ids, if given, receive one id per vertex.
+    void Vertices(std::vector<Point2>& vertices, std::vector<size_t>* vertexIds = nullptr) const;
+
+private:
+    enum Chain { LOWER, UPPER };
+
+    struct Node {
+        Point2 point;
+        uint32_t parent;
+        uint32_t left;
+        uint32_t right;
+        int32_t height;
+        // Lexicographically largest leaf of the subtree, for routing.
+        uint32_t last;
+        // Leaves joined by the lower and the upper bridge of an inner node.
+        uint32_t bridges[2][2];
+        // Leaves: head of the list of ids sharing this point.
+        uint32_t firstId;
+    };
+
+    struct IdEntry {
+        uint32_t leaf;
+        uint32_t previous;
+        uint32_t next;
+    };
+
+    uint32_t newNode();
+    uint32_t newLeaf(Point2 point);
+    void freeNode(uint32_t node);
+    void attachId(uint32_t id, uint32_t leaf);
+    // Unlinks id from its leaf and returns whether the leaf is now empty.
+    bool detachId(uint32_t id);
+    void insertPoint(uint32_t id, Point2 point);
+    void removeLeaf(uint32_t leaf);
+    uint32_t buildTree(const uint32_t* leaves, size_t count);
+
+    void replaceChild(uint32_t parent, uint32_t from, uint32_t to);
+    uint32_t rotate(uint32_t node, bool promoteLeft);
+    uint32_t rebalance(uint32_t node);
+    void repairPath(uint32_t node);
+    void update(uint32_t node);
+    int32_t heightOf(uint32_t node) const;
+    uint32_t neighbourLeaf(uint32_t leaf, bool right) const;
+
+    bool lexLess(uint32_t a, uint32_t b) const;
+    uint32_t tangentLeaf(Chain chain, Point2 from, uint32_t subtree) const;
+    void findBridge(Chain chain, uint32_t node);
+    void collectChain(Chain chain, uint32_t node, uint32_t low, uint32_t high, std::vector<uint32_t>& out) const;
+
+    std::vector<Node> nodes;
+    std::vector<uint32_t> freeNodes;
+    std::vector<IdEntry> ids;
+    std::vector<uint32_t> freeIds;
+    uint32_t root = UINT32_MAX;
+    size_t pointCount = 0;
+};
+
+}
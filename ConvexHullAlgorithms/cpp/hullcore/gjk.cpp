@@ -0,0 +1,313 @@
+#include "gjk.h"
+
+#include <algorithm>
+#include <cmath>
+#include <vector>
+
+using namespace std;
+
+namespace hullcore {
+
+namespace {
+
+const int maxGjkIterations = 64;
+const int maxEpaIterations = 128;
+const double relativeTolerance = 1e-12;
+
+struct Vec {
+    double x;
+    double y;
+};
+
+Vec operator-(Vec a, Vec b) { return { a.x - b.x, a.y - b.y }; }
+Vec operator+(Vec a, Vec b) { return { a.x + b.x, a.y + b.y }; }
+Vec operator*(double s, Vec a) { return { s * a.x, s * a.y }; }
+double dot(Vec a, Vec b) { return a.x * b.x + a.y * b.y; }
+double cross(Vec a, Vec b) { return a.x * b.y - a.y * b.x; }
+
+Vec toVec(const Point2& p) { return { p.x, p.y }; }
+
+// A vertex of the Minkowski difference together with the hull vertices it came from.
+struct SupportPoint {
+    Vec w;
+    size_t indexA;
+    size_t indexB;
+};
+
+struct Difference {
+    const Point2* a;
+    size_t countA;
+    const Point2* b;
+    size_t countB;
+    size_t hintA = 0;
+    size_t hintB = 0;
+    size_t calls = 0;
+
+    SupportPoint support(Vec d)
+    {
+        calls++;
+        hintA = SupportVertex(a, countA, d.x, d.y, hintA);
+        hintB = SupportVertex(b, countB, -d.x, -d.y, hintB);
+        return { toVec(a[hintA]) - toVec(b[hintB]), hintA, hintB };
+    }
+};
+
+double dotAt(const Point2* polygon, size_t index, double dx, double dy)
+{
+    return polygon[index].x * dx + polygon[index].y * dy;
+}
+
+// Reduces the simplex to the sub-simplex whose region contains the origin's
+// projection and returns the closest point with its barycentric weights.
+Vec closestOnSimplex(vector<SupportPoint>& simplex, double* weights)
+{
+    if (simplex.size() == 1) {
+        weights[0] = 1;
+        return simplex[0].w;
+    }
+
+    if (simplex.size() == 2) {
+        Vec a = simplex[0].w;
+        Vec b = simplex[1].w;
+        Vec ab = b - a;
+        double t = -dot(a, ab) / dot(ab, ab);
+        if (t <= 0) {
+            simplex.erase(simplex.begin() + 1);
+            weights[0] = 1;
+            return a;
+        }
+        if (t >= 1) {
+            simplex.erase(simplex.begin());
+            weights[0] = 1;
+            return b;
+        }
+        weights[0] = 1 - t;
+        weights[1] = t;
+        return a + t * ab;
+    }
+
+    // Triangle: test vertex, then edge regions, otherwise the origin is inside.
+    Vec a = simplex[0].w, b = simplex[1].w, c = simplex[2].w;
+    Vec ab = b - a, ac = c - a, ap = { -a.x, -a.y };
+    double d1 = dot(ab, ap), d2 = dot(ac, ap);
+    if (d1 <= 0 && d2 <= 0) {
+        simplex = { simplex[0] };
+        weights[0] = 1;
+        return a;
+    }
+    Vec bp = { -b.x, -b.y };
+    double d3 = dot(ab, bp), d4 = dot(ac, bp);
+    if (d3 >= 0 && d4 <= d3) {
+        simplex = { simplex[1] };
+        weights[0] = 1;
+        return b;
+    }
+    double vc = d1 * d4 - d3 * d2;
+    if (vc <= 0 && d1 >= 0 && d3 <= 0) {
+        double t = d1 / (d1 - d3);
+        simplex = { simplex[0], simplex[1] };
+        weights[0] = 1 - t;
+        weights[1] = t;
+        return a + t * ab;
+    }
+    Vec cp = { -c.x, -c.y };
+    double d5 = dot(ab, cp), d6 = dot(ac, cp);
+    if (d6 >= 0 && d5 <= d6) {
+        simplex = { simplex[2] };
+        weights[0] = 1;
+        return c;
+    }
+    double vb = d5 * d2 - d1 * d6;
+    if (vb <= 0 && d2 >= 0 && d6 <= 0) {
+        double t = d2 / (d2 - d6);
+        simplex = { simplex[0], simplex[2] };
+        weights[0] = 1 - t;
+        weights[1] = t;
+        return a + t * ac;
+    }
+    double va = d3 * d6 - d5 * d4;
+    if (va <= 0 && (d4 - d3) >= 0 && (d5 - d6) >= 0) {
+        double t = (d4 - d3) / ((d4 - d3) + (d5 - d6));
+        simplex = { simplex[1], simplex[2] };
+        weights[0] = 1 - t;
+        weights[1] = t;
+        return b + t * (c - b);
+    }
+    double denominator = 1 / (va + vb + vc);
+    weights[0] = va * denominator;
+    weights[1] = vb * denominator;
+    weights[2] = vc * denominator;
+    return { 0, 0 };
+}
+
+void runEpa(Difference& difference, vector<SupportPoint> polytope, double tolerance, GjkResult& result)
+{
+    if (cross(polytope[1].w - polytope[0].w, polytope[2].w - polytope[0].w) < 0) {
+        swap(polytope[1], polytope[2]);
+    }
+
+    for (int iteration = 0; iteration < maxEpaIterations; iteration++) {
+        size_t closestEdge = 0;
+        double closestDistance = INFINITY;
+        Vec closestNormal = { 0, 0 };
+        for (size_t i = 0; i < polytope.size(); i++) {
+            Vec from = polytope[i].w;
+            Vec edge = polytope[(i + 1) % polytope.size()].w - from;
+            double length = sqrt(dot(edge, edge));
+            if (length == 0)
+                continue;
+            Vec normal = { edge.y / length, -edge.x / length };
+            double distance = dot(normal, from);
+            if (distance < closestDistance) {
+                closestDistance = distance;
+                closestNormal = normal;
+                closestEdge = i;
+            }
+        }
+
+        SupportPoint w = difference.support(closestNormal);
+        double reach = dot(w.w, closestNormal);
+        if (reach - closestDistance <= tolerance || iteration + 1 == maxEpaIterations) {
+            result.penetrationDepth = max(0.0, closestDistance);
+            result.normalX = closestNormal.x;
+            result.normalY = closestNormal.y;
+            return;
+        }
+        polytope.insert(polytope.begin() + closestEdge + 1, w);
+    }
+}
+
+}
+
+size_t SupportVertex(const Point2* polygon, size_t count, double dx, double dy, size_t hint)
+{
+    if (count == 0) {
+        return 0;
+    }
+    size_t current = hint < count ? hint : 0;
+    double best = dotAt(polygon, current, dx, dy);
+
+    // On a convex polygon the projection is unimodal along the boundary, so a
+    // local maximum reached by walking in either direction is the global one.
+    for (int direction : { 1, -1 }) {
+        while (true) {
+            size_t next = direction > 0 ? (current + 1 == count ? 0 : current + 1) : (current == 0 ? count - 1 : current - 1);
+            double value = dotAt(polygon, next, dx, dy);
+            if (value <= best)
+                break;
+            current = next;
+            best = value;
+        }
+    }
+    return current;
+}
+
+GjkResult GjkQuery(const Point2* a, size_t countA, const Point2* b, size_t countB, GjkCache* cache)
+{
+    GjkResult result;
+    if (countA == 0 || countB == 0) {
+        return result;
+    }
+
+    Difference difference{ a, countA, b, countB };
+    if (cache) {
+        difference.hintA = cache->hintA < countA ? cache->hintA : 0;
+        difference.hintB = cache->hintB < countB ? cache->hintB : 0;
+    }
+
+    // Scanning the polygons for their extent would cost O(n); the coordinates
+    // of the starting vertices are a good enough measure of scale.
+    const Point2& startA = a[difference.hintA];
+    const Point2& startB = b[difference.hintB];
+    double scale = max(max(fabs(startA.x), fabs(startA.y)), max(fabs(startB.x), fabs(startB.y)));
+    double tolerance = max(scale, 1.0) * 1e-9;
+
+    vector<SupportPoint> simplex;
+    simplex.reserve(3);
+    Vec v = toVec(startA) - toVec(startB);
+    if (dot(v, v) == 0) {
+        v = { 1, 0 };
+    }
+    simplex.push_back(difference.support({ -v.x, -v.y }));
+
+    double weights[3] = { 1, 0, 0 };
+    v = simplex[0].w;
+
+    for (int iteration = 0; iteration < maxGjkIterations; iteration++) {
+        double vv = dot(v, v);
+        if (vv <= tolerance * tolerance) {
+            result.intersecting = true;
+            break;
+        }
+
+        SupportPoint w = difference.support({ -v.x, -v.y });
+        bool repeated = false;
+        for (const SupportPoint& s : simplex) {
+            repeated = repeated || (s.indexA == w.indexA && s.indexB == w.indexB);
+        }
+        if (repeated || vv - dot(v, w.w) <= relativeTolerance * vv + tolerance * tolerance) {
+            break;
+        }
+
+        simplex.push_back(w);
+        v = closestOnSimplex(simplex, weights);
+        if (simplex.size() == 3) {
+            result.intersecting = true;
+            break;
+        }
+    }
+
+    result.supportCalls = difference.calls;
+    if (!result.intersecting) {
+        Vec closestA = { 0, 0 };
+        Vec closestB = { 0, 0 };
+        for (size_t i = 0; i < simplex.size(); i++) {
+            closestA = closestA + weights[i] * toVec(a[simplex[i].indexA]);
+            closestB = closestB + weights[i] * toVec(b[simplex[i].indexB]);
+        }
+        result.distance = sqrt(dot(v, v));
+        result.closestA = { float(closestA.x), float(closestA.y) };
+        result.closestB = { float(closestB.x), float(closestB.y) };
+        if (cache) {
+            cache->hintA = difference.hintA;
+            cache->hintB = difference.hintB;
+        }
+        return result;
+    }
+
+    // The origin can sit on a vertex or a segment of the simplex without that
+    // being on the boundary of a - b, and EPA needs a triangle to start from
+    // either way; grow the simplex until it is one.
+    for (Vec direction : { Vec{ 1, 0 }, Vec{ -1, 0 }, Vec{ 0, 1 }, Vec{ 0, -1 } }) {
+        if (simplex.size() != 1)
+            break;
+        SupportPoint w = difference.support(direction);
+        Vec offset = w.w - simplex[0].w;
+        if (dot(offset, offset) > tolerance * tolerance) {
+            simplex.push_back(w);
+        }
+    }
+    if (simplex.size() == 2) {
+        Vec edge = simplex[1].w - simplex[0].w;
+        double edgeLength = sqrt(dot(edge, edge));
+        for (Vec direction : { Vec{ -edge.y, edge.x }, Vec{ edge.y, -edge.x } }) {
+            SupportPoint w = difference.support(direction);
+            if (fabs(cross(edge, w.w - simplex[0].w)) > tolerance * edgeLength) {
+                simplex.push_back(w);
+                break;
+            }
+        }
+    }
+
+    if (simplex.size() == 3) {
+        runEpa(difference, simplex, tolerance, result);
+    }
+    result.supportCalls = difference.calls;
+    if (cache) {
+        cache->hintA = difference.hintA;
+        cache->hintB = difference.hintB;
+    }
+    return result;
+}
+
+}
@@ -0,0 +1,48 @@
+#pragma once
+
+#include <cstddef>
+
+#include "point.h"
+
+namespace hullcore {
+
+// Index of the vertex of a convex polygon (vertices in hull order, either
+// orientation) farthest along (dx, dy). Hill-climbs from hint, so repeated
+// queries with slowly turning directions cost a few steps each.
+size_t SupportVertex(const Point2* polygon, size_t count, double dx, double dy, size_t hint = 0);
+
+struct GjkResult {
+    bool intersecting = false;
+
+    // Separated polygons: distance between them and the closest point on each.
+    double distance = 0;
+    Point2 closestA = { 0, 0 };
+    Point2 closestB = { 0, 0 };
+
+    // Overlapping polygons (EPA): translating B by penetrationDepth along
+    // (normalX, normalY), which points from A towards B, makes them touch.
+    double penetrationDepth = 0;
+    double normalX = 0;
+    double normalY = 0;
+
+    size_t supportCalls = 0;
+};
+
+// Support vertices the last query ended on. Passing the same cache for the
+// same pair frame after frame starts every hill climb next to its answer.
+struct GjkCache {
+    size_t hintA = 0;
+    size_t hintB = 0;
+};
+
+// GJK over the Minkowski difference a - b evaluated purely through support
+// calls on the two ordered hulls, followed by EPA when they overlap. Touching
+// polygons count as intersecting with zero depth.
+GjkResult GjkQuery(const Point2* a, size_t countA, const Point2* b, size_t countB, GjkCache* cache = nullptr);
+
+inline bool GjkIntersect(const Point2* a, size_t countA, const Point2* b, size_t countB)
+{
+    return GjkQuery(a, countA, b, countB).intersecting;
+}
+
+}
@@ -0,0 +1,63 @@
+#include "hull.h"
+
+#include "chan.h"
+#include "monotone_chain.h"
+#include "prefilter.h"
+#include "quickhull.h"
+#include "task_pool.h"
+
+using namespace std;
+
+namespace hullcore {
+
+void CalculateHull(const Point2* points, size_t count, vector<size_t>& hullIndices, HullEngine engine)
+{
+    switch (engine) {
+    case HullEngine::MonotoneChain:
+        CalculateMonotoneChain(points, count, hullIndices);
+        break;
+    case HullEngine::ParallelQuickHull:
+        CalculateParallelQuickHull(points, count, hullIndices, TaskPool::Default());
+        break;
+    case HullEngine::SimdQuickHull:
+        CalculateSimdQuickHull(points, count, hullIndices);
+        break;
+    case HullEngine::Chan:
+        CalculateChanHull(points, count, hullIndices, TaskPool::Default());
+        break;
+    case HullEngine::QuickHull:
+    default:
+        CalculateQuickHull(points, count, hullIndices);
+        break;
+    }
+}
+
+void CalculateHull(const Point2* points, size_t count, vector<size_t>& hullIndices,
+    HullEngine engine, const HullOptions& options, HullStats* stats)
+{
+    if (stats) {
+        stats->inputCount = count;
+        stats->engineCount = count;
+    }
+    if (!options.prefilter) {
+        CalculateHull(points, count, hullIndices, engine);
+        return;
+    }
+
+    vector<size_t> survivors;
+    AklToussaintFilter(points, count, survivors, TaskPool::Default());
+    if (stats) {
+        stats->engineCount = survivors.size();
+    }
+
+    vector<Point2> kept(survivors.size());
+    for (size_t i = 0; i < survivors.size(); i++) {
+        kept[i] = points[survivors[i]];
+    }
+    CalculateHull(kept.data(), kept.size(), hullIndices, engine);
+    for (size_t& index : hullIndices) {
+        index = survivors[index];
+    }
+}
+
+}
@@ -0,0 +1,36 @@
+#pragma once
+
+#include <cstddef>
+#include <vector>
+
+#include "point.h"
+
+namespace hullcore {
+
+enum class HullEngine { QuickHull, MonotoneChain, ParallelQuickHull, SimdQuickHull, Chan };
+
+// Writes the indices of the hull vertices of points[0, count) into hullIndices,
+// counter-clockwise starting from the lowest of the leftmost points. Collinear
+// boundary points and duplicates are not reported. Parallel engines run on
+// TaskPool::Default().
+void CalculateHull(const Point2* points, size_t count, std::vector<size_t>& hullIndices,
+    HullEngine engine = HullEngine::QuickHull);
+
+struct HullOptions {
+    // Run AklToussaintFilter first and hand the engine only the survivors.
+    bool prefilter = false;
+};
+
+struct HullStats {
+    size_t inputCount = 0;
+    size_t engineCount = 0;
+
+    // Fraction of the input the prefilter kept away from the engine.
+    double RejectionRatio() const { return inputCount ? 1.0 - double(engineCount) / inputCount : 0.0; }
+};
+
+// Same result as the overload above, with the optional stages in options.
+void CalculateHull(const Point2* points, size_t count, std::vector<size_t>& hullIndices,
+    HullEngine engine, const HullOptions& options, HullStats* stats = nullptr);
+
+}
@@ -0,0 +1,140 @@
+#include "incremental_hull.h"
+
+#include <iterator>
+
+#include "predicates.h"
+
+using namespace std;
+
+namespace hullcore {
+
+namespace {
+
+Point2 mirrored(Point2 point)
+{
+    return { point.x, -point.y };
+}
+
+Point2 chainPoint(IncrementalHull::Chain::const_iterator vertex)
+{
+    return { vertex->first, vertex->second.y };
+}
+
+// True when point is on or above the lower chain within its x range.
+bool aboveChain(const IncrementalHull::Chain& chain, Point2 point)
+{
+    if (chain.empty() || point.x < chain.begin()->first || point.x > chain.rbegin()->first)
+        return false;
+    auto right = chain.lower_bound(point.x);
+    if (right->first == point.x)
+        return point.y >= right->second.y;
+    return Orient2d(chainPoint(prev(right)), chainPoint(right), point) >= 0;
+}
+
+bool insertIntoChain(IncrementalHull::Chain& chain, Point2 point, uint64_t index)
+{
+    if (aboveChain(chain, point))
+        return false;
+
+    // A vertex straight above the new point drops out of the chain.
+    auto hint = chain.lower_bound(point.x);
+    if (hint != chain.end() && hint->first == point.x)
+        hint = chain.erase(hint);
+    auto inserted = chain.emplace_hint(hint, point.x, IncrementalHull::ChainVertex{ point.y, index });
+
+    // Vertices on either side that no longer make a strict left turn.
+    while (true) {
+        auto first = next(inserted);
+        if (first == chain.end())
+            break;
+        auto second = next(first);
+        if (second == chain.end() || Orient2d(point, chainPoint(first), chainPoint(second)) > 0)
+            break;
+        chain.erase(first);
+    }
+    while (inserted != chain.begin()) {
+        auto first = prev(inserted);
+        if (first == chain.begin())
+            break;
+        auto second = prev(first);
+        if (Orient2d(chainPoint(second), chainPoint(first), point) > 0)
+            break;
+        chain.erase(first);
+    }
+    return true;
+}
+
+}
+
+void IncrementalHull::Seed(const Point2* points, size_t count, const vector<size_t>& hullIndices)
+{
+    Reset();
+    for (size_t index : hullIndices) {
+        insertIntoChain(lower, points[index], index);
+        insertIntoChain(upper, mirrored(points[index]), index);
+    }
+    pointCount = count;
+}
+
+bool IncrementalHull::Insert(Point2 point)
+{
+    uint64_t index = pointCount++;
+    bool lowerChanged = insertIntoChain(lower, point, index);
+    bool upperChanged = insertIntoChain(upper, mirrored(point), index);
+    return lowerChanged || upperChanged;
+}
+
+void IncrementalHull::Reset()
+{
+    lower.clear();
+    upper.clear();
+    pointCount = 0;
+}
+
+bool IncrementalHull::Contains(Point2 point) const
+{
+    return aboveChain(lower, point) && aboveChain(upper, mirrored(point));
+}
+
+void IncrementalHull::Vertices(vector<Point2>& vertices, vector<uint64_t>* indices) const
+{
+    vertices.clear();
+    if (indices) {
+        indices->clear();
+    }
+    for (auto vertex = lower.begin(); vertex != lower.end(); ++vertex) {
+        vertices.push_back(chainPoint(vertex));
+        if (indices) {
+            indices->push_back(vertex->second.index);
+        }
+    }
+
+    // The upper chain comes back right to left; its ends are skipped where
+    // they coincide with those of the lower chain.
+    for (auto vertex = upper.rbegin(); vertex != upper.rend(); ++vertex) {
+        Point2 point = { vertex->first, -vertex->second.y };
+        bool sharedRight = vertex == upper.rbegin() && point == chainPoint(prev(lower.end()));
+        bool sharedLeft = next(vertex) == upper.rend() && point == chainPoint(lower.begin());
+        if (sharedRight || sharedLeft)
+            continue;
+        vertices.push_back(point);
+        if (indices) {
+            indices->push_back(vertex->second.index);
+        }
+    }
+}
+
+size_t IncrementalHull::VertexCount() const
+{
+    if (lower.empty()) {
+        return 0;
+    }
+    size_t count = lower.size() + upper.size();
+    if (mirrored(chainPoint(prev(upper.end()))) == chainPoint(prev(lower.end())))
+        count--;
+    if (upper.size() > 1 && mirrored(chainPoint(upper.begin())) == chainPoint(lower.begin()))
+        count--;
+    return count;
+}
+
+}
@@ -0,0 +1,51 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <map>
+#include <vector>
+
+#include "point.h"
+
+namespace hullcore {
+
+// Online hull of points inserted one at a time. The lower and upper chains
+// are kept as balanced trees ordered by x, so an interior point is rejected
+// with one O(log h) lookup per chain and a hull point costs O(log h)
+// amortized, every vertex being removed at most once.
+class IncrementalHull {
+public:
+    // Starts over from a finished hull, hullIndices into points[0, count) as
+    // CalculateHull reports them, so only the hull has to be inserted.
+    void Seed(const Point2* points, size_t count, const std::vector<size_t>& hullIndices);
+
+    // Returns false when point is inside or on the hull, which then stays
+    // unchanged.
+    bool Insert(Point2 point);
+    void Reset();
+
+    bool Contains(Point2 point) const;
+
+    // Counter-clockwise from the lowest of the leftmost points, as
+    // CalculateHull; indices, if given, receive the position of each vertex
+    // in the insertion order, seed points included.
+    void Vertices(std::vector<Point2>& vertices, std::vector<uint64_t>* indices = nullptr) const;
+    size_t VertexCount() const;
+
+    uint64_t PointCount() const { return pointCount; }
+
+    struct ChainVertex {
+        float y;
+        uint64_t index;
+    };
+    using Chain = std::map<float, ChainVertex>;
+
+private:
+    // Both chains run left to right and are stored as lower chains; the upper
+    // one holds the points mirrored in the x axis.
+    Chain lower;
+    Chain upper;
+    uint64_t pointCount = 0;
+};
+
+}
@@ -0,0 +1,281 @@
+#include "intersection.h"
+
+#include <algorithm>
+
+#include "broad_phase.h"
+#include "predicates.h"
+
+using namespace std;
+
+namespace hullcore {
+
+namespace {
+
+const size_t batchGrain = 64;
+
+struct Vec {
+    double x;
+    double y;
+};
+
+Vec toVec(const Point2& p) { return { p.x, p.y }; }
+
+enum class Inside { Unknown, A, B };
+
+// How edge (a0, a1) meets edge (b0, b1), as O'Rourke's SegSegInt reports it.
+enum class Crossing { None, Proper, Vertex, Overlap };
+
+// Where a point collinear with (p, q) lies along it, scaled by |q - p|^2.
+double along(Point2 p, Point2 q, Point2 point)
+{
+    double dx = double(q.x) - p.x;
+    double dy = double(q.y) - p.y;
+    return (double(point.x) - p.x) * dx + (double(point.y) - p.y) * dy;
+}
+
+bool overlapping(Point2 a0, Point2 a1, Point2 b0, Point2 b1)
+{
+    double length = along(a0, a1, a1);
+    double t0 = along(a0, a1, b0);
+    double t1 = along(a0, a1, b1);
+    return max(t0, t1) >= 0 && min(t0, t1) <= length;
+}
+
+// Every side test is exact; only the position of a proper crossing is
+// rounded.
+Crossing crossEdges(Point2 a0, Point2 a1, Point2 b0, Point2 b1, Vec& point)
+{
+    double o0 = Orient2d(b0, b1, a0);
+    double o1 = Orient2d(b0, b1, a1);
+    if (o0 == 0 && o1 == 0) {
+        return overlapping(a0, a1, b0, b1) ? Crossing::Overlap : Crossing::None;
+    }
+    double o2 = Orient2d(a0, a1, b0);
+    double o3 = Orient2d(a0, a1, b1);
+    if ((o0 > 0 && o1 > 0) || (o0 < 0 && o1 < 0) || (o2 > 0 && o3 > 0) || (o2 < 0 && o3 < 0)) {
+        return Crossing::None;
+    }
+    if (o0 == 0) {
+        point = toVec(a0);
+    }
+    else if (o1 == 0) {
+        point = toVec(a1);
+    }
+    else if (o2 == 0) {
+        point = toVec(b0);
+    }
+    else if (o3 == 0) {
+        point = toVec(b1);
+    }
+    else {
+        double t = o0 / (o0 - o1);
+        point = { a0.x + t * (double(a1.x) - a0.x), a0.y + t * (double(a1.y) - a0.y) };
+        return Crossing::Proper;
+    }
+    return Crossing::Vertex;
+}
+
+bool containsPoint(const Point2* polygon, size_t count, Point2 point)
+{
+    for (size_t i = 0, j = count - 1; i < count; j = i++) {
+        if (Orient2d(polygon[j], polygon[i], point) < 0) {
+            return false;
+        }
+    }
+    return true;
+}
+
+// Boundary being traced, with repeats dropped as they come in.
+struct Trace {
+    vector<Vec>& points;
+
+    void add(Vec point)
+    {
+        if (points.empty() || points.back().x != point.x || points.back().y != point.y) {
+            points.push_back(point);
+        }
+    }
+};
+
+void traceIntersection(const Point2* a, size_t countA, const Point2* b, size_t countB, vector<Vec>& points)
+{
+    Trace trace = { points };
+    Inside inside = Inside::Unknown;
+    bool first = true;
+    size_t i = 0;
+    size_t k = 0;
+    size_t stepsA = 0;
+    size_t stepsB = 0;
+
+    auto advanceA = [&] {
+        if (inside == Inside::A)
+            trace.add(toVec(a[i]));
+        stepsA++;
+        i = i + 1 == countA ? 0 : i + 1;
+    };
+    auto advanceB = [&] {
+        if (inside == Inside::B)
+            trace.add(toVec(b[k]));
+        stepsB++;
+        k = k + 1 == countB ? 0 : k + 1;
+    };
+
+    // The current edges are the ones ending at a[i] and b[k].
+    do {
+        Point2 a0 = a[i == 0 ? countA - 1 : i - 1];
+        Point2 b0 = b[k == 0 ? countB - 1 : k - 1];
+        double cross = CrossEdges(a0, a[i], b0, b[k]);
+        double aInB = Orient2d(b0, b[k], a[i]);
+        double bInA = Orient2d(a0, a[i], b[k]);
+
+        Vec point;
+        Crossing crossing = crossEdges(a0, a[i], b0, b[k], point);
+        if (crossing == Crossing::Proper || crossing == Crossing::Vertex) {
+            if (inside == Inside::Unknown && first) {
+                stepsA = stepsB = 0;
+                first = false;
+            }
+            trace.add(point);
+            if (aInB > 0)
+                inside = Inside::A;
+            else if (bInA > 0)
+                inside = Inside::B;
+        }
+
+        // Collinear edges running opposite ways: the polygons lie on either
+        // side of them and at most share a segment.
+        if (crossing == Crossing::Overlap &&
+            (double(a[i].x) - a0.x) * (double(b[k].x) - b0.x) + (double(a[i].y) - a0.y) * (double(b[k].y) - b0.y) < 0) {
+            points.clear();
+            return;
+        }
+        if (cross == 0 && aInB < 0 && bInA < 0) {
+            points.clear();
+            return;
+        }
+
+        if (cross == 0 && aInB == 0 && bInA == 0) {
+            if (inside == Inside::A)
+                advanceB();
+            else
+                advanceA();
+        }
+        else if (cross >= 0) {
+            if (bInA > 0)
+                advanceA();
+            else
+                advanceB();
+        }
+        else {
+            if (aInB > 0)
+                advanceB();
+            else
+                advanceA();
+        }
+    } while ((stepsA < countA || stepsB < countB) && stepsA < 2 * countA && stepsB < 2 * countB);
+
+    if (!first) {
+        while (points.size() > 1 && points.back().x == points[0].x && points.back().y == points[0].y) {
+            points.pop_back();
+        }
+        return;
+    }
+
+    // The boundaries never met, so either one polygon holds the other or
+    // they are disjoint.
+    const Point2* inner = nullptr;
+    size_t innerCount = 0;
+    if (containsPoint(b, countB, a[0])) {
+        inner = a;
+        innerCount = countA;
+    }
+    else if (containsPoint(a, countA, b[0])) {
+        inner = b;
+        innerCount = countB;
+    }
+    for (size_t v = 0; v < innerCount; v++) {
+        points.push_back(toVec(inner[v]));
+    }
+}
+
+double intersect(const Point2* a, size_t countA, const Point2* b, size_t countB, vector<Vec>& points,
+    vector<Point2>* result)
+{
+    points.clear();
+    if (result) {
+        result->clear();
+    }
+    if (countA < 3 || countB < 3) {
+        return 0;
+    }
+
+    traceIntersection(a, countA, b, countB, points);
+    if (points.size() < 3) {
+        return 0;
+    }
+
+    double area = 0;
+    for (size_t v = 0, u = points.size() - 1; v < points.size(); u = v++) {
+        area += points[u].x * points[v].y - points[u].y * points[v].x;
+    }
+    area *= 0.5;
+    if (area <= 0) {
+        return 0;
+    }
+
+    if (result) {
+        for (const Vec& point : points) {
+            Point2 rounded = { float(point.x), float(point.y) };
+            if (result->empty() || result->back() != rounded) {
+                result->push_back(rounded);
+            }
+        }
+        while (result->size() > 1 && result->back() == result->front()) {
+            result->pop_back();
+        }
+        if (result->size() < 3) {
+            result->clear();
+        }
+    }
+    return area;
+}
+
+}
+
+double PolygonArea(const Point2* polygon, size_t count)
+{
+    double area = 0;
+    for (size_t i = 0, j = count == 0 ? 0 : count - 1; i < count; j = i++) {
+        area += double(polygon[j].x) * polygon[i].y - double(polygon[j].y) * polygon[i].x;
+    }
+    return 0.5 * area;
+}
+
+double ConvexIntersection(const Point2* a, size_t countA, const Point2* b, size_t countB, vector<Point2>& result)
+{
+    vector<Vec> points;
+    return intersect(a, countA, b, countB, points, &result);
+}
+
+void ConvexIntersectionBatch(const Point2* a, size_t countA, const PolygonRef* others, size_t otherCount,
+    double* areas, vector<Point2>* results, TaskPool& pool)
+{
+    Aabb box = ComputeAabb(a, countA);
+    pool.ParallelFor(0, otherCount, batchGrain, [&](size_t first, size_t last) {
+        vector<Vec> points;
+        for (size_t o = first; o < last; o++) {
+            const PolygonRef& other = others[o];
+            vector<Point2>* result = results ? &results[o] : nullptr;
+            if (countA == 0 || other.count == 0 || !Overlaps(box, ComputeAabb(other.points, other.count))) {
+                areas[o] = 0;
+                if (result) {
+                    result->clear();
+                }
+                continue;
+            }
+            areas[o] = intersect(a, countA, other.points, other.count, points, result);
+        }
+    });
+}
+
+}
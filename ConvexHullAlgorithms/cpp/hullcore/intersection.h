@@ -0,0 +1,36 @@
+#pragma once
+
+#include <cstddef>
+#include <vector>
+
+#include "point.h"
+#include "task_pool.h"
+
+namespace hullcore {
+
+// Signed area of a simple polygon, positive when it runs counter-clockwise.
+double PolygonArea(const Point2* polygon, size_t count);
+
+// Intersection of two convex polygons given counter-clockwise without
+// collinear vertices (CalculateHull order, any starting vertex), by O'Rourke's
+// edge chasing: the two boundaries are walked together, always advancing the
+// edge that aims at the other one, so O(countA + countB). result is the
+// intersection polygon counter-clockwise; crossing points are rounded to
+// float. Polygons that do not overlap, only touch, or have fewer than three
+// vertices give an empty result. Returns the area, taken before rounding.
+double ConvexIntersection(const Point2* a, size_t countA, const Point2* b, size_t countB, std::vector<Point2>& result);
+
+// Vertices of one polygon in a batch.
+struct PolygonRef {
+    const Point2* points;
+    size_t count;
+};
+
+// Intersects a with every polygon in others, split into chunks across the
+// pool. areas[i] gets the area shared with others[i]; results, when given,
+// gets the intersection polygons. Pairs whose bounding boxes miss each
+// other are rejected without walking their edges.
+void ConvexIntersectionBatch(const Point2* a, size_t countA, const PolygonRef* others, size_t otherCount,
+    double* areas, std::vector<Point2>* results = nullptr, TaskPool& pool = TaskPool::Default());
+
+}
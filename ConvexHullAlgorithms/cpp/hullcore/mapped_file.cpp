@@ -0,0 +1,165 @@
+#include "mapped_file.h"
+
+#ifdef _WIN32
+#ifndef NOMINMAX
+#define NOMINMAX
+#endif
+#include <windows.h>
+#else
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+namespace hullcore {
+
+MappedFile::~MappedFile()
+{
+    Close();
+}
+
+#ifdef _WIN32
+
+bool MappedFile::Open(const char* path)
+{
+    Close();
+    HANDLE handle = CreateFileA(path, GENERIC_READ, FILE_SHARE_READ, nullptr, OPEN_EXISTING,
+        FILE_ATTRIBUTE_NORMAL | FILE_FLAG_SEQUENTIAL_SCAN, nullptr);
+    if (handle == INVALID_HANDLE_VALUE)
+        return false;
+
+    LARGE_INTEGER fileSize;
+    if (!GetFileSizeEx(handle, &fileSize)) {
+        CloseHandle(handle);
+        return false;
+    }
+    file = handle;
+    size = uint64_t(fileSize.QuadPart);
+
+    // Empty files cannot be mapped; they simply have no views.
+    if (size > 0) {
+        mapping = CreateFileMappingA(handle, nullptr, PAGE_READONLY, 0, 0, nullptr);
+        if (!mapping) {
+            Close();
+            return false;
+        }
+    }
+    return true;
+}
+
+void MappedFile::Close()
+{
+    UnmapView();
+    if (mapping)
+        CloseHandle(mapping);
+    if (file)
+        CloseHandle(file);
+    mapping = nullptr;
+    file = nullptr;
+    size = 0;
+}
+
+bool MappedFile::IsOpen() const
+{
+    return file != nullptr;
+}
+
+size_t MappedFile::Granularity()
+{
+    SYSTEM_INFO info;
+    GetSystemInfo(&info);
+    return info.dwAllocationGranularity;
+}
+
+const void* MappedFile::MapView(uint64_t offset, size_t length)
+{
+    UnmapView();
+    if (!mapping || length == 0 || offset + length > size)
+        return nullptr;
+    view = MapViewOfFile(mapping, FILE_MAP_READ, DWORD(offset >> 32), DWORD(offset & 0xFFFFFFFF), length);
+    viewLength = view ? length : 0;
+    return view;
+}
+
+void MappedFile::UnmapView()
+{
+    if (view)
+        UnmapViewOfFile(view);
+    view = nullptr;
+    viewLength = 0;
+}
+
+void MappedFile::Prefetch(uint64_t, size_t) const
+{
+    // Sequential-scan handles already get aggressive read-ahead on Windows.
+}
+
+#else
+
+bool MappedFile::Open(const char* path)
+{
+    Close();
+    descriptor = open(path, O_RDONLY);
+    if (descriptor < 0)
+        return false;
+
+    struct stat info;
+    if (fstat(descriptor, &info) != 0) {
+        Close();
+        return false;
+    }
+    size = uint64_t(info.st_size);
+    return true;
+}
+
+void MappedFile::Close()
+{
+    UnmapView();
+    if (descriptor >= 0)
+        close(descriptor);
+    descriptor = -1;
+    size = 0;
+}
+
+bool MappedFile::IsOpen() const
+{
+    return descriptor >= 0;
+}
+
+size_t MappedFile::Granularity()
+{
+    return size_t(sysconf(_SC_PAGESIZE));
+}
+
+const void* MappedFile::MapView(uint64_t offset, size_t length)
+{
+    UnmapView();
+    if (descriptor < 0 || length == 0 || offset + length > size)
+        return nullptr;
+    void* address = mmap(nullptr, length, PROT_READ, MAP_SHARED, descriptor, off_t(offset));
+    if (address == MAP_FAILED)
+        return nullptr;
+    madvise(address, length, MADV_SEQUENTIAL);
+    view = address;
+    viewLength = length;
+    return view;
+}
+
+void MappedFile::UnmapView()
+{
+    if (view)
+        munmap(view, viewLength);
+    view = nullptr;
+    viewLength = 0;
+}
+
+void MappedFile::Prefetch(uint64_t offset, size_t length) const
+{
+    if (descriptor >= 0 && length > 0)
+        posix_fadvise(descriptor, off_t(offset), off_t(length), POSIX_FADV_WILLNEED);
+}
+
+#endif
+
+}
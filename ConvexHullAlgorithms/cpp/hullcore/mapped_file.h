@@ -0,0 +1,50 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+
+namespace hullcore {
+
+// Read-only file mapping. Views are mapped window by window so a file far
+// larger than memory (or, on 32-bit builds, than the address space) can be
+// walked with only the current window resident.
+class MappedFile {
+public:
+    MappedFile() = default;
+    ~MappedFile();
+
+    MappedFile(const MappedFile&) = delete;
+    MappedFile& operator=(const MappedFile&) = delete;
+
+    bool Open(const char* path);
+    void Close();
+
+    bool IsOpen() const;
+    uint64_t Size() const { return size; }
+
+    // View offsets must be multiples of this (the page size, or the 64 KiB
+    // allocation granularity on Windows).
+    static size_t Granularity();
+
+    // Maps [offset, offset + length) and returns its address, or null. Any
+    // previous view of this file is unmapped first.
+    const void* MapView(uint64_t offset, size_t length);
+    void UnmapView();
+
+    // Asks the OS to start reading [offset, offset + length) in the
+    // background; a hint only, and a no-op where unsupported.
+    void Prefetch(uint64_t offset, size_t length) const;
+
+private:
+    uint64_t size = 0;
+    void* view = nullptr;
+    size_t viewLength = 0;
+#ifdef _WIN32
+    void* file = nullptr;
+    void* mapping = nullptr;
+#else
+    int descriptor = -1;
+#endif
+};
+
+}
@@ -0,0 +1,206 @@
+#include "minkowski.h"
+
+#include "predicates.h"
+
+using namespace std;
+
+namespace hullcore {
+
+namespace {
+
+struct Edge {
+    double x;
+    double y;
+};
+
+// A convex polygon read through an optional point reflection, so the
+// difference can merge -b without materializing it.
+struct PolygonView {
+    const Point2* points;
+    size_t count;
+    float sign;
+
+    Point2 at(size_t index) const { return { sign * points[index].x, sign * points[index].y }; }
+};
+
+// Vertex step positions after start, wrapping without a division; step <= count.
+size_t wrap(size_t start, size_t step, size_t count)
+{
+    size_t index = start + step;
+    return index >= count ? index - count : index;
+}
+
+Edge edgeAt(const PolygonView& polygon, size_t start, size_t step)
+{
+    Point2 from = polygon.at(wrap(start, step, polygon.count));
+    Point2 to = polygon.at(wrap(start, step + 1, polygon.count));
+    return Edge{ double(to.x) - from.x, double(to.y) - from.y };
+}
+
+// Edges are ordered by polar angle in [0, 2pi); starting both walks at their
+// lowest vertex makes each edge sequence ascend in that order.
+bool isLowerHalf(const Edge& e)
+{
+    return e.y < 0 || (e.y == 0 && e.x < 0);
+}
+
+// Step i of a against step k of b. The cross product is CrossEdges over the
+// deltas already at hand; the endpoints are fetched again only in the rare
+// case its sign needs the exact fallback.
+int compareAngle(const PolygonView& a, size_t startA, size_t i, const PolygonView& b, size_t startB, size_t k)
+{
+    Edge edgeA = edgeAt(a, startA, i);
+    Edge edgeB = edgeAt(b, startB, k);
+    bool lowerA = isLowerHalf(edgeA);
+    bool lowerB = isLowerHalf(edgeB);
+    if (lowerA != lowerB)
+        return lowerA ? 1 : -1;
+    double left = edgeA.x * edgeB.y;
+    double right = edgeA.y * edgeB.x;
+    double cross = left - right;
+    if (!determinantCertain(left, right, cross)) {
+        cross = CrossEdgesExact(a.at(wrap(startA, i, a.count)), a.at(wrap(startA, i + 1, a.count)),
+            b.at(wrap(startB, k, b.count)), b.at(wrap(startB, k + 1, b.count)));
+    }
+    if (cross > 0)
+        return -1;
+    if (cross < 0)
+        return 1;
+    return 0;
+}
+
+size_t lowestVertex(const PolygonView& polygon)
+{
+    size_t lowest = 0;
+    Point2 best = polygon.at(0);
+    for (size_t i = 1; i < polygon.count; i++) {
+        Point2 point = polygon.at(i);
+        if (point.y < best.y || (point.y == best.y && point.x < best.x)) {
+            lowest = i;
+            best = point;
+        }
+    }
+    return lowest;
+}
+
+size_t mergeEdges(const PolygonView& a, const PolygonView& b, Point2* result)
+{
+    if (a.count == 0 || b.count == 0) {
+        return 0;
+    }
+
+    size_t startA = lowestVertex(a);
+    size_t startB = lowestVertex(b);
+    size_t edgesA = a.count > 1 ? a.count : 0;
+    size_t edgesB = b.count > 1 ? b.count : 0;
+    size_t i = 0;
+    size_t k = 0;
+    size_t count = 0;
+
+    while (i < edgesA || k < edgesB) {
+        Point2 pointA = a.at(wrap(startA, i, a.count));
+        Point2 pointB = b.at(wrap(startB, k, b.count));
+        result[count++] = { pointA.x + pointB.x, pointA.y + pointB.y };
+
+        // Parallel edges of both polygons collapse into a single edge.
+        int order;
+        if (i == edgesA)
+            order = 1;
+        else if (k == edgesB)
+            order = -1;
+        else
+            order = compareAngle(a, startA, i, b, startB, k);
+
+        if (order <= 0)
+            i++;
+        if (order >= 0)
+            k++;
+    }
+
+    if (count == 0) {
+        Point2 pointA = a.at(0);
+        Point2 pointB = b.at(0);
+        result[count++] = { pointA.x + pointB.x, pointA.y + pointB.y };
+    }
+    return count;
+}
+
+}
+
+void CalculateSum(const Point2* a, size_t countA, const Point2* b, size_t countB, vector<Point2>& result)
+{
+    result.reserve(result.size() + countA * countB);
+    for (size_t i = 0; i < countA; i++) {
+        for (size_t k = 0; k < countB; k++) {
+            result.push_back({ a[i].x + b[k].x, a[i].y + b[k].y });
+        }
+    }
+}
+
+void CalculateDiff(const Point2* a, size_t countA, const Point2* b, size_t countB, vector<Point2>& result)
+{
+    result.reserve(result.size() + countA * countB);
+    for (size_t i = 0; i < countA; i++) {
+        for (size_t k = 0; k < countB; k++) {
+            result.push_back({ a[i].x - b[k].x, a[i].y - b[k].y });
+        }
+    }
+}
+
+size_t ConvexMinkowskiSum(const Point2* a, size_t countA, const Point2* b, size_t countB, Point2* result)
+{
+    return mergeEdges(PolygonView{ a, countA, 1.0f }, PolygonView{ b, countB, 1.0f }, result);
+}
+
+size_t ConvexMinkowskiDiff(const Point2* a, size_t countA, const Point2* b, size_t countB, Point2* result)
+{
+    return mergeEdges(PolygonView{ a, countA, 1.0f }, PolygonView{ b, countB, -1.0f }, result);
+}
+
+void ConvexMinkowskiSum(const Point2* a, size_t countA, const Point2* b, size_t countB, vector<Point2>& result)
+{
+    result.resize(countA + countB);
+    result.resize(ConvexMinkowskiSum(a, countA, b, countB, result.data()));
+}
+
+void ConvexMinkowskiDiff(const Point2* a, size_t countA, const Point2* b, size_t countB, vector<Point2>& result)
+{
+    result.resize(countA + countB);
+    result.resize(ConvexMinkowskiDiff(a, countA, b, countB, result.data()));
+}
+
+void CalculateSum(const Point3* a, size_t countA, const Point3* b, size_t countB, vector<Point3>& result)
+{
+    result.reserve(result.size() + countA * countB);
+    for (size_t i = 0; i < countA; i++) {
+        for (size_t k = 0; k < countB; k++) {
+            result.push_back({ a[i].x + b[k].x, a[i].y + b[k].y, a[i].z + b[k].z });
+        }
+    }
+}
+
+void CalculateDiff(const Point3* a, size_t countA, const Point3* b, size_t countB, vector<Point3>& result)
+{
+    result.reserve(result.size() + countA * countB);
+    for (size_t i = 0; i < countA; i++) {
+        for (size_t k = 0; k < countB; k++) {
+            result.push_back({ a[i].x - b[k].x, a[i].y - b[k].y, a[i].z - b[k].z });
+        }
+    }
+}
+
+bool ConvexMinkowskiSum(const HalfEdgeMesh& a, const HalfEdgeMesh& b, HalfEdgeMesh& result, TaskPool& pool)
+{
+    vector<Point3> cloud;
+    CalculateSum(a.vertices.data(), a.vertices.size(), b.vertices.data(), b.vertices.size(), cloud);
+    return CalculateQuickHull3(cloud.data(), cloud.size(), result, pool);
+}
+
+bool ConvexMinkowskiDiff(const HalfEdgeMesh& a, const HalfEdgeMesh& b, HalfEdgeMesh& result, TaskPool& pool)
+{
+    vector<Point3> cloud;
+    CalculateDiff(a.vertices.data(), a.vertices.size(), b.vertices.data(), b.vertices.size(), cloud);
+    return CalculateQuickHull3(cloud.data(), cloud.size(), result, pool);
+}
+
+}
@@ -0,0 +1,44 @@
+#pragma once
+
+#include <cstddef>
+#include <vector>
+
+#include "point.h"
+#include "quickhull3.h"
+
+namespace hullcore {
+
+// Appends every pairwise a[i] + b[k] to result; the sum is the hull of that cloud.
+void CalculateSum(const Point2* a, size_t countA, const Point2* b, size_t countB, std::vector<Point2>& result);
+
+// Appends every pairwise a[i] - b[k] to result; the difference is the hull of that cloud.
+void CalculateDiff(const Point2* a, size_t countA, const Point2* b, size_t countB, std::vector<Point2>& result);
+
+// Minkowski sum of two convex polygons given counter-clockwise without
+// collinear vertices (CalculateHull order, any starting vertex). The edge
+// sequences of both are merged by angle in O(countA + countB), so result is
+// the convex sum polygon itself, counter-clockwise from its lowest vertex.
+// Writes at most countA + countB points and returns how many; never allocates.
+size_t ConvexMinkowskiSum(const Point2* a, size_t countA, const Point2* b, size_t countB, Point2* result);
+
+// a - b, merged against the point reflection of b read on the fly.
+size_t ConvexMinkowskiDiff(const Point2* a, size_t countA, const Point2* b, size_t countB, Point2* result);
+
+void ConvexMinkowskiSum(const Point2* a, size_t countA, const Point2* b, size_t countB, std::vector<Point2>& result);
+
+void ConvexMinkowskiDiff(const Point2* a, size_t countA, const Point2* b, size_t countB, std::vector<Point2>& result);
+
+void CalculateSum(const Point3* a, size_t countA, const Point3* b, size_t countB, std::vector<Point3>& result);
+void CalculateDiff(const Point3* a, size_t countA, const Point3* b, size_t countB, std::vector<Point3>& result);
+
+// Minkowski sum of two 3D hulls from CalculateQuickHull3, as the hull of the
+// pairwise vertex sums, so O(Va * Vb) points go through the 3D engine.
+// result.vertexIndices index that cloud, i * b.vertices.size() + k. Returns
+// false when the sum is flat.
+bool ConvexMinkowskiSum(const HalfEdgeMesh& a, const HalfEdgeMesh& b, HalfEdgeMesh& result,
+    TaskPool& pool = TaskPool::Default());
+
+bool ConvexMinkowskiDiff(const HalfEdgeMesh& a, const HalfEdgeMesh& b, HalfEdgeMesh& result,
+    TaskPool& pool = TaskPool::Default());
+
+}
@@ -0,0 +1,68 @@
+#include "monotone_chain.h"
+
+#include <algorithm>
+
+#include "quickhull.h"
+
+using namespace std;
+
+namespace hullcore {
+
+namespace {
+
+// Sorting the points themselves instead of an index array keeps the
+// comparisons out of random memory on large inputs.
+struct IndexedPoint {
+    Point2 point;
+    size_t index;
+};
+
+}
+
+void CalculateMonotoneChain(const Point2* points, size_t count, vector<size_t>& hullIndices)
+{
+    hullIndices.clear();
+    if (count == 0) {
+        return;
+    }
+
+    vector<IndexedPoint> sorted(count);
+    for (size_t i = 0; i < count; i++) {
+        sorted[i] = { points[i], i };
+    }
+    std::sort(sorted.begin(), sorted.end(),
+        [](const IndexedPoint& a, const IndexedPoint& b) -> bool
+        {
+            return a.point.x < b.point.x || (a.point.x == b.point.x && a.point.y < b.point.y);
+        });
+
+    if (sorted.front().point == sorted.back().point) {
+        hullIndices.push_back(sorted.front().index);
+        return;
+    }
+
+    // Chain holds positions into sorted; lower hull first, then the upper hull
+    // reusing the same stack so its last point closes back onto sorted[0].
+    vector<size_t> chain(2 * count);
+    size_t k = 0;
+
+    for (size_t i = 0; i < count; i++) {
+        while (k >= 2 && signedLineDist(sorted[chain[k - 2]].point, sorted[chain[k - 1]].point, sorted[i].point) <= 0)
+            k--;
+        chain[k++] = i;
+    }
+
+    size_t lowerSize = k + 1;
+    for (size_t i = count - 1; i > 0; i--) {
+        while (k >= lowerSize && signedLineDist(sorted[chain[k - 2]].point, sorted[chain[k - 1]].point, sorted[i - 1].point) <= 0)
+            k--;
+        chain[k++] = i - 1;
+    }
+
+    hullIndices.reserve(k - 1);
+    for (size_t i = 0; i + 1 < k; i++) {
+        hullIndices.push_back(sorted[chain[i]].index);
+    }
+}
+
+}
@@ -0,0 +1,14 @@
+#pragma once
+
+#include <cstddef>
+#include <vector>
+
+#include "point.h"
+
+namespace hullcore {
+
+// Andrew's monotone chain: one lexicographic sort plus a linear pass. Same
+// output order as CalculateQuickHull.
+void CalculateMonotoneChain(const Point2* points, size_t count, std::vector<size_t>& hullIndices);
+
+}
@@ -0,0 +1,36 @@
+#pragma once
+
+#include <cstddef>
+
+namespace hullcore {
+
+// Same layout as D2D1_POINT_2F so the window app can hand its centers over
+// without any Win32 types leaking into the core.
+struct Point2 {
+    float x;
+    float y;
+};
+
+inline bool operator==(const Point2& a, const Point2& b) {
+    return a.x == b.x && a.y == b.y;
+}
+
+inline bool operator!=(const Point2& a, const Point2& b) {
+    return !(a == b);
+}
+
+struct Point3 {
+    float x;
+    float y;
+    float z;
+};
+
+inline bool operator==(const Point3& a, const Point3& b) {
+    return a.x == b.x && a.y == b.y && a.z == b.z;
+}
+
+inline bool operator!=(const Point3& a, const Point3& b) {
+    return !(a == b);
+}
+
+}
@@ -0,0 +1,52 @@
+#include "point_arena.h"
+
+#include <algorithm>
+
+using namespace std;
+
+namespace hullcore {
+
+namespace {
+
+const size_t minimumBlock = 1024;
+
+}
+
+void PointArena::addBlock(size_t capacity)
+{
+    blocks.push_back(Block{ unique_ptr<Point2[]>(new Point2[capacity]), capacity });
+    allocationCount++;
+    used = 0;
+}
+
+Point2* PointArena::Allocate(size_t count)
+{
+    if (blocks.empty() || blocks.back().capacity - used < count) {
+        size_t previous = blocks.empty() ? 0 : blocks.back().capacity;
+        addBlock(max({ count, 2 * previous, minimumBlock }));
+    }
+    Point2* result = blocks.back().points.get() + used;
+    used += count;
+    return result;
+}
+
+void PointArena::Reset()
+{
+    if (blocks.size() > 1) {
+        size_t total = Capacity();
+        blocks.clear();
+        addBlock(total);
+    }
+    used = 0;
+}
+
+size_t PointArena::Capacity() const
+{
+    size_t total = 0;
+    for (const Block& block : blocks) {
+        total += block.capacity;
+    }
+    return total;
+}
+
+}
@@ -0,0 +1,39 @@
+#pragma once
+
+#include <cstddef>
+#include <memory>
+#include <vector>
+
+#include "point.h"
+
+namespace hullcore {
+
+// Bump allocator for per-evaluation point buffers. Reset hands the same memory
+// out again, so once the arena has seen the largest frame it stops touching
+// the heap; AllocationCount lets callers assert exactly that.
+class PointArena {
+public:
+    // Returns storage for count points, valid until the next Reset.
+    Point2* Allocate(size_t count);
+
+    // Releases every allocation at once. If the last evaluation needed more
+    // than one block they are merged into one block big enough for all of it.
+    void Reset();
+
+    size_t AllocationCount() const { return allocationCount; }
+    size_t Capacity() const;
+
+private:
+    struct Block {
+        std::unique_ptr<Point2[]> points;
+        size_t capacity;
+    };
+
+    void addBlock(size_t capacity);
+
+    std::vector<Block> blocks;
+    size_t used = 0;
+    size_t allocationCount = 0;
+};
+
+}
@@ -0,0 +1,143 @@
+#include "point_grid.h"
+
+#include <algorithm>
+#include <cmath>
+
+using namespace std;
+
+namespace hullcore {
+
+namespace {
+
+// Cell coordinates stay well inside int32 so neighbouring cells never wrap.
+const float cellLimit = float(1 << 30);
+
+}
+
+PointGrid::PointGrid(float cellSize)
+    : cellSize(cellSize > 0 ? cellSize : 1.0f), inverseCellSize(1.0f / this->cellSize)
+{
+}
+
+int32_t PointGrid::cellCoordinate(float value) const
+{
+    float cell = floor(value * inverseCellSize);
+    if (isnan(cell)) {
+        return 0;
+    }
+    return int32_t(max(-cellLimit, min(cell, cellLimit)));
+}
+
+uint64_t PointGrid::cellOf(Point2 p) const
+{
+    return uint64_t(uint32_t(cellCoordinate(p.x))) << 32 | uint32_t(cellCoordinate(p.y));
+}
+
+void PointGrid::link(uint32_t id)
+{
+    Entry& entry = entries[id];
+    entry.cell = cellOf(entry.center);
+    vector<uint32_t>& ids = cells[entry.cell];
+    entry.slot = uint32_t(ids.size());
+    ids.push_back(id);
+}
+
+// Swaps the last id of the cell into the freed slot; empty cells are dropped
+// so the map does not fill up with cells points have been dragged through.
+void PointGrid::unlink(uint32_t id)
+{
+    const Entry& entry = entries[id];
+    auto cell = cells.find(entry.cell);
+    vector<uint32_t>& ids = cell->second;
+    uint32_t last = ids.back();
+    ids[entry.slot] = last;
+    entries[last].slot = entry.slot;
+    ids.pop_back();
+    if (ids.empty()) {
+        cells.erase(cell);
+    }
+}
+
+void PointGrid::Insert(uint32_t id, Point2 center, float radius)
+{
+    if (Contains(id)) {
+        unlink(id);
+        count--;
+    }
+    if (id >= entries.size()) {
+        entries.resize(size_t(id) + 1, Entry{ { 0, 0 }, 0, 0, 0, false });
+    }
+    entries[id] = { center, radius, 0, 0, true };
+    maxRadius = max(maxRadius, radius);
+    link(id);
+    count++;
+}
+
+void PointGrid::Move(uint32_t id, Point2 center)
+{
+    if (!Contains(id)) {
+        return;
+    }
+    Entry& entry = entries[id];
+    entry.center = center;
+    if (cellOf(center) != entry.cell) {
+        unlink(id);
+        link(id);
+    }
+}
+
+void PointGrid::Erase(uint32_t id)
+{
+    if (!Contains(id)) {
+        return;
+    }
+    unlink(id);
+    entries[id].live = false;
+    count--;
+}
+
+void PointGrid::Clear()
+{
+    entries.clear();
+    cells.clear();
+    maxRadius = 0;
+    count = 0;
+}
+
+uint32_t PointGrid::Pick(Point2 p) const
+{
+    uint32_t picked = None;
+    auto test = [&](const vector<uint32_t>& ids) {
+        for (uint32_t id : ids) {
+            const Entry& entry = entries[id];
+            float dx = p.x - entry.center.x;
+            float dy = p.y - entry.center.y;
+            if (dx * dx + dy * dy < entry.radius * entry.radius && (picked == None || id > picked)) {
+                picked = id;
+            }
+        }
+    };
+
+    // A circle can only hold p if its center lies within maxRadius of p.
+    int64_t minX = cellCoordinate(p.x - maxRadius);
+    int64_t maxX = cellCoordinate(p.x + maxRadius);
+    int64_t minY = cellCoordinate(p.y - maxRadius);
+    int64_t maxY = cellCoordinate(p.y + maxRadius);
+    if ((maxX - minX + 1) * (maxY - minY + 1) > int64_t(cells.size())) {
+        for (const auto& cell : cells) {
+            test(cell.second);
+        }
+        return picked;
+    }
+    for (int64_t x = minX; x <= maxX; x++) {
+        for (int64_t y = minY; y <= maxY; y++) {
+            auto cell = cells.find(uint64_t(uint32_t(int32_t(x))) << 32 | uint32_t(int32_t(y)));
+            if (cell != cells.end()) {
+                test(cell->second);
+            }
+        }
+    }
+    return picked;
+}
+
+}
@@ -0,0 +1,64 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <unordered_map>
+#include <vector>
+
+#include "point.h"
+
+namespace hullcore {
+
+// Uniform hash grid over small circles, for picking among many draggable
+// points. Each circle is filed under the cell holding its center, and a pick
+// looks only at the cells within the largest radius inserted so far, so with
+// cells a few radii wide both picking and moving cost O(1) expected. Densely
+// clustered circles share cells and cost proportionally more.
+class PointGrid {
+public:
+    static const uint32_t None = UINT32_MAX;
+
+    explicit PointGrid(float cellSize = 64.0f);
+
+    // Ids are chosen by the caller and index a table, so keep them dense.
+    void Insert(uint32_t id, Point2 center, float radius);
+    void Move(uint32_t id, Point2 center);
+    void Erase(uint32_t id);
+    void Clear();
+
+    bool Contains(uint32_t id) const { return id < entries.size() && entries[id].live; }
+    size_t Size() const { return count; }
+
+    // Largest id whose circle has p strictly inside, or None. With ids given
+    // in draw order this is the circle drawn on top.
+    uint32_t Pick(Point2 p) const;
+
+private:
+    struct Entry {
+        Point2 center;
+        float radius;
+        uint64_t cell;
+        // Position within the cell's id list, for constant-time removal.
+        uint32_t slot;
+        bool live;
+    };
+
+    struct CellHash {
+        size_t operator()(uint64_t key) const { return size_t((key * 0x9E3779B97F4A7C15ull) >> 16); }
+    };
+
+    int32_t cellCoordinate(float value) const;
+    uint64_t cellOf(Point2 p) const;
+    void link(uint32_t id);
+    void unlink(uint32_t id);
+
+    float cellSize;
+    float inverseCellSize;
+    // Only grows, as shrinking it would need every radius rescanned.
+    float maxRadius = 0;
+    size_t count = 0;
+    std::vector<Entry> entries;
+    std::unordered_map<uint64_t, std::vector<uint32_t>, CellHash> cells;
+};
+
+}
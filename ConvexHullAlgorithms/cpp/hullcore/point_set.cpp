@@ -0,0 +1,338 @@
+#include "point_set.h"
+
+#include <algorithm>
+#include <charconv>
+#include <cstdio>
+#include <cstring>
+
+#include "quickhull.h"
+#include "task_pool.h"
+
+using namespace std;
+
+namespace hullcore {
+
+namespace {
+
+const char pointSetMagic[8] = { 'H', 'U', 'L', 'L', 'P', 'T', 'S', '\0' };
+const size_t pointSetAlignment = 64;
+
+// Bytes of text parsed per task by the importer.
+const size_t csvBlockBytes = size_t(1) << 22;
+
+uint64_t alignUp(uint64_t value)
+{
+    return (value + pointSetAlignment - 1) / pointSetAlignment * pointSetAlignment;
+}
+
+PointSetHeader makeHeader(size_t count)
+{
+    PointSetHeader header = {};
+    memcpy(header.magic, pointSetMagic, sizeof(pointSetMagic));
+    header.version = pointSetVersion;
+    header.coordinateType = POINT_SET_FLOAT32;
+    header.count = count;
+    header.yOffset = alignUp(sizeof(PointSetHeader) + uint64_t(count) * sizeof(float));
+    return header;
+}
+
+void includeInBounds(PointSetHeader& header, const float* x, const float* y, size_t count, bool first)
+{
+    for (size_t i = 0; i < count; i++) {
+        if (first && i == 0) {
+            header.minX = header.maxX = x[0];
+            header.minY = header.maxY = y[0];
+        }
+        header.minX = min(header.minX, x[i]);
+        header.minY = min(header.minY, y[i]);
+        header.maxX = max(header.maxX, x[i]);
+        header.maxY = max(header.maxY, y[i]);
+    }
+}
+
+bool writePadding(FILE* file, uint64_t written)
+{
+    static const char zeros[pointSetAlignment] = {};
+    size_t padding = size_t(alignUp(written) - written);
+    return fwrite(zeros, 1, padding, file) == padding;
+}
+
+// Part of a point set, one per block of parsed text; files are written as the
+// concatenation of all blocks in order.
+struct CoordinateBlock {
+    vector<float> x;
+    vector<float> y;
+};
+
+bool writeBlocks(const char* path, const vector<CoordinateBlock>& blocks)
+{
+    size_t count = 0;
+    PointSetHeader bounds = {};
+    for (const CoordinateBlock& block : blocks) {
+        includeInBounds(bounds, block.x.data(), block.y.data(), block.x.size(), count == 0);
+        count += block.x.size();
+    }
+
+    PointSetHeader header = makeHeader(count);
+    header.minX = bounds.minX;
+    header.minY = bounds.minY;
+    header.maxX = bounds.maxX;
+    header.maxY = bounds.maxY;
+
+    FILE* file = fopen(path, "wb");
+    if (!file) {
+        return false;
+    }
+    bool ok = fwrite(&header, sizeof(header), 1, file) == 1;
+    for (const CoordinateBlock& block : blocks) {
+        ok = ok && fwrite(block.x.data(), sizeof(float), block.x.size(), file) == block.x.size();
+    }
+    ok = ok && writePadding(file, sizeof(header) + uint64_t(count) * sizeof(float));
+    for (const CoordinateBlock& block : blocks) {
+        ok = ok && fwrite(block.y.data(), sizeof(float), block.y.size(), file) == block.y.size();
+    }
+    ok = fclose(file) == 0 && ok;
+    return ok;
+}
+
+bool fail(string* error, const char* message)
+{
+    if (error)
+        *error = message;
+    return false;
+}
+
+bool isSpace(char c)
+{
+    return c == ' ' || c == '\r';
+}
+
+bool isDelimiter(char c)
+{
+    return c == ',' || c == ';' || c == '\t';
+}
+
+bool parseNumber(const char* begin, const char* end, float& value)
+{
+    if (begin != end && *begin == '+')
+        begin++;
+    if (begin == end)
+        return false;
+    from_chars_result result = from_chars(begin, end, value);
+    return result.ec == errc() && result.ptr == end;
+}
+
+// Pulls x and y out of one line. Commas, semicolons and tabs separate fields
+// one to one (so empty fields count); runs of spaces separate them as well.
+bool parseLine(const char* begin, const char* end, const CsvImportOptions& options, float& x, float& y)
+{
+    size_t lastColumn = max(options.xColumn, options.yColumn);
+    bool haveX = false;
+    bool haveY = false;
+    const char* cursor = begin;
+    for (size_t column = 0; column <= lastColumn; column++) {
+        while (cursor != end && isSpace(*cursor))
+            cursor++;
+        const char* fieldBegin = cursor;
+        while (cursor != end && !isSpace(*cursor) && !isDelimiter(*cursor))
+            cursor++;
+        const char* fieldEnd = cursor;
+
+        if (column == options.xColumn)
+            haveX = parseNumber(fieldBegin, fieldEnd, x);
+        if (column == options.yColumn)
+            haveY = parseNumber(fieldBegin, fieldEnd, y);
+
+        while (cursor != end && isSpace(*cursor))
+            cursor++;
+        if (cursor != end && isDelimiter(*cursor))
+            cursor++;
+        else if (cursor == end && column < lastColumn)
+            return false;
+    }
+    return haveX && haveY;
+}
+
+struct ParsedBlock {
+    CoordinateBlock coordinates;
+    uint64_t lineCount = 0;
+    uint64_t skippedCount = 0;
+};
+
+void parseBlock(const char* begin, const char* end, const CsvImportOptions& options, ParsedBlock& block)
+{
+    const char* line = begin;
+    while (line != end) {
+        const char* lineEnd = static_cast<const char*>(memchr(line, '\n', size_t(end - line)));
+        if (!lineEnd)
+            lineEnd = end;
+
+        const char* content = line;
+        while (content != lineEnd && (isSpace(*content) || *content == '\t'))
+            content++;
+        if (content != lineEnd) {
+            block.lineCount++;
+            float x, y;
+            if (parseLine(line, lineEnd, options, x, y)) {
+                block.coordinates.x.push_back(x);
+                block.coordinates.y.push_back(y);
+            }
+            else {
+                block.skippedCount++;
+            }
+        }
+        line = lineEnd == end ? end : lineEnd + 1;
+    }
+}
+
+bool parseCsvFile(const char* csvPath, const CsvImportOptions& options, TaskPool& pool,
+    vector<CoordinateBlock>& coordinates, CsvImportStats* stats)
+{
+    MappedFile csv;
+    if (!csv.Open(csvPath) || csv.Size() > SIZE_MAX) {
+        return false;
+    }
+
+    size_t size = size_t(csv.Size());
+    const char* text = size > 0 ? static_cast<const char*>(csv.MapView(0, size)) : "";
+    if (!text) {
+        return false;
+    }
+
+    // Every block but the first starts just after a line break, so no line is
+    // split between two tasks.
+    vector<size_t> starts = { 0 };
+    for (size_t nominal = csvBlockBytes; nominal < size; nominal += csvBlockBytes) {
+        const char* lineBreak = static_cast<const char*>(memchr(text + nominal, '\n', size - nominal));
+        if (!lineBreak)
+            break;
+        size_t start = size_t(lineBreak - text) + 1;
+        if (start > starts.back() && start < size)
+            starts.push_back(start);
+    }
+    starts.push_back(size);
+
+    vector<ParsedBlock> blocks(starts.size() - 1);
+    pool.ParallelFor(0, blocks.size(), 1, [&](size_t first, size_t last) {
+        for (size_t b = first; b < last; b++) {
+            parseBlock(text + starts[b], text + starts[b + 1], options, blocks[b]);
+        }
+    });
+
+    coordinates.resize(blocks.size());
+    CsvImportStats total;
+    for (size_t b = 0; b < blocks.size(); b++) {
+        total.lineCount += blocks[b].lineCount;
+        total.skippedCount += blocks[b].skippedCount;
+        total.pointCount += blocks[b].coordinates.x.size();
+        coordinates[b] = std::move(blocks[b].coordinates);
+    }
+    if (stats) {
+        *stats = total;
+    }
+    return true;
+}
+
+}
+
+bool IsPointSetFile(const char* path)
+{
+    FILE* file = fopen(path, "rb");
+    if (!file) {
+        return false;
+    }
+    char magic[sizeof(pointSetMagic)];
+    bool match = fread(magic, 1, sizeof(magic), file) == sizeof(magic) && memcmp(magic, pointSetMagic, sizeof(magic)) == 0;
+    fclose(file);
+    return match;
+}
+
+bool WritePointSet(const char* path, const float* x, const float* y, size_t count)
+{
+    vector<CoordinateBlock> blocks(1);
+    blocks[0].x.assign(x, x + count);
+    blocks[0].y.assign(y, y + count);
+    return writeBlocks(path, blocks);
+}
+
+bool WritePointSet(const char* path, const Point2* points, size_t count)
+{
+    vector<CoordinateBlock> blocks(1);
+    blocks[0].x.resize(count);
+    blocks[0].y.resize(count);
+    for (size_t i = 0; i < count; i++) {
+        blocks[0].x[i] = points[i].x;
+        blocks[0].y[i] = points[i].y;
+    }
+    return writeBlocks(path, blocks);
+}
+
+bool PointSetFile::Open(const char* path, string* error)
+{
+    Close();
+    if (!file.Open(path))
+        return fail(error, "cannot open file");
+    if (file.Size() < sizeof(PointSetHeader) || file.Size() > SIZE_MAX)
+        return fail(error, "not a point set file");
+
+    const char* base = static_cast<const char*>(file.MapView(0, size_t(file.Size())));
+    if (!base)
+        return fail(error, "cannot map file");
+
+    PointSetHeader candidate;
+    memcpy(&candidate, base, sizeof(candidate));
+    if (memcmp(candidate.magic, pointSetMagic, sizeof(pointSetMagic)) != 0)
+        return fail(error, "not a point set file");
+    if (candidate.version != pointSetVersion)
+        return fail(error, "unsupported point set version");
+    if (candidate.coordinateType != POINT_SET_FLOAT32)
+        return fail(error, "unsupported coordinate type");
+
+    uint64_t arrayBytes = candidate.count * sizeof(float);
+    if (candidate.count > file.Size() / sizeof(float) || candidate.yOffset % pointSetAlignment != 0 ||
+        candidate.yOffset < sizeof(PointSetHeader) + arrayBytes || candidate.yOffset > file.Size() - arrayBytes)
+        return fail(error, "truncated or corrupt point set");
+
+    header = candidate;
+    x = reinterpret_cast<const float*>(base + sizeof(PointSetHeader));
+    y = reinterpret_cast<const float*>(base + header.yOffset);
+    return true;
+}
+
+void PointSetFile::Close()
+{
+    file.Close();
+    header = {};
+    x = nullptr;
+    y = nullptr;
+}
+
+void PointSetFile::CalculateHull(vector<size_t>& hullIndices) const
+{
+    CalculateSimdQuickHull(x, y, Count(), hullIndices);
+}
+
+bool ImportCsv(const char* csvPath, const char* pointSetPath, const CsvImportOptions& options, TaskPool& pool,
+    CsvImportStats* stats)
+{
+    vector<CoordinateBlock> coordinates;
+    return parseCsvFile(csvPath, options, pool, coordinates, stats) && writeBlocks(pointSetPath, coordinates);
+}
+
+bool ReadCsv(const char* csvPath, const CsvImportOptions& options, TaskPool& pool, vector<Point2>& points,
+    CsvImportStats* stats)
+{
+    vector<CoordinateBlock> coordinates;
+    if (!parseCsvFile(csvPath, options, pool, coordinates, stats)) {
+        return false;
+    }
+    points.clear();
+    for (const CoordinateBlock& block : coordinates) {
+        for (size_t i = 0; i < block.x.size(); i++) {
+            points.push_back({ block.x[i], block.y[i] });
+        }
+    }
+    return true;
+}
+
+}
@@ -0,0 +1,93 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <vector>
+
+#include "broad_phase.h"
+#include "mapped_file.h"
+#include "point.h"
+
+namespace hullcore {
+
+class TaskPool;
+
+// Point set file, version 1, native little-endian:
+//   PointSetHeader, 64 bytes
+//   x[count], then zero padding up to the next multiple of 64 bytes
+//   y[count]
+// Both coordinate arrays start 64-byte aligned in the file, and so in any
+// mapping of it, so vector kernels can read them in place.
+enum PointSetCoordinate : uint32_t { POINT_SET_FLOAT32 = 1 };
+
+const uint32_t pointSetVersion = 1;
+
+struct PointSetHeader {
+    char magic[8];
+    uint32_t version;
+    uint32_t coordinateType;
+    uint64_t count;
+    uint64_t yOffset;
+    float minX;
+    float minY;
+    float maxX;
+    float maxY;
+    uint8_t reserved[16];
+};
+
+static_assert(sizeof(PointSetHeader) == 64, "point set header must stay 64 bytes");
+
+// True when the file starts with the point set magic, whatever its version.
+bool IsPointSetFile(const char* path);
+
+bool WritePointSet(const char* path, const float* x, const float* y, size_t count);
+bool WritePointSet(const char* path, const Point2* points, size_t count);
+
+// Zero-copy reader: the file is mapped whole and X/Y point into the mapping.
+class PointSetFile {
+public:
+    // On failure returns false and, if error is given, says why.
+    bool Open(const char* path, std::string* error = nullptr);
+    void Close();
+
+    size_t Count() const { return size_t(header.count); }
+    const float* X() const { return x; }
+    const float* Y() const { return y; }
+    Aabb Bounds() const { return { header.minX, header.minY, header.maxX, header.maxY }; }
+    const PointSetHeader& Header() const { return header; }
+
+    // Hull straight from the mapped arrays, see CalculateSimdQuickHull.
+    void CalculateHull(std::vector<size_t>& hullIndices) const;
+
+private:
+    MappedFile file;
+    PointSetHeader header = {};
+    const float* x = nullptr;
+    const float* y = nullptr;
+};
+
+struct CsvImportOptions {
+    // Zero-based columns holding x and y. Fields may be separated by commas,
+    // semicolons, tabs or spaces.
+    size_t xColumn = 0;
+    size_t yColumn = 1;
+};
+
+struct CsvImportStats {
+    uint64_t lineCount = 0;
+    uint64_t pointCount = 0;
+    // Lines without two numbers in the chosen columns, headers included.
+    uint64_t skippedCount = 0;
+};
+
+// Converts a text export into a point set file. The input is mapped and cut
+// into blocks at line breaks that are parsed in parallel on pool.
+bool ImportCsv(const char* csvPath, const char* pointSetPath, const CsvImportOptions& options, TaskPool& pool,
+    CsvImportStats* stats = nullptr);
+
+// Same parse, with the points kept in memory instead of written out.
+bool ReadCsv(const char* csvPath, const CsvImportOptions& options, TaskPool& pool, std::vector<Point2>& points,
+    CsvImportStats* stats = nullptr);
+
+}
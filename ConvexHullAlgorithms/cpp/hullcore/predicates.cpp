@@ -0,0 +1,176 @@
+#include "predicates.h"
+
+#include <cstddef>
+
+using namespace std;
+
+namespace hullcore {
+
+namespace {
+
+// Knuth's two-sum: sum + error == a + b exactly.
+void twoSum(double a, double b, double& sum, double& error)
+{
+    sum = a + b;
+    double bVirtual = sum - a;
+    double aVirtual = sum - bVirtual;
+    error = (a - aVirtual) + (b - bVirtual);
+}
+
+// Most terms any caller sums: Orient3dExact multiplied out.
+const size_t maxTerms = 48;
+
+// Sums exact terms into a nonoverlapping expansion (Shewchuk's
+// grow-expansion with zero elimination) and returns its largest component,
+// which carries the sign of the whole sum. At most maxTerms terms.
+double sumExactly(const double* terms, size_t count)
+{
+    double expansion[maxTerms];
+    size_t length = 0;
+    for (size_t t = 0; t < count; t++) {
+        double carry = terms[t];
+        size_t kept = 0;
+        for (size_t i = 0; i < length; i++) {
+            double error;
+            twoSum(carry, expansion[i], carry, error);
+            if (error != 0)
+                expansion[kept++] = error;
+        }
+        if (carry != 0)
+            expansion[kept++] = carry;
+        length = kept;
+    }
+    return length > 0 ? expansion[length - 1] : 0.0;
+}
+
+// Veltkamp's split of a into two halves of at most 26 bits each.
+void split(double a, double& high, double& low)
+{
+    const double splitter = 134217729.0; // 2^27 + 1
+    double c = splitter * a;
+    double big = c - a;
+    high = c - big;
+    low = a - high;
+}
+
+// Dekker's two-product: product + error == a * b exactly, as long as nothing
+// overflows or underflows, which coordinate differences of floats cannot do.
+void twoProduct(double a, double b, double& product, double& error)
+{
+    product = a * b;
+    double aHigh, aLow, bHigh, bLow;
+    split(a, aHigh, aLow);
+    split(b, bHigh, bLow);
+    double error1 = product - aHigh * bHigh;
+    double error2 = error1 - aLow * bHigh;
+    double error3 = error2 - aHigh * bLow;
+    error = aLow * bLow - error3;
+}
+
+// b - a, or false if the difference of the two floats did not fit a double.
+bool differenceExact(float b, float a, double& difference)
+{
+    double error;
+    twoSum(b, -double(a), difference, error);
+    return error == 0;
+}
+
+// ux * vy - uy * vx for exact differences. Cheaper than multiplying out the
+// coordinates, and the common case in practice: the first stage failed
+// because both products are large and (nearly) equal, as they are for
+// collinear points or parallel edges.
+double determinantExactly(double ux, double uy, double vx, double vy)
+{
+    double left, leftError, right, rightError;
+    twoProduct(ux, vy, left, leftError);
+    twoProduct(uy, vx, right, rightError);
+    if (leftError == 0 && rightError == 0)
+        return left - right;
+    double terms[4] = { leftError, -rightError, left, -right };
+    return sumExactly(terms, 4);
+}
+
+// Appends a * b * c as four exact terms.
+void appendProduct(double a, double b, double c, double* terms, size_t& count)
+{
+    double product, error;
+    twoProduct(a, b, product, error);
+    twoProduct(product, c, terms[count], terms[count + 1]);
+    twoProduct(error, c, terms[count + 2], terms[count + 3]);
+    count += 4;
+}
+
+// Appends sign * det(p, q, r), p . (q x r), as twelve exact terms: the
+// product of two floats is exact in double, so only the third factor needs
+// splitting.
+void appendDeterminant(double sign, Point3 p, Point3 q, Point3 r, double* terms, size_t& count)
+{
+    const float factors[6][3] = {
+        { p.x, q.y, r.z }, { p.x, -q.z, r.y }, { p.y, q.z, r.x },
+        { p.y, -q.x, r.z }, { p.z, q.x, r.y }, { p.z, -q.y, r.x },
+    };
+    for (const float* f : factors) {
+        twoProduct(sign * f[0] * f[1], f[2], terms[count], terms[count + 1]);
+        count += 2;
+    }
+}
+
+}
+
+double Orient2dExact(Point2 a, Point2 b, Point2 c)
+{
+    double abx, aby, acx, acy;
+    if (differenceExact(b.x, a.x, abx) && differenceExact(b.y, a.y, aby) && differenceExact(c.x, a.x, acx) &&
+        differenceExact(c.y, a.y, acy))
+        return determinantExactly(abx, aby, acx, acy);
+
+    // (cy - ay)(bx - ax) - (by - ay)(cx - ax), multiplied out; the ax * ay
+    // terms cancel.
+    double terms[6] = {
+        double(c.y) * b.x, -double(c.y) * a.x, -double(a.y) * b.x,
+        -double(b.y) * c.x, double(b.y) * a.x, double(a.y) * c.x,
+    };
+    return sumExactly(terms, 6);
+}
+
+double CrossEdgesExact(Point2 a0, Point2 a1, Point2 b0, Point2 b1)
+{
+    double ax, ay, bx, by;
+    if (differenceExact(a1.x, a0.x, ax) && differenceExact(a1.y, a0.y, ay) && differenceExact(b1.x, b0.x, bx) &&
+        differenceExact(b1.y, b0.y, by))
+        return determinantExactly(ax, ay, bx, by);
+
+    double terms[8] = {
+        double(a1.x) * b1.y, -double(a1.x) * b0.y, -double(a0.x) * b1.y, double(a0.x) * b0.y,
+        -double(a1.y) * b1.x, double(a1.y) * b0.x, double(a0.y) * b1.x, -double(a0.y) * b0.x,
+    };
+    return sumExactly(terms, 8);
+}
+
+double Orient3dExact(Point3 a, Point3 b, Point3 c, Point3 d)
+{
+    double terms[maxTerms];
+    size_t count = 0;
+    double u[3], v[3], w[3];
+    if (differenceExact(b.x, a.x, u[0]) && differenceExact(b.y, a.y, u[1]) && differenceExact(b.z, a.z, u[2]) &&
+        differenceExact(c.x, a.x, v[0]) && differenceExact(c.y, a.y, v[1]) && differenceExact(c.z, a.z, v[2]) &&
+        differenceExact(d.x, a.x, w[0]) && differenceExact(d.y, a.y, w[1]) && differenceExact(d.z, a.z, w[2])) {
+        for (int i = 0; i < 3; i++) {
+            int j = (i + 1) % 3;
+            int k = (i + 2) % 3;
+            appendProduct(w[i], u[j], v[k], terms, count);
+            appendProduct(-w[i], u[k], v[j], terms, count);
+        }
+        return sumExactly(terms, count);
+    }
+
+    // det(b - a, c - a, d - a) by multilinearity; every term with a in two
+    // columns vanishes.
+    appendDeterminant(1.0, b, c, d, terms, count);
+    appendDeterminant(-1.0, a, c, d, terms, count);
+    appendDeterminant(-1.0, b, a, d, terms, count);
+    appendDeterminant(-1.0, b, c, a, terms, count);
+    return sumExactly(terms, count);
+}
+
+}
@@ -0,0 +1,157 @@
+#pragma once
+
+#include <cmath>
+
+#include "point.h"
+
+namespace hullcore {
+
+// Relative error bound of the double evaluation of a 2x2 determinant of
+// coordinate differences, (3 + 16e)e with e = 2^-53 (Shewchuk's ccwerrboundA).
+const double orientErrorBound = (3.0 + 16.0 * 1.1102230246251565e-16) * 1.1102230246251565e-16;
+
+// Exact signs for the cases the filter cannot settle. When the coordinate
+// differences are exact in double, which for floats they nearly always are,
+// the two products are split exactly into value and error; otherwise every
+// product of two float coordinates is exact in double, so the determinant is
+// multiplied out into such products. Either way the terms are summed without
+// rounding, and the result has the exact sign and about the exact value.
+double Orient2dExact(Point2 a, Point2 b, Point2 c);
+double CrossEdgesExact(Point2 a0, Point2 a1, Point2 b0, Point2 b1);
+double Orient3dExact(Point3 a, Point3 b, Point3 c, Point3 d);
+
+// Relative error bound of the double evaluation of a 3x3 determinant of
+// coordinate differences, (7 + 56e)e (Shewchuk's o3derrboundA).
+const double orient3dErrorBound = (7.0 + 56.0 * 1.1102230246251565e-16) * 1.1102230246251565e-16;
+
+// True when left - right, evaluated in double, is known to have the sign of
+// the exact determinant. Shewchuk returns early when left and right differ in
+// sign; the bound is then met anyway, and one well predicted comparison is
+// cheaper than branching on signs that are random in a partition.
+inline bool determinantCertain(double left, double right, double determinant)
+{
+    return std::fabs(determinant) >= orientErrorBound * (std::fabs(left) + std::fabs(right));
+}
+
+// Twice the signed area of (a, b, c); positive when c is left of a -> b. The
+// usual double evaluation is returned whenever its sign is certain, which is
+// nearly always, and the exact sum otherwise, so the sign is never wrong.
+inline double Orient2d(Point2 a, Point2 b, Point2 c)
+{
+    double left = (double(c.y) - a.y) * (double(b.x) - a.x);
+    double right = (double(b.y) - a.y) * (double(c.x) - a.x);
+    double determinant = left - right;
+    if (determinantCertain(left, right, determinant))
+        return determinant;
+    return Orient2dExact(a, b, c);
+}
+
+// (a1 - a0) x (b1 - b0); positive when edge b turns left of edge a.
+inline double CrossEdges(Point2 a0, Point2 a1, Point2 b0, Point2 b1)
+{
+    double left = (double(a1.x) - a0.x) * (double(b1.y) - b0.y);
+    double right = (double(a1.y) - a0.y) * (double(b1.x) - b0.x);
+    double determinant = left - right;
+    if (determinantCertain(left, right, determinant))
+        return determinant;
+    return CrossEdgesExact(a0, a1, b0, b1);
+}
+
+// (a1 - a0) . (b1 - b0) with the exact sign: the cross product of edge a
+// turned a quarter clockwise with edge b, so CrossEdges' filter applies.
+inline double DotEdges(Point2 a0, Point2 a1, Point2 b0, Point2 b1)
+{
+    return CrossEdges({ a0.y, -a0.x }, { a1.y, -a1.x }, b0, b1);
+}
+
+// Six times the signed volume of (a, b, c, d), (b - a) . ((c - a) x (d - a));
+// positive when d is on the side (b - a) x (c - a) points to, that is when
+// a, b, c run counter-clockwise seen from d. Filtered like Orient2d.
+inline double Orient3d(Point3 a, Point3 b, Point3 c, Point3 d)
+{
+    double ux = double(b.x) - a.x, uy = double(b.y) - a.y, uz = double(b.z) - a.z;
+    double vx = double(c.x) - a.x, vy = double(c.y) - a.y, vz = double(c.z) - a.z;
+    double wx = double(d.x) - a.x, wy = double(d.y) - a.y, wz = double(d.z) - a.z;
+    double determinant = wx * (uy * vz - uz * vy) + wy * (uz * vx - ux * vz) + wz * (ux * vy - uy * vx);
+    double permanent = std::fabs(wx) * (std::fabs(uy * vz) + std::fabs(uz * vy)) +
+        std::fabs(wy) * (std::fabs(uz * vx) + std::fabs(ux * vz)) +
+        std::fabs(wz) * (std::fabs(ux * vy) + std::fabs(uy * vx));
+    if (std::fabs(determinant) >= orient3dErrorBound * permanent)
+        return determinant;
+    return Orient3dExact(a, b, c, d);
+}
+
+// Orient2d(a, b, c) for many points c against one line, all of them inside
+// the box [low, high]. Rounding is monotone, so no such c has a larger
+// computed |left| + |right| than the corners farthest from a give, and one
+// static bound stands in for the per-point filter: the common case is the
+// raw determinant and a single comparison.
+class LineOrientation {
+public:
+    LineOrientation(Point2 a, Point2 b, Point2 low, Point2 high)
+        : a(a), b(b), dx(double(b.x) - a.x), dy(double(b.y) - a.y)
+    {
+        double extentX = std::fmax(std::fabs(double(low.x) - a.x), std::fabs(double(high.x) - a.x));
+        double extentY = std::fmax(std::fabs(double(low.y) - a.y), std::fabs(double(high.y) - a.y));
+        bound = orientErrorBound * (extentY * std::fabs(dx) + std::fabs(dy) * extentX);
+    }
+
+    double operator()(Point2 c) const
+    {
+        double determinant = (double(c.y) - a.y) * dx - dy * (double(c.x) - a.x);
+        if (std::fabs(determinant) >= bound)
+            return determinant;
+        return Orient2dExact(a, b, c);
+    }
+
+    // Bounds how far the plain double determinant of any point in the box
+    // can be from the exact one.
+    double ErrorBound() const { return bound; }
+
+private:
+    Point2 a;
+    Point2 b;
+    double dx;
+    double dy;
+    double bound;
+};
+
+// Orient3d(a, b, c, d) for many points d against one plane, all of them
+// inside the box [low, high], with the normal computed once; the static
+// bound works as in LineOrientation.
+class PlaneOrientation {
+public:
+    PlaneOrientation(Point3 a, Point3 b, Point3 c, Point3 low, Point3 high)
+        : a(a), b(b), c(c)
+    {
+        double ux = double(b.x) - a.x, uy = double(b.y) - a.y, uz = double(b.z) - a.z;
+        double vx = double(c.x) - a.x, vy = double(c.y) - a.y, vz = double(c.z) - a.z;
+        nx = uy * vz - uz * vy;
+        ny = uz * vx - ux * vz;
+        nz = ux * vy - uy * vx;
+        double extentX = std::fmax(std::fabs(double(low.x) - a.x), std::fabs(double(high.x) - a.x));
+        double extentY = std::fmax(std::fabs(double(low.y) - a.y), std::fabs(double(high.y) - a.y));
+        double extentZ = std::fmax(std::fabs(double(low.z) - a.z), std::fabs(double(high.z) - a.z));
+        bound = orient3dErrorBound * (extentX * (std::fabs(uy * vz) + std::fabs(uz * vy)) +
+            extentY * (std::fabs(uz * vx) + std::fabs(ux * vz)) + extentZ * (std::fabs(ux * vy) + std::fabs(uy * vx)));
+    }
+
+    double operator()(Point3 d) const
+    {
+        double determinant = (double(d.x) - a.x) * nx + (double(d.y) - a.y) * ny + (double(d.z) - a.z) * nz;
+        if (std::fabs(determinant) >= bound)
+            return determinant;
+        return Orient3dExact(a, b, c, d);
+    }
+
+private:
+    Point3 a;
+    Point3 b;
+    Point3 c;
+    double nx;
+    double ny;
+    double nz;
+    double bound;
+};
+
+}
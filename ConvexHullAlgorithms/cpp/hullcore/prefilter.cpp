@@ -0,0 +1,99 @@
+#include "prefilter.h"
+
+#include <algorithm>
+
+#include "task_pool.h"
+
+using namespace std;
+
+namespace hullcore {
+
+namespace {
+
+// Points per task for the extreme point scan and the octagon test.
+const size_t filterGrain = 1 << 18;
+
+// The extent FindExtremes maximizes in direction d, evaluated the same way.
+float extent(const Point2& point, int d)
+{
+    switch (d) {
+    case 0: return -point.y;
+    case 1: return point.x - point.y;
+    case 2: return point.x;
+    case 3: return point.x + point.y;
+    case 4: return point.y;
+    case 5: return -(point.x - point.y);
+    case 6: return -point.x;
+    default: return -(point.x + point.y);
+    }
+}
+
+void findExtremes(const Point2* points, size_t count, TaskPool& pool, SimdLevel level, size_t extremes[8])
+{
+    if (count < 2 * filterGrain) {
+        FindExtremes(points, count, extremes, level);
+        return;
+    }
+
+    struct Chunk {
+        size_t positions[8];
+    };
+    vector<Chunk> chunks((count + filterGrain - 1) / filterGrain);
+    pool.ParallelFor(0, count, filterGrain, [&](size_t chunkBegin, size_t chunkEnd) {
+        Chunk& chunk = chunks[chunkBegin / filterGrain];
+        FindExtremes(points + chunkBegin, chunkEnd - chunkBegin, chunk.positions, level);
+        for (size_t& position : chunk.positions) {
+            position += chunkBegin;
+        }
+    });
+
+    // Earlier chunks win ties, as in a single scan.
+    copy(begin(chunks[0].positions), end(chunks[0].positions), extremes);
+    for (const Chunk& chunk : chunks) {
+        for (int d = 0; d < 8; d++) {
+            if (extent(points[chunk.positions[d]], d) > extent(points[extremes[d]], d))
+                extremes[d] = chunk.positions[d];
+        }
+    }
+}
+
+}
+
+void AklToussaintFilter(const Point2* points, size_t count, vector<size_t>& survivors, TaskPool& pool, SimdLevel level)
+{
+    survivors.clear();
+    if (count == 0) {
+        return;
+    }
+
+    size_t extremes[8];
+    findExtremes(points, count, pool, level, extremes);
+
+    Point2 octagon[8];
+    size_t vertexCount = 0;
+    for (size_t position : extremes) {
+        const Point2& point = points[position];
+        if (vertexCount == 0 || (point != octagon[vertexCount - 1] && point != octagon[0]))
+            octagon[vertexCount++] = point;
+    }
+
+    if (vertexCount < 3) {
+        survivors.resize(count);
+        for (size_t i = 0; i < count; i++) {
+            survivors[i] = i;
+        }
+        return;
+    }
+
+    vector<uint8_t> labels(count);
+    pool.ParallelFor(0, count, filterGrain, [&](size_t chunkBegin, size_t chunkEnd) {
+        ClassifyPolygon(octagon, vertexCount, points + chunkBegin, chunkEnd - chunkBegin, labels.data() + chunkBegin, level);
+    });
+
+    for (size_t i = 0; i < count; i++) {
+        if (labels[i] != POLYGON_INSIDE)
+            survivors.push_back(i);
+    }
+}
+
+}
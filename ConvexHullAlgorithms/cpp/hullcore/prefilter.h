@@ -0,0 +1,20 @@
+#pragma once
+
+#include <cstddef>
+#include <vector>
+
+#include "point.h"
+#include "simd_kernels.h"
+
+namespace hullcore {
+
+class TaskPool;
+
+// Akl-Toussaint interior point filter. The points extreme along the axis and
+// diagonal directions span an octagon inside the hull, and nothing strictly
+// inside it can be a hull vertex. Writes the ascending indices of every other
+// point into survivors; all hull vertices are among them.
+void AklToussaintFilter(const Point2* points, size_t count, std::vector<size_t>& survivors, TaskPool& pool,
+    SimdLevel level = DetectSimdLevel());
+
+}
@@ -0,0 +1,368 @@
+#include "quickhull.h"
+
+#include <algorithm>
+
+#include "task_pool.h"
+
+using namespace std;
+
+namespace hullcore {
+
+int findSide(const Point2& p1, const Point2& p2, const Point2& pTest)
+{
+    double d = signedLineDist(p1, p2, pTest);
+
+    if (d > 0)
+        return 1;
+    if (d < 0)
+        return -1;
+    return 0;
+}
+
+namespace {
+
+// Candidate sets at least this large are scanned in chunks across the pool and
+// have their two sub-problems forked.
+const size_t parallelGrain = 1 << 16;
+
+struct QuickHullState {
+    const Point2* points;
+    TaskPool* pool;
+    // Bounding box of all points, for the static filter of LineOrientation.
+    Point2 low = {};
+    Point2 high = {};
+};
+
+struct Farthest {
+    size_t index;
+    double distance;
+    double progress;
+    // Largest rounded distance among the other candidates scanned, or 0.
+    double runnerUp;
+};
+
+bool lexicographicLess(const Point2& a, const Point2& b)
+{
+    return a.x < b.x || (a.x == b.x && a.y < b.y);
+}
+
+// Ties are broken towards p1 so that of several points on a line parallel to
+// p1 -> p2 only the two ends become hull vertices.
+bool isFarther(const Farthest& a, const Farthest& b)
+{
+    return a.distance > b.distance || (a.distance == b.distance && a.distance > 0 && a.progress < b.progress);
+}
+
+// Keeps best the better of the two and folds the other into its runner-up.
+void mergeFarthest(Farthest& best, const Farthest& other)
+{
+    if (isFarther(other, best)) {
+        double runnerUp = max(other.runnerUp, best.distance);
+        best = other;
+        best.runnerUp = runnerUp;
+    }
+    else {
+        best.runnerUp = max(best.runnerUp, other.distance);
+        best.runnerUp = max(best.runnerUp, other.runnerUp);
+    }
+}
+
+// Distances are ranked in plain double, which is what LineOrientation's
+// static bound covers; quickHull settles near-ties exactly afterwards.
+Farthest scanFarthest(const Point2* points, const Point2& p1, const Point2& p2, const size_t* begin, const size_t* end)
+{
+    Farthest best{ 0, 0, 0, 0 };
+    double dirX = double(p2.x) - p1.x;
+    double dirY = double(p2.y) - p1.y;
+
+    for (const size_t* it = begin; it != end; ++it)
+    {
+        const Point2& pt = points[*it];
+        double rx = double(pt.x) - p1.x;
+        double ry = double(pt.y) - p1.y;
+        Farthest candidate{ *it, -(ry * dirX - dirY * rx), rx * dirX + ry * dirY, 0 };
+        if (isFarther(candidate, best)) {
+            candidate.runnerUp = max(best.runnerUp, best.distance);
+            best = candidate;
+        }
+        else {
+            best.runnerUp = max(best.runnerUp, candidate.distance);
+        }
+    }
+    return best;
+}
+
+// The exactly farthest among the candidates whose rounded distance reaches
+// threshold, with distance 0 when none lies strictly right of p1 -> p2.
+Farthest scanFarthestExact(const Point2* points, const Point2& p1, const Point2& p2, const size_t* begin,
+    const size_t* end, double threshold)
+{
+    Farthest best{ 0, 0, 0, 0 };
+    bool found = false;
+    double dirX = double(p2.x) - p1.x;
+    double dirY = double(p2.y) - p1.y;
+    for (const size_t* it = begin; it != end; ++it)
+    {
+        const Point2& pt = points[*it];
+        double distance = -((double(pt.y) - p1.y) * dirX - dirY * (double(pt.x) - p1.x));
+        if (distance >= threshold && (!found || isFartherExact(p1, p2, pt, points[best.index]))) {
+            best.index = *it;
+            found = true;
+        }
+    }
+    if (found) {
+        best.distance = -signedLineDist(p1, p2, points[best.index]);
+    }
+    return best;
+}
+
+Farthest findFarthest(const QuickHullState& state, size_t p1, size_t p2, size_t* begin, size_t* end)
+{
+    const Point2* points = state.points;
+    size_t count = end - begin;
+    if (!state.pool || count < 2 * parallelGrain) {
+        return scanFarthest(points, points[p1], points[p2], begin, end);
+    }
+
+    vector<Farthest> chunks((count + parallelGrain - 1) / parallelGrain);
+    state.pool->ParallelFor(0, count, parallelGrain, [&](size_t chunkBegin, size_t chunkEnd) {
+        chunks[chunkBegin / parallelGrain] = scanFarthest(points, points[p1], points[p2],
+            begin + chunkBegin, begin + chunkEnd);
+    });
+
+    Farthest best = chunks[0];
+    for (size_t chunk = 1; chunk < chunks.size(); chunk++) {
+        mergeFarthest(best, chunks[chunk]);
+    }
+    return best;
+}
+
+Farthest findFarthestExact(const QuickHullState& state, size_t p1, size_t p2, size_t* begin, size_t* end,
+    double threshold)
+{
+    const Point2* points = state.points;
+    size_t count = end - begin;
+    if (!state.pool || count < 2 * parallelGrain) {
+        return scanFarthestExact(points, points[p1], points[p2], begin, end, threshold);
+    }
+
+    vector<Farthest> chunks((count + parallelGrain - 1) / parallelGrain);
+    state.pool->ParallelFor(0, count, parallelGrain, [&](size_t chunkBegin, size_t chunkEnd) {
+        chunks[chunkBegin / parallelGrain] = scanFarthestExact(points, points[p1], points[p2],
+            begin + chunkBegin, begin + chunkEnd, threshold);
+    });
+
+    Farthest best{ 0, 0, 0, 0 };
+    for (const Farthest& chunk : chunks) {
+        if (chunk.distance > 0 && (best.distance <= 0 || isFartherExact(points[p1], points[p2],
+            points[chunk.index], points[best.index])))
+            best = chunk;
+    }
+    return best;
+}
+
+// Appends, in order, the hull vertices strictly between p1 and p2 among the
+// candidates [begin, end), all of which lie to the right of p1 -> p2. The
+// candidates are partitioned in place so each level only touches its own side;
+// walking the lower chain then the upper chain this way yields the hull
+// counter-clockwise without any de-duplication or sorting pass.
+void quickHull(const QuickHullState& state, size_t p1, size_t p2, size_t* begin, size_t* end, vector<size_t>& out)
+{
+    if (begin == end)
+        return;
+
+    // The rounded winner is taken only when every other candidate trails it
+    // by more than both their errors. Otherwise the candidates that might
+    // still beat it are ranked again exactly, as a point that is not the true
+    // farthest can lie inside the hull.
+    const Point2* points = state.points;
+    Farthest farthest = findFarthest(state, p1, p2, begin, end);
+    double window = 2 * LineOrientation(points[p1], points[p2], state.low, state.high).ErrorBound();
+    if (farthest.distance <= window || farthest.runnerUp >= farthest.distance - window)
+        farthest = findFarthestExact(state, p1, p2, begin, end, farthest.distance - window);
+    if (farthest.distance <= 0)
+        return;
+
+    size_t p = farthest.index;
+    LineOrientation toP(points[p1], points[p], state.low, state.high);
+    LineOrientation fromP(points[p], points[p2], state.low, state.high);
+    size_t* leftEnd = std::partition(begin, end, [&](size_t i) { return toP(points[i]) < 0; });
+    size_t* rightEnd = std::partition(leftEnd, end, [&](size_t i) { return fromP(points[i]) < 0; });
+
+    if (state.pool && size_t(end - begin) >= parallelGrain) {
+        vector<size_t> rightOut;
+        TaskGroup group(*state.pool);
+        group.Run([&] { quickHull(state, p, p2, leftEnd, rightEnd, rightOut); });
+        quickHull(state, p1, p, begin, leftEnd, out);
+        group.Wait();
+        out.push_back(p);
+        out.insert(out.end(), rightOut.begin(), rightOut.end());
+    }
+    else {
+        quickHull(state, p1, p, begin, leftEnd, out);
+        out.push_back(p);
+        quickHull(state, p, p2, leftEnd, rightEnd, out);
+    }
+}
+
+struct Extremes {
+    size_t leftMost;
+    size_t rightMost;
+    Point2 low;
+    Point2 high;
+};
+
+Extremes scanExtremes(const Point2* points, size_t begin, size_t end)
+{
+    Extremes extremes{ begin, begin, points[begin], points[begin] };
+    for (size_t i = begin; i < end; i++) {
+        if (lexicographicLess(points[i], points[extremes.leftMost]))
+            extremes.leftMost = i;
+        if (lexicographicLess(points[extremes.rightMost], points[i]))
+            extremes.rightMost = i;
+        extremes.low.y = min(extremes.low.y, points[i].y);
+        extremes.high.y = max(extremes.high.y, points[i].y);
+    }
+    extremes.low.x = points[extremes.leftMost].x;
+    extremes.high.x = points[extremes.rightMost].x;
+    return extremes;
+}
+
+Extremes findExtremes(const QuickHullState& state, size_t count)
+{
+    const Point2* points = state.points;
+    if (!state.pool || count < 2 * parallelGrain) {
+        return scanExtremes(points, 0, count);
+    }
+
+    vector<Extremes> chunks((count + parallelGrain - 1) / parallelGrain);
+    state.pool->ParallelFor(0, count, parallelGrain, [&](size_t chunkBegin, size_t chunkEnd) {
+        chunks[chunkBegin / parallelGrain] = scanExtremes(points, chunkBegin, chunkEnd);
+    });
+
+    Extremes extremes = chunks[0];
+    for (const Extremes& chunk : chunks) {
+        if (lexicographicLess(points[chunk.leftMost], points[extremes.leftMost]))
+            extremes.leftMost = chunk.leftMost;
+        if (lexicographicLess(points[extremes.rightMost], points[chunk.rightMost]))
+            extremes.rightMost = chunk.rightMost;
+        extremes.low.y = min(extremes.low.y, chunk.low.y);
+        extremes.high.y = max(extremes.high.y, chunk.high.y);
+    }
+    extremes.low.x = points[extremes.leftMost].x;
+    extremes.high.x = points[extremes.rightMost].x;
+    return extremes;
+}
+
+// Fills candidates with the indices below leftMost -> rightMost followed by
+// those above it and returns the size of the first group. Large inputs are
+// counted per chunk first so every chunk can scatter into its own slots.
+size_t splitCandidates(const QuickHullState& state, size_t count, size_t leftMost, size_t rightMost, vector<size_t>& candidates)
+{
+    const Point2* points = state.points;
+    LineOrientation orientation(points[leftMost], points[rightMost], state.low, state.high);
+
+    if (!state.pool || count < 2 * parallelGrain) {
+        vector<size_t> upper;
+        for (size_t i = 0; i < count; i++) {
+            double side = orientation(points[i]);
+            if (side < 0)
+                candidates.push_back(i);
+            else if (side > 0)
+                upper.push_back(i);
+        }
+        size_t lowerCount = candidates.size();
+        candidates.insert(candidates.end(), upper.begin(), upper.end());
+        return lowerCount;
+    }
+
+    size_t chunkCount = (count + parallelGrain - 1) / parallelGrain;
+    vector<size_t> lowerCounts(chunkCount + 1, 0);
+    vector<size_t> upperCounts(chunkCount + 1, 0);
+    state.pool->ParallelFor(0, count, parallelGrain, [&](size_t chunkBegin, size_t chunkEnd) {
+        size_t chunk = chunkBegin / parallelGrain;
+        for (size_t i = chunkBegin; i < chunkEnd; i++) {
+            double side = orientation(points[i]);
+            if (side < 0)
+                lowerCounts[chunk + 1]++;
+            else if (side > 0)
+                upperCounts[chunk + 1]++;
+        }
+    });
+
+    for (size_t chunk = 1; chunk <= chunkCount; chunk++) {
+        lowerCounts[chunk] += lowerCounts[chunk - 1];
+        upperCounts[chunk] += upperCounts[chunk - 1];
+    }
+    size_t lowerCount = lowerCounts[chunkCount];
+    candidates.resize(lowerCount + upperCounts[chunkCount]);
+
+    state.pool->ParallelFor(0, count, parallelGrain, [&](size_t chunkBegin, size_t chunkEnd) {
+        size_t chunk = chunkBegin / parallelGrain;
+        size_t* lowerOut = candidates.data() + lowerCounts[chunk];
+        size_t* upperOut = candidates.data() + lowerCount + upperCounts[chunk];
+        for (size_t i = chunkBegin; i < chunkEnd; i++) {
+            double side = orientation(points[i]);
+            if (side < 0)
+                *lowerOut++ = i;
+            else if (side > 0)
+                *upperOut++ = i;
+        }
+    });
+    return lowerCount;
+}
+
+void calculateHull(QuickHullState state, size_t count, vector<size_t>& hullIndices)
+{
+    hullIndices.clear();
+    if (count == 0) {
+        return;
+    }
+
+    const Point2* points = state.points;
+    Extremes extremes = findExtremes(state, count);
+    state.low = extremes.low;
+    state.high = extremes.high;
+    size_t leftMostPoint = extremes.leftMost;
+    size_t rightMostPoint = extremes.rightMost;
+
+    hullIndices.push_back(leftMostPoint);
+    if (points[rightMostPoint] == points[leftMostPoint]) {
+        return;
+    }
+
+    vector<size_t> candidates;
+    size_t lowerCount = splitCandidates(state, count, leftMostPoint, rightMostPoint, candidates);
+    size_t* lowerBegin = candidates.data();
+    size_t* upperBegin = lowerBegin + lowerCount;
+    size_t* upperEnd = lowerBegin + candidates.size();
+
+    vector<size_t> upperHull;
+    if (state.pool && candidates.size() >= parallelGrain) {
+        TaskGroup group(*state.pool);
+        group.Run([&] { quickHull(state, rightMostPoint, leftMostPoint, upperBegin, upperEnd, upperHull); });
+        quickHull(state, leftMostPoint, rightMostPoint, lowerBegin, upperBegin, hullIndices);
+        group.Wait();
+    }
+    else {
+        quickHull(state, leftMostPoint, rightMostPoint, lowerBegin, upperBegin, hullIndices);
+        quickHull(state, rightMostPoint, leftMostPoint, upperBegin, upperEnd, upperHull);
+    }
+
+    hullIndices.push_back(rightMostPoint);
+    hullIndices.insert(hullIndices.end(), upperHull.begin(), upperHull.end());
+}
+
+}
+
+void CalculateQuickHull(const Point2* points, size_t count, vector<size_t>& hullIndices)
+{
+    calculateHull(QuickHullState{ points, nullptr }, count, hullIndices);
+}
+
+void CalculateParallelQuickHull(const Point2* points, size_t count, vector<size_t>& hullIndices, TaskPool& pool)
+{
+    calculateHull(QuickHullState{ points, &pool }, count, hullIndices);
+}
+
+}
@@ -0,0 +1,53 @@
+#pragma once
+
+#include <cstddef>
+#include <vector>
+
+#include "point.h"
+#include "predicates.h"
+#include "simd_kernels.h"
+
+namespace hullcore {
+
+class TaskPool;
+
+// Twice the signed area of (p1, p2, pTest); positive when pTest is left of p1 -> p2.
+// The sign is exact, see Orient2d.
+inline double signedLineDist(const Point2& p1, const Point2& p2, const Point2& pTest)
+{
+    return Orient2d(p1, p2, pTest);
+}
+
+int findSide(const Point2& p1, const Point2& p2, const Point2& pTest);
+
+// Whether a lies farther right of p1 -> p2 than b, equally far points going to
+// the one nearer p1 along the line; exact, so it ranks near-ties correctly.
+inline bool isFartherExact(const Point2& p1, const Point2& p2, const Point2& a, const Point2& b)
+{
+    double across = CrossEdges(p1, p2, b, a);
+    if (across != 0)
+        return across < 0;
+    return DotEdges(p1, p2, b, a) < 0;
+}
+
+// Writes the indices of the hull vertices of points[0, count) into hullIndices,
+// counter-clockwise starting from the lowest of the leftmost points.
+void CalculateQuickHull(const Point2* points, size_t count, std::vector<size_t>& hullIndices);
+
+// Same result as CalculateQuickHull. The extreme point scan and the farthest
+// point searches on large candidate sets are split across the pool, and the
+// two sub-problems of every split run as separate tasks.
+void CalculateParallelQuickHull(const Point2* points, size_t count, std::vector<size_t>& hullIndices, TaskPool& pool);
+
+// Same result as CalculateQuickHull, with the farthest point search and the
+// split classification done by the vector kernels of simd_kernels.h over
+// structure-of-arrays copies of the candidates.
+void CalculateSimdQuickHull(const Point2* points, size_t count, std::vector<size_t>& hullIndices,
+    SimdLevel level = DetectSimdLevel());
+
+// The same over split coordinate arrays, such as a mapped point set file,
+// read in place without building an interleaved copy first.
+void CalculateSimdQuickHull(const float* x, const float* y, size_t count, std::vector<size_t>& hullIndices,
+    SimdLevel level = DetectSimdLevel());
+
+}
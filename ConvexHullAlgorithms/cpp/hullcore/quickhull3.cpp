@@ -0,0 +1,373 @@
+#include "quickhull3.h"
+
+#include <algorithm>
+#include <cmath>
+
+#include "predicates.h"
+
+using namespace std;
+
+namespace hullcore {
+
+namespace {
+
+const uint32_t none = UINT32_MAX;
+
+// Batches at least this large are assigned on the pool, in chunks of
+// assignGrain points.
+const size_t parallelAssignCount = size_t(1) << 15;
+const size_t assignGrain = size_t(1) << 13;
+
+using HalfEdge = HalfEdgeMesh::HalfEdge;
+
+// Points travel through the conflict lists with their coordinates, so the
+// repeated reassignments stream through memory instead of gathering from the
+// input.
+struct Conflict {
+    Point3 point;
+    uint32_t index;
+};
+
+struct Face {
+    Face(uint32_t edge, const PlaneOrientation& plane) : edge(edge), plane(plane) { }
+
+    uint32_t edge;
+    PlaneOrientation plane;
+    vector<Conflict> conflicts;
+    uint32_t farthest = none;
+    double farthestDistance = 0;
+    // Number of the step that found the face visible.
+    uint32_t visibleStep = 0;
+    bool removed = false;
+};
+
+// Entry of the depth-first walk over the visible faces: the edges of the
+// face still to cross, starting with edge.
+struct WalkFrame {
+    uint32_t edge;
+    int remaining;
+};
+
+double squaredLength(double x, double y, double z)
+{
+    return x * x + y * y + z * z;
+}
+
+class QuickHull3 {
+public:
+    QuickHull3(const Point3* points, size_t count, TaskPool& pool) : points(points), count(count), pool(pool) { }
+
+    bool Run(HalfEdgeMesh& mesh);
+
+private:
+    bool findSimplex(uint32_t simplex[4]);
+    uint32_t addFace(uint32_t a, uint32_t b, uint32_t c);
+    void assign(const uint32_t* newFaces, size_t faceCount);
+    void addPoint(uint32_t face);
+    void extract(HalfEdgeMesh& mesh) const;
+
+    const Point3* points;
+    size_t count;
+    TaskPool& pool;
+    Point3 low = {};
+    Point3 high = {};
+
+    vector<HalfEdge> edges;
+    vector<Face> faces;
+    vector<uint32_t> pending;
+    uint32_t step = 0;
+
+    vector<Conflict> candidates;
+    vector<uint32_t> targets;
+    vector<double> distances;
+    vector<uint32_t> visible;
+    vector<uint32_t> horizon;
+    vector<WalkFrame> walk;
+    vector<uint32_t> cone;
+};
+
+uint32_t QuickHull3::addFace(uint32_t a, uint32_t b, uint32_t c)
+{
+    uint32_t face = uint32_t(faces.size());
+    uint32_t edge = uint32_t(edges.size());
+    edges.push_back({ a, none, edge + 1, face });
+    edges.push_back({ b, none, edge + 2, face });
+    edges.push_back({ c, none, edge, face });
+    faces.emplace_back(edge, PlaneOrientation(points[a], points[b], points[c], low, high));
+    return face;
+}
+
+// Two extreme points far apart, the point farthest from their line and the
+// one farthest from the plane of the three. The plane test is exact, so the
+// simplex is never flat.
+bool QuickHull3::findSimplex(uint32_t simplex[4])
+{
+    uint32_t extremes[6] = {};
+    low = high = points[0];
+    for (size_t i = 1; i < count; i++) {
+        const Point3& p = points[i];
+        if (p.x < points[extremes[0]].x) extremes[0] = uint32_t(i);
+        if (p.x > points[extremes[1]].x) extremes[1] = uint32_t(i);
+        if (p.y < points[extremes[2]].y) extremes[2] = uint32_t(i);
+        if (p.y > points[extremes[3]].y) extremes[3] = uint32_t(i);
+        if (p.z < points[extremes[4]].z) extremes[4] = uint32_t(i);
+        if (p.z > points[extremes[5]].z) extremes[5] = uint32_t(i);
+    }
+    low = { points[extremes[0]].x, points[extremes[2]].y, points[extremes[4]].z };
+    high = { points[extremes[1]].x, points[extremes[3]].y, points[extremes[5]].z };
+
+    double best = 0;
+    for (int i = 0; i < 6; i++) {
+        for (int k = i + 1; k < 6; k++) {
+            const Point3& p = points[extremes[i]];
+            const Point3& q = points[extremes[k]];
+            double distance = squaredLength(double(q.x) - p.x, double(q.y) - p.y, double(q.z) - p.z);
+            if (distance > best) {
+                best = distance;
+                simplex[0] = extremes[i];
+                simplex[1] = extremes[k];
+            }
+        }
+    }
+    if (best == 0)
+        return false;
+
+    const Point3& a = points[simplex[0]];
+    const Point3& b = points[simplex[1]];
+    double ux = double(b.x) - a.x, uy = double(b.y) - a.y, uz = double(b.z) - a.z;
+    best = 0;
+    for (size_t i = 0; i < count; i++) {
+        double wx = double(points[i].x) - a.x, wy = double(points[i].y) - a.y, wz = double(points[i].z) - a.z;
+        double distance = squaredLength(uy * wz - uz * wy, uz * wx - ux * wz, ux * wy - uy * wx);
+        if (distance > best) {
+            best = distance;
+            simplex[2] = uint32_t(i);
+        }
+    }
+    if (best == 0)
+        return false;
+
+    const Point3& c = points[simplex[2]];
+    PlaneOrientation plane(a, b, c, low, high);
+    best = 0;
+    simplex[3] = none;
+    for (size_t i = 0; i < count; i++) {
+        double distance = fabs(plane(points[i]));
+        if (distance > best) {
+            best = distance;
+            simplex[3] = uint32_t(i);
+        }
+    }
+    if (simplex[3] == none)
+        return false;
+
+    // Wound so the fourth point is below the face (a, b, c).
+    if (plane(points[simplex[3]]) > 0)
+        swap(simplex[1], simplex[2]);
+    return true;
+}
+
+// Gives each candidate to the first of the new faces it is strictly above;
+// candidates above none of them are inside the hull from now on.
+void QuickHull3::assign(const uint32_t* newFaces, size_t faceCount)
+{
+    size_t candidateCount = candidates.size();
+    targets.resize(candidateCount);
+    distances.resize(candidateCount);
+    auto classify = [&](size_t first, size_t last) {
+        for (size_t i = first; i < last; i++) {
+            Point3 point = candidates[i].point;
+            targets[i] = none;
+            for (size_t f = 0; f < faceCount; f++) {
+                double distance = faces[newFaces[f]].plane(point);
+                if (distance > 0) {
+                    targets[i] = uint32_t(f);
+                    distances[i] = distance;
+                    break;
+                }
+            }
+        }
+    };
+    if (candidateCount >= parallelAssignCount)
+        pool.ParallelFor(0, candidateCount, assignGrain, classify);
+    else
+        classify(0, candidateCount);
+
+    for (size_t i = 0; i < candidateCount; i++) {
+        if (targets[i] == none)
+            continue;
+        Face& face = faces[newFaces[targets[i]]];
+        face.conflicts.push_back(candidates[i]);
+        if (face.farthest == none || distances[i] > face.farthestDistance) {
+            face.farthest = candidates[i].index;
+            face.farthestDistance = distances[i];
+        }
+    }
+    for (size_t f = 0; f < faceCount; f++) {
+        if (!faces[newFaces[f]].conflicts.empty())
+            pending.push_back(newFaces[f]);
+    }
+}
+
+void QuickHull3::addPoint(uint32_t face)
+{
+    uint32_t eye = faces[face].farthest;
+    Point3 eyePoint = points[eye];
+    step++;
+
+    // Depth-first over the faces the eye sees, crossing the edges of each in
+    // order, so the edges into unseen faces come out as one closed loop
+    // running counter-clockwise seen from the eye.
+    visible.assign(1, face);
+    horizon.clear();
+    faces[face].visibleStep = step;
+    walk.assign(1, { faces[face].edge, 3 });
+    while (!walk.empty()) {
+        WalkFrame& top = walk.back();
+        if (top.remaining == 0) {
+            walk.pop_back();
+            continue;
+        }
+        uint32_t edge = top.edge;
+        top.edge = edges[edge].next;
+        top.remaining--;
+
+        uint32_t twin = edges[edge].twin;
+        uint32_t neighbour = edges[twin].face;
+        if (faces[neighbour].visibleStep == step)
+            continue;
+        if (faces[neighbour].plane(eyePoint) > 0) {
+            faces[neighbour].visibleStep = step;
+            visible.push_back(neighbour);
+            walk.push_back({ edges[twin].next, 2 });
+        }
+        else {
+            horizon.push_back(edge);
+        }
+    }
+
+    candidates.clear();
+    for (uint32_t v : visible) {
+        Face& seen = faces[v];
+        seen.removed = true;
+        for (const Conflict& conflict : seen.conflicts) {
+            if (conflict.index != eye)
+                candidates.push_back(conflict);
+        }
+        vector<Conflict>().swap(seen.conflicts);
+    }
+
+    cone.clear();
+    for (uint32_t edge : horizon) {
+        uint32_t from = edges[edge].vertex;
+        uint32_t to = edges[edges[edge].next].vertex;
+        uint32_t added = addFace(from, to, eye);
+        uint32_t base = faces[added].edge;
+        uint32_t outside = edges[edge].twin;
+        edges[base].twin = outside;
+        edges[outside].twin = base;
+        cone.push_back(added);
+    }
+    for (size_t i = 0; i < cone.size(); i++) {
+        uint32_t toEye = faces[cone[i]].edge + 1;
+        uint32_t fromEye = faces[cone[(i + 1) % cone.size()]].edge + 2;
+        edges[toEye].twin = fromEye;
+        edges[fromEye].twin = toEye;
+    }
+
+    assign(cone.data(), cone.size());
+}
+
+void QuickHull3::extract(HalfEdgeMesh& mesh) const
+{
+    mesh.Clear();
+    vector<uint32_t> liveFaces;
+    for (uint32_t f = 0; f < faces.size(); f++) {
+        if (!faces[f].removed)
+            liveFaces.push_back(f);
+    }
+
+    vector<uint32_t> vertexIds;
+    for (uint32_t f : liveFaces) {
+        for (uint32_t k = 0; k < 3; k++) {
+            vertexIds.push_back(edges[faces[f].edge + k].vertex);
+        }
+    }
+    sort(vertexIds.begin(), vertexIds.end());
+    vertexIds.erase(unique(vertexIds.begin(), vertexIds.end()), vertexIds.end());
+    for (uint32_t id : vertexIds) {
+        mesh.vertices.push_back(points[id]);
+        mesh.vertexIndices.push_back(id);
+    }
+
+    // Live faces keep their edges in consecutive triples, so edge k of new
+    // face n becomes 3n + k.
+    vector<uint32_t> edgeMap(edges.size(), none);
+    for (uint32_t n = 0; n < liveFaces.size(); n++) {
+        for (uint32_t k = 0; k < 3; k++) {
+            edgeMap[faces[liveFaces[n]].edge + k] = 3 * n + k;
+        }
+    }
+    for (uint32_t n = 0; n < liveFaces.size(); n++) {
+        mesh.faces.push_back(3 * n);
+        for (uint32_t k = 0; k < 3; k++) {
+            const HalfEdge& edge = edges[faces[liveFaces[n]].edge + k];
+            uint32_t vertex = uint32_t(lower_bound(vertexIds.begin(), vertexIds.end(), edge.vertex) - vertexIds.begin());
+            mesh.edges.push_back({ vertex, edgeMap[edge.twin], 3 * n + (k + 1) % 3, n });
+        }
+    }
+}
+
+bool QuickHull3::Run(HalfEdgeMesh& mesh)
+{
+    uint32_t simplex[4] = {};
+    if (count < 4 || count > none || !findSimplex(simplex)) {
+        mesh.Clear();
+        return false;
+    }
+
+    uint32_t a = simplex[0], b = simplex[1], c = simplex[2], d = simplex[3];
+    uint32_t initial[4] = { addFace(a, b, c), addFace(a, d, b), addFace(b, d, c), addFace(c, d, a) };
+    for (uint32_t e = 0; e < edges.size(); e++) {
+        uint32_t from = edges[e].vertex;
+        uint32_t to = edges[edges[e].next].vertex;
+        for (uint32_t t = 0; t < edges.size(); t++) {
+            if (edges[t].vertex == to && edges[edges[t].next].vertex == from)
+                edges[e].twin = t;
+        }
+    }
+
+    candidates.clear();
+    for (size_t i = 0; i < count; i++) {
+        if (i != a && i != b && i != c && i != d)
+            candidates.push_back({ points[i], uint32_t(i) });
+    }
+    assign(initial, 4);
+
+    while (!pending.empty()) {
+        uint32_t face = pending.back();
+        pending.pop_back();
+        if (!faces[face].removed && !faces[face].conflicts.empty())
+            addPoint(face);
+    }
+    extract(mesh);
+    return true;
+}
+
+}
+
+void HalfEdgeMesh::Clear()
+{
+    vertices.clear();
+    vertexIndices.clear();
+    edges.clear();
+    faces.clear();
+}
+
+bool CalculateQuickHull3(const Point3* points, size_t count, HalfEdgeMesh& mesh, TaskPool& pool)
+{
+    QuickHull3 hull(points, count, pool);
+    return hull.Run(mesh);
+}
+
+}
@@ -0,0 +1,42 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+#include "point.h"
+#include "task_pool.h"
+
+namespace hullcore {
+
+// Closed triangle mesh of a 3D hull. The three half-edges of a face follow
+// each other counter-clockwise seen from outside; edge e runs from its
+// vertex to the vertex of its next edge, and its twin runs back along the
+// neighbouring face. Coplanar neighbouring triangles are not merged.
+struct HalfEdgeMesh {
+    struct HalfEdge {
+        uint32_t vertex;
+        uint32_t twin;
+        uint32_t next;
+        uint32_t face;
+    };
+
+    std::vector<Point3> vertices;
+    // Input position of each vertex.
+    std::vector<size_t> vertexIndices;
+    std::vector<HalfEdge> edges;
+    // First half-edge of each face.
+    std::vector<uint32_t> faces;
+
+    void Clear();
+};
+
+// QuickHull in 3D. Every face keeps the conflict list of the points above
+// it; the farthest point of some face is added by cutting away the faces it
+// sees and coning their horizon to it, and the conflicts of all the faces
+// cut away are reassigned to the new cone in one batch, split across the
+// pool when large. The side tests are exact, see Orient3d. Returns false,
+// with an empty mesh, when the points do not span three dimensions.
+bool CalculateQuickHull3(const Point3* points, size_t count, HalfEdgeMesh& mesh, TaskPool& pool = TaskPool::Default());
+
+}
@@ -0,0 +1,925 @@
+#include "simd_kernels.h"
+
+#include <algorithm>
+#include <cmath>
+#include <iterator>
+#include <vector>
+
+#include "predicates.h"
+
+#if defined(__x86_64__) || defined(_M_X64) || defined(__i386__) || defined(_M_IX86)
+#define HULLCORE_X86 1
+#include <immintrin.h>
+#ifdef _MSC_VER
+#include <intrin.h>
+#endif
+#endif
+
+#if defined(HULLCORE_X86) && (defined(__GNUC__) || defined(__clang__))
+#define HULLCORE_TARGET(isa) __attribute__((target(isa)))
+#else
+#define HULLCORE_TARGET(isa)
+#endif
+
+using namespace std;
+
+namespace hullcore {
+
+namespace {
+
+// Points per call of an extreme point kernel, so lane positions fit int32.
+const size_t extremeBlock = size_t(1) << 30;
+
+// Lane state shared by the scalar tail and the final reduction: a candidate
+// replaces the best one when it is farther, or equally far (and actually right
+// of the line) but closer to p1 along p1 -> p2.
+struct Candidate {
+    double distance;
+    double progress;
+    size_t position;
+};
+
+bool isBetter(const Candidate& a, const Candidate& b)
+{
+    if (a.distance != b.distance)
+        return a.distance > b.distance;
+    if (a.distance <= 0)
+        return false;
+    if (a.progress != b.progress)
+        return a.progress < b.progress;
+    return a.position < b.position;
+}
+
+// The kernels evaluate the side of a point from x, y, dx and dy exactly as
+// Orient2d's fast path does; from and to are kept for the exact fallback.
+struct Line {
+    double x;
+    double y;
+    double dx;
+    double dy;
+    // 1 / (|dx| + |dy|), or 0 for a degenerate line.
+    double inverseScale;
+    Point2 from;
+    Point2 to;
+};
+
+Line makeLine(Point2 p1, Point2 p2)
+{
+    double dx = double(p2.x) - p1.x;
+    double dy = double(p2.y) - p1.y;
+    double scale = fabs(dx) + fabs(dy);
+    return Line{ p1.x, p1.y, dx, dy, scale > 0 ? 1 / scale : 0, p1, p2 };
+}
+
+// Orient2d(line.from, line.to, point) from the precomputed line.
+double orientToLine(const Line& line, Point2 point)
+{
+    double left = (double(point.y) - line.y) * line.dx;
+    double right = line.dy * (double(point.x) - line.x);
+    double determinant = left - right;
+    if (determinantCertain(left, right, determinant))
+        return determinant;
+    return Orient2dExact(line.from, line.to, point);
+}
+
+// Whichever of candidate and best loses is folded into runnerUp.
+void takeBetter(const Candidate& candidate, Candidate& best, double& runnerUp)
+{
+    if (isBetter(candidate, best)) {
+        runnerUp = max(runnerUp, best.distance);
+        best = candidate;
+    }
+    else {
+        runnerUp = max(runnerUp, candidate.distance);
+    }
+}
+
+Candidate scanScalar(const float* x, const float* y, size_t begin, size_t end, const Line& line, Candidate best,
+    double& runnerUp)
+{
+    for (size_t i = begin; i < end; i++) {
+        double rx = double(x[i]) - line.x;
+        double ry = double(y[i]) - line.y;
+        Candidate candidate{ -(ry * line.dx - line.dy * rx), rx * line.dx + ry * line.dy, i };
+        if (candidate.distance > best.distance ||
+            (candidate.distance == best.distance && candidate.distance > 0 && candidate.progress < best.progress)) {
+            runnerUp = max(runnerUp, best.distance);
+            best = candidate;
+        }
+        else {
+            runnerUp = max(runnerUp, candidate.distance);
+        }
+    }
+    return best;
+}
+
+uint8_t classifyScalar(Point2 point, const Line& left, const Line& right)
+{
+    if (orientToLine(left, point) < 0)
+        return SPLIT_LEFT;
+    if (orientToLine(right, point) < 0)
+        return SPLIT_RIGHT;
+    return SPLIT_DISCARD;
+}
+
+void classifyRangeScalar(const float* x, const float* y, size_t begin, size_t end,
+    const Line& left, const Line& right, uint8_t* sides)
+{
+    for (size_t i = begin; i < end; i++) {
+        sides[i] = classifyScalar({ x[i], y[i] }, left, right);
+    }
+}
+
+// Redoes the lanes of a vector block whose sign the error filter could not
+// vouch for; these are rare, so they simply go through the scalar path.
+void resolveSides(const float* x, const float* y, size_t begin, unsigned uncertainMask, int lanes,
+    const Line& left, const Line& right, uint8_t* sides)
+{
+    for (int lane = 0; lane < lanes; lane++) {
+        if ((uncertainMask >> lane) & 1)
+            sides[begin + lane] = classifyScalar({ x[begin + lane], y[begin + lane] }, left, right);
+    }
+}
+
+uint8_t classifyPolygonScalar(const Line* edges, size_t edgeCount, Point2 point)
+{
+    bool onEdge = false;
+    for (size_t e = 0; e < edgeCount; e++) {
+        double d = orientToLine(edges[e], point);
+        if (d < 0)
+            return POLYGON_OUTSIDE;
+        if (d == 0)
+            onEdge = true;
+    }
+    return onEdge ? POLYGON_BOUNDARY : POLYGON_INSIDE;
+}
+
+void classifyPolygonRangeScalar(const Line* edges, size_t edgeCount, const Point2* points, size_t begin, size_t end, uint8_t* labels)
+{
+    for (size_t i = begin; i < end; i++) {
+        labels[i] = classifyPolygonScalar(edges, edgeCount, points[i]);
+    }
+}
+
+void resolveLabels(const Line* edges, size_t edgeCount, const Point2* points, size_t begin, unsigned uncertainMask,
+    int lanes, uint8_t* labels)
+{
+    for (int lane = 0; lane < lanes; lane++) {
+        if ((uncertainMask >> lane) & 1)
+            labels[begin + lane] = classifyPolygonScalar(edges, edgeCount, points[begin + lane]);
+    }
+}
+
+// Running maxima of the eight extents scanned by FindExtremes, all turned
+// into maximizations: -y, x - y, x, x + y, y, y - x, -x, -(x + y).
+struct ExtremeSet {
+    float value[8];
+    size_t position[8];
+};
+
+void extentsOf(Point2 point, float* extents)
+{
+    float difference = point.x - point.y;
+    float sum = point.x + point.y;
+    extents[0] = -point.y;
+    extents[1] = difference;
+    extents[2] = point.x;
+    extents[3] = sum;
+    extents[4] = point.y;
+    extents[5] = -difference;
+    extents[6] = -point.x;
+    extents[7] = -sum;
+}
+
+void extremesRangeScalar(const Point2* points, size_t begin, size_t end, ExtremeSet& result)
+{
+    for (size_t i = begin; i < end; i++) {
+        float extents[8];
+        extentsOf(points[i], extents);
+        for (int d = 0; d < 8; d++) {
+            if (extents[d] > result.value[d]) {
+                result.value[d] = extents[d];
+                result.position[d] = i;
+            }
+        }
+    }
+}
+
+// Folds per-lane maxima into result; equal extents keep the earliest point,
+// which is what the scalar scan would have picked.
+void mergeExtremeLanes(const float* values, const int32_t* positions, int lanes, int direction, ExtremeSet& result)
+{
+    for (int lane = 0; lane < lanes; lane++) {
+        float value = values[lane];
+        size_t position = size_t(positions[lane]);
+        if (value > result.value[direction] || (value == result.value[direction] && position < result.position[direction])) {
+            result.value[direction] = value;
+            result.position[direction] = position;
+        }
+    }
+}
+
+// Boundary lanes always have a zero ratio, so the kernels leave them to
+// resolveLabels and only tell outside from inside themselves.
+uint8_t polygonLabel(int negativeMask, int lane)
+{
+    return ((negativeMask >> lane) & 1) ? POLYGON_OUTSIDE : POLYGON_INSIDE;
+}
+
+#ifdef HULLCORE_X86
+
+// Lanes of left - right whose sign is not vouched for by the error bound, as
+// in determinantCertain; those get an exact scalar retry.
+HULLCORE_TARGET("sse2")
+__m128d uncertainSSE2(__m128d left, __m128d right, __m128d determinant)
+{
+    const __m128d signBit = _mm_set1_pd(-0.0);
+    __m128d magnitude = _mm_add_pd(_mm_andnot_pd(signBit, left), _mm_andnot_pd(signBit, right));
+    return _mm_cmplt_pd(_mm_andnot_pd(signBit, determinant), _mm_mul_pd(_mm_set1_pd(orientErrorBound), magnitude));
+}
+
+HULLCORE_TARGET("avx2")
+__m256d uncertainAVX2(__m256d left, __m256d right, __m256d determinant)
+{
+    const __m256d signBit = _mm256_set1_pd(-0.0);
+    __m256d magnitude = _mm256_add_pd(_mm256_andnot_pd(signBit, left), _mm256_andnot_pd(signBit, right));
+    return _mm256_cmp_pd(_mm256_andnot_pd(signBit, determinant),
+        _mm256_mul_pd(_mm256_set1_pd(orientErrorBound), magnitude), _CMP_LT_OQ);
+}
+
+HULLCORE_TARGET("avx512f")
+__mmask8 uncertainAVX512(__m512d left, __m512d right, __m512d determinant)
+{
+    __m512d magnitude = _mm512_add_pd(_mm512_abs_pd(left), _mm512_abs_pd(right));
+    return _mm512_cmp_pd_mask(_mm512_abs_pd(determinant), _mm512_mul_pd(_mm512_set1_pd(orientErrorBound), magnitude),
+        _CMP_LT_OQ);
+}
+
+HULLCORE_TARGET("sse2")
+FarthestPoint findFarthestSSE2(const float* x, const float* y, size_t count, const Line& line)
+{
+    const __m128d ox = _mm_set1_pd(line.x), oy = _mm_set1_pd(line.y);
+    const __m128d dx = _mm_set1_pd(line.dx), dy = _mm_set1_pd(line.dy);
+    const __m128d zero = _mm_setzero_pd();
+    __m128d bestD = zero, bestP = zero, bestI = zero, secondD = zero;
+    __m128d index = _mm_set_pd(1.0, 0.0);
+    const __m128d step = _mm_set1_pd(2.0);
+
+    size_t i = 0;
+    for (; i + 2 <= count; i += 2) {
+        __m128d px = _mm_cvtps_pd(_mm_castsi128_ps(_mm_loadl_epi64(reinterpret_cast<const __m128i*>(x + i))));
+        __m128d py = _mm_cvtps_pd(_mm_castsi128_ps(_mm_loadl_epi64(reinterpret_cast<const __m128i*>(y + i))));
+        __m128d rx = _mm_sub_pd(px, ox);
+        __m128d ry = _mm_sub_pd(py, oy);
+        __m128d d = _mm_sub_pd(_mm_mul_pd(dy, rx), _mm_mul_pd(ry, dx));
+        __m128d p = _mm_add_pd(_mm_mul_pd(rx, dx), _mm_mul_pd(ry, dy));
+        __m128d take = _mm_or_pd(_mm_cmpgt_pd(d, bestD),
+            _mm_and_pd(_mm_and_pd(_mm_cmpeq_pd(d, bestD), _mm_cmpgt_pd(d, zero)), _mm_cmplt_pd(p, bestP)));
+        secondD = _mm_max_pd(secondD, _mm_or_pd(_mm_and_pd(take, bestD), _mm_andnot_pd(take, d)));
+        bestD = _mm_or_pd(_mm_and_pd(take, d), _mm_andnot_pd(take, bestD));
+        bestP = _mm_or_pd(_mm_and_pd(take, p), _mm_andnot_pd(take, bestP));
+        bestI = _mm_or_pd(_mm_and_pd(take, index), _mm_andnot_pd(take, bestI));
+        index = _mm_add_pd(index, step);
+    }
+
+    alignas(16) double lanesD[2], lanesP[2], lanesI[2], lanesSecond[2];
+    _mm_store_pd(lanesSecond, secondD);
+    _mm_store_pd(lanesD, bestD);
+    _mm_store_pd(lanesP, bestP);
+    _mm_store_pd(lanesI, bestI);
+    Candidate best{ 0, 0, 0 };
+    double runnerUp = 0;
+    for (int lane = 0; lane < 2; lane++) {
+        runnerUp = max(runnerUp, lanesSecond[lane]);
+        takeBetter(Candidate{ lanesD[lane], lanesP[lane], size_t(lanesI[lane]) }, best, runnerUp);
+    }
+    best = scanScalar(x, y, i, count, line, best, runnerUp);
+    return FarthestPoint{ best.position, best.distance, runnerUp };
+}
+
+HULLCORE_TARGET("avx2")
+FarthestPoint findFarthestAVX2(const float* x, const float* y, size_t count, const Line& line)
+{
+    const __m256d ox = _mm256_set1_pd(line.x), oy = _mm256_set1_pd(line.y);
+    const __m256d dx = _mm256_set1_pd(line.dx), dy = _mm256_set1_pd(line.dy);
+    const __m256d zero = _mm256_setzero_pd();
+    __m256d bestD = zero, bestP = zero, bestI = zero, secondD = zero;
+    __m256d index = _mm256_set_pd(3.0, 2.0, 1.0, 0.0);
+    const __m256d step = _mm256_set1_pd(4.0);
+
+    size_t i = 0;
+    for (; i + 4 <= count; i += 4) {
+        __m256d px = _mm256_cvtps_pd(_mm_loadu_ps(x + i));
+        __m256d py = _mm256_cvtps_pd(_mm_loadu_ps(y + i));
+        __m256d rx = _mm256_sub_pd(px, ox);
+        __m256d ry = _mm256_sub_pd(py, oy);
+        __m256d d = _mm256_sub_pd(_mm256_mul_pd(dy, rx), _mm256_mul_pd(ry, dx));
+        __m256d p = _mm256_add_pd(_mm256_mul_pd(rx, dx), _mm256_mul_pd(ry, dy));
+        __m256d take = _mm256_or_pd(_mm256_cmp_pd(d, bestD, _CMP_GT_OQ),
+            _mm256_and_pd(_mm256_and_pd(_mm256_cmp_pd(d, bestD, _CMP_EQ_OQ), _mm256_cmp_pd(d, zero, _CMP_GT_OQ)),
+                _mm256_cmp_pd(p, bestP, _CMP_LT_OQ)));
+        secondD = _mm256_max_pd(secondD, _mm256_blendv_pd(d, bestD, take));
+        bestD = _mm256_blendv_pd(bestD, d, take);
+        bestP = _mm256_blendv_pd(bestP, p, take);
+        bestI = _mm256_blendv_pd(bestI, index, take);
+        index = _mm256_add_pd(index, step);
+    }
+
+    alignas(32) double lanesD[4], lanesP[4], lanesI[4], lanesSecond[4];
+    _mm256_store_pd(lanesSecond, secondD);
+    _mm256_store_pd(lanesD, bestD);
+    _mm256_store_pd(lanesP, bestP);
+    _mm256_store_pd(lanesI, bestI);
+    Candidate best{ 0, 0, 0 };
+    double runnerUp = 0;
+    for (int lane = 0; lane < 4; lane++) {
+        runnerUp = max(runnerUp, lanesSecond[lane]);
+        takeBetter(Candidate{ lanesD[lane], lanesP[lane], size_t(lanesI[lane]) }, best, runnerUp);
+    }
+    best = scanScalar(x, y, i, count, line, best, runnerUp);
+    return FarthestPoint{ best.position, best.distance, runnerUp };
+}
+
+HULLCORE_TARGET("avx512f")
+FarthestPoint findFarthestAVX512(const float* x, const float* y, size_t count, const Line& line)
+{
+    const __m512d ox = _mm512_set1_pd(line.x), oy = _mm512_set1_pd(line.y);
+    const __m512d dx = _mm512_set1_pd(line.dx), dy = _mm512_set1_pd(line.dy);
+    const __m512d zero = _mm512_setzero_pd();
+    __m512d bestD = zero, bestP = zero, bestI = zero, secondD = zero;
+    __m512d index = _mm512_set_pd(7.0, 6.0, 5.0, 4.0, 3.0, 2.0, 1.0, 0.0);
+    const __m512d step = _mm512_set1_pd(8.0);
+
+    size_t i = 0;
+    for (; i + 8 <= count; i += 8) {
+        __m512d px = _mm512_maskz_cvtps_pd(0xFF, _mm256_loadu_ps(x + i));
+        __m512d py = _mm512_maskz_cvtps_pd(0xFF, _mm256_loadu_ps(y + i));
+        __m512d rx = _mm512_sub_pd(px, ox);
+        __m512d ry = _mm512_sub_pd(py, oy);
+        __m512d d = _mm512_sub_pd(_mm512_mul_pd(dy, rx), _mm512_mul_pd(ry, dx));
+        __m512d p = _mm512_add_pd(_mm512_mul_pd(rx, dx), _mm512_mul_pd(ry, dy));
+        __mmask8 tie = _mm512_cmp_pd_mask(d, bestD, _CMP_EQ_OQ) & _mm512_cmp_pd_mask(d, zero, _CMP_GT_OQ) &
+            _mm512_cmp_pd_mask(p, bestP, _CMP_LT_OQ);
+        __mmask8 take = _mm512_cmp_pd_mask(d, bestD, _CMP_GT_OQ) | tie;
+        __m512d loser = _mm512_mask_blend_pd(take, d, bestD);
+        secondD = _mm512_mask_blend_pd(_mm512_cmp_pd_mask(loser, secondD, _CMP_GT_OQ), secondD, loser);
+        bestD = _mm512_mask_blend_pd(take, bestD, d);
+        bestP = _mm512_mask_blend_pd(take, bestP, p);
+        bestI = _mm512_mask_blend_pd(take, bestI, index);
+        index = _mm512_add_pd(index, step);
+    }
+
+    alignas(64) double lanesD[8], lanesP[8], lanesI[8], lanesSecond[8];
+    _mm512_store_pd(lanesSecond, secondD);
+    _mm512_store_pd(lanesD, bestD);
+    _mm512_store_pd(lanesP, bestP);
+    _mm512_store_pd(lanesI, bestI);
+    Candidate best{ 0, 0, 0 };
+    double runnerUp = 0;
+    for (int lane = 0; lane < 8; lane++) {
+        runnerUp = max(runnerUp, lanesSecond[lane]);
+        takeBetter(Candidate{ lanesD[lane], lanesP[lane], size_t(lanesI[lane]) }, best, runnerUp);
+    }
+    best = scanScalar(x, y, i, count, line, best, runnerUp);
+    return FarthestPoint{ best.position, best.distance, runnerUp };
+}
+
+HULLCORE_TARGET("sse2")
+void classifySSE2(const float* x, const float* y, size_t count, const Line& left, const Line& right, uint8_t* sides)
+{
+    const __m128d lx = _mm_set1_pd(left.x), ly = _mm_set1_pd(left.y);
+    const __m128d ldx = _mm_set1_pd(left.dx), ldy = _mm_set1_pd(left.dy);
+    const __m128d rx = _mm_set1_pd(right.x), ry = _mm_set1_pd(right.y);
+    const __m128d rdx = _mm_set1_pd(right.dx), rdy = _mm_set1_pd(right.dy);
+    const __m128d zero = _mm_setzero_pd();
+
+    size_t i = 0;
+    for (; i + 2 <= count; i += 2) {
+        __m128d px = _mm_cvtps_pd(_mm_castsi128_ps(_mm_loadl_epi64(reinterpret_cast<const __m128i*>(x + i))));
+        __m128d py = _mm_cvtps_pd(_mm_castsi128_ps(_mm_loadl_epi64(reinterpret_cast<const __m128i*>(y + i))));
+        __m128d l1 = _mm_mul_pd(_mm_sub_pd(py, ly), ldx), l2 = _mm_mul_pd(ldy, _mm_sub_pd(px, lx));
+        __m128d r1 = _mm_mul_pd(_mm_sub_pd(py, ry), rdx), r2 = _mm_mul_pd(rdy, _mm_sub_pd(px, rx));
+        __m128d dl = _mm_sub_pd(l1, l2);
+        __m128d dr = _mm_sub_pd(r1, r2);
+        int leftMask = _mm_movemask_pd(_mm_cmplt_pd(dl, zero));
+        int rightMask = _mm_movemask_pd(_mm_cmplt_pd(dr, zero)) & ~leftMask;
+        for (int lane = 0; lane < 2; lane++) {
+            sides[i + lane] = uint8_t(((leftMask >> lane) & 1) * SPLIT_LEFT + ((rightMask >> lane) & 1) * SPLIT_RIGHT);
+        }
+        int uncertain = _mm_movemask_pd(_mm_or_pd(uncertainSSE2(l1, l2, dl), uncertainSSE2(r1, r2, dr)));
+        if (uncertain)
+            resolveSides(x, y, i, unsigned(uncertain), 2, left, right, sides);
+    }
+    classifyRangeScalar(x, y, i, count, left, right, sides);
+}
+
+HULLCORE_TARGET("avx2")
+void classifyAVX2(const float* x, const float* y, size_t count, const Line& left, const Line& right, uint8_t* sides)
+{
+    const __m256d lx = _mm256_set1_pd(left.x), ly = _mm256_set1_pd(left.y);
+    const __m256d ldx = _mm256_set1_pd(left.dx), ldy = _mm256_set1_pd(left.dy);
+    const __m256d rx = _mm256_set1_pd(right.x), ry = _mm256_set1_pd(right.y);
+    const __m256d rdx = _mm256_set1_pd(right.dx), rdy = _mm256_set1_pd(right.dy);
+    const __m256d zero = _mm256_setzero_pd();
+
+    size_t i = 0;
+    for (; i + 4 <= count; i += 4) {
+        __m256d px = _mm256_cvtps_pd(_mm_loadu_ps(x + i));
+        __m256d py = _mm256_cvtps_pd(_mm_loadu_ps(y + i));
+        __m256d l1 = _mm256_mul_pd(_mm256_sub_pd(py, ly), ldx), l2 = _mm256_mul_pd(ldy, _mm256_sub_pd(px, lx));
+        __m256d r1 = _mm256_mul_pd(_mm256_sub_pd(py, ry), rdx), r2 = _mm256_mul_pd(rdy, _mm256_sub_pd(px, rx));
+        __m256d dl = _mm256_sub_pd(l1, l2);
+        __m256d dr = _mm256_sub_pd(r1, r2);
+        int leftMask = _mm256_movemask_pd(_mm256_cmp_pd(dl, zero, _CMP_LT_OQ));
+        int rightMask = _mm256_movemask_pd(_mm256_cmp_pd(dr, zero, _CMP_LT_OQ)) & ~leftMask;
+        for (int lane = 0; lane < 4; lane++) {
+            sides[i + lane] = uint8_t(((leftMask >> lane) & 1) * SPLIT_LEFT + ((rightMask >> lane) & 1) * SPLIT_RIGHT);
+        }
+        int uncertain = _mm256_movemask_pd(_mm256_or_pd(uncertainAVX2(l1, l2, dl), uncertainAVX2(r1, r2, dr)));
+        if (uncertain)
+            resolveSides(x, y, i, unsigned(uncertain), 4, left, right, sides);
+    }
+    classifyRangeScalar(x, y, i, count, left, right, sides);
+}
+
+HULLCORE_TARGET("avx512f")
+void classifyAVX512(const float* x, const float* y, size_t count, const Line& left, const Line& right, uint8_t* sides)
+{
+    const __m512d lx = _mm512_set1_pd(left.x), ly = _mm512_set1_pd(left.y);
+    const __m512d ldx = _mm512_set1_pd(left.dx), ldy = _mm512_set1_pd(left.dy);
+    const __m512d rx = _mm512_set1_pd(right.x), ry = _mm512_set1_pd(right.y);
+    const __m512d rdx = _mm512_set1_pd(right.dx), rdy = _mm512_set1_pd(right.dy);
+    const __m512d zero = _mm512_setzero_pd();
+
+    size_t i = 0;
+    for (; i + 8 <= count; i += 8) {
+        __m512d px = _mm512_maskz_cvtps_pd(0xFF, _mm256_loadu_ps(x + i));
+        __m512d py = _mm512_maskz_cvtps_pd(0xFF, _mm256_loadu_ps(y + i));
+        __m512d l1 = _mm512_mul_pd(_mm512_sub_pd(py, ly), ldx), l2 = _mm512_mul_pd(ldy, _mm512_sub_pd(px, lx));
+        __m512d r1 = _mm512_mul_pd(_mm512_sub_pd(py, ry), rdx), r2 = _mm512_mul_pd(rdy, _mm512_sub_pd(px, rx));
+        __m512d dl = _mm512_sub_pd(l1, l2);
+        __m512d dr = _mm512_sub_pd(r1, r2);
+        unsigned leftMask = _mm512_cmp_pd_mask(dl, zero, _CMP_LT_OQ);
+        unsigned rightMask = _mm512_cmp_pd_mask(dr, zero, _CMP_LT_OQ) & ~leftMask;
+        for (int lane = 0; lane < 8; lane++) {
+            sides[i + lane] = uint8_t(((leftMask >> lane) & 1) * SPLIT_LEFT + ((rightMask >> lane) & 1) * SPLIT_RIGHT);
+        }
+        unsigned uncertain = uncertainAVX512(l1, l2, dl) | uncertainAVX512(r1, r2, dr);
+        if (uncertain)
+            resolveSides(x, y, i, uncertain, 8, left, right, sides);
+    }
+    classifyRangeScalar(x, y, i, count, left, right, sides);
+}
+
+// Largest coordinate magnitude among the polygon vertices.
+double vertexReach(const Line* edges, size_t edgeCount)
+{
+    double reach = 0;
+    for (size_t e = 0; e < edgeCount; e++) {
+        reach = max(reach, max(fabs(edges[e].x), fabs(edges[e].y)));
+    }
+    return reach;
+}
+
+// The polygon kernels test a block of query points against every edge at once
+// and stop early once the whole block is outside some edge. Rather than an
+// error bound per edge and lane they keep, per lane, the smallest
+// |d| / (|dx| + |dy|) seen: since |left| + |right| is at most
+// max(|rx|, |ry|) (|dx| + |dy|), a smallest ratio of twice orientErrorBound
+// times (max(|px|, |py|) + vertexReach) vouches for every sign of the lane,
+// the factor two covering the rounding of the ratio itself.
+HULLCORE_TARGET("sse2")
+void classifyPolygonSSE2(const Line* edges, size_t edgeCount, const Point2* points, size_t count, uint8_t* labels)
+{
+    const __m128d zero = _mm_setzero_pd();
+    const __m128d signBit = _mm_set1_pd(-0.0);
+    const __m128d reach = _mm_set1_pd(vertexReach(edges, edgeCount));
+    const __m128d bound = _mm_set1_pd(2 * orientErrorBound);
+
+    size_t i = 0;
+    for (; i + 2 <= count; i += 2) {
+        __m128 xy = _mm_loadu_ps(reinterpret_cast<const float*>(points + i));
+        xy = _mm_shuffle_ps(xy, xy, _MM_SHUFFLE(3, 1, 2, 0));
+        __m128d px = _mm_cvtps_pd(xy);
+        __m128d py = _mm_cvtps_pd(_mm_movehl_ps(xy, xy));
+        __m128d negative = zero;
+        __m128d ratio = _mm_set1_pd(HUGE_VAL);
+        for (size_t e = 0; e < edgeCount; e++) {
+            const Line& edge = edges[e];
+            __m128d left = _mm_mul_pd(_mm_sub_pd(py, _mm_set1_pd(edge.y)), _mm_set1_pd(edge.dx));
+            __m128d right = _mm_mul_pd(_mm_set1_pd(edge.dy), _mm_sub_pd(px, _mm_set1_pd(edge.x)));
+            __m128d d = _mm_sub_pd(left, right);
+            ratio = _mm_min_pd(_mm_mul_pd(_mm_andnot_pd(signBit, d), _mm_set1_pd(edge.inverseScale)), ratio);
+            negative = _mm_or_pd(negative, _mm_cmplt_pd(d, zero));
+            if (_mm_movemask_pd(negative) == 0x3)
+                break;
+        }
+        int negativeMask = _mm_movemask_pd(negative);
+        for (int lane = 0; lane < 2; lane++) {
+            labels[i + lane] = polygonLabel(negativeMask, lane);
+        }
+        __m128d magnitude = _mm_max_pd(_mm_andnot_pd(signBit, px), _mm_andnot_pd(signBit, py));
+        int uncertainMask = _mm_movemask_pd(_mm_cmplt_pd(ratio, _mm_mul_pd(bound, _mm_add_pd(magnitude, reach))));
+        if (uncertainMask)
+            resolveLabels(edges, edgeCount, points, i, unsigned(uncertainMask), 2, labels);
+    }
+    classifyPolygonRangeScalar(edges, edgeCount, points, i, count, labels);
+}
+
+HULLCORE_TARGET("avx2")
+void classifyPolygonAVX2(const Line* edges, size_t edgeCount, const Point2* points, size_t count, uint8_t* labels)
+{
+    const __m256i deinterleave = _mm256_setr_epi32(0, 2, 4, 6, 1, 3, 5, 7);
+    const __m256d zero = _mm256_setzero_pd();
+    const __m256d signBit = _mm256_set1_pd(-0.0);
+    const __m256d reach = _mm256_set1_pd(vertexReach(edges, edgeCount));
+    const __m256d bound = _mm256_set1_pd(2 * orientErrorBound);
+
+    size_t i = 0;
+    for (; i + 4 <= count; i += 4) {
+        __m256 xy = _mm256_permutevar8x32_ps(_mm256_loadu_ps(reinterpret_cast<const float*>(points + i)), deinterleave);
+        __m256d px = _mm256_cvtps_pd(_mm256_castps256_ps128(xy));
+        __m256d py = _mm256_cvtps_pd(_mm256_extractf128_ps(xy, 1));
+        __m256d negative = zero;
+        __m256d ratio = _mm256_set1_pd(HUGE_VAL);
+        for (size_t e = 0; e < edgeCount; e++) {
+            const Line& edge = edges[e];
+            __m256d left = _mm256_mul_pd(_mm256_sub_pd(py, _mm256_set1_pd(edge.y)), _mm256_set1_pd(edge.dx));
+            __m256d right = _mm256_mul_pd(_mm256_set1_pd(edge.dy), _mm256_sub_pd(px, _mm256_set1_pd(edge.x)));
+            __m256d d = _mm256_sub_pd(left, right);
+            ratio = _mm256_min_pd(_mm256_mul_pd(_mm256_andnot_pd(signBit, d), _mm256_set1_pd(edge.inverseScale)), ratio);
+            negative = _mm256_or_pd(negative, _mm256_cmp_pd(d, zero, _CMP_LT_OQ));
+            if (_mm256_movemask_pd(negative) == 0xF)
+                break;
+        }
+        int negativeMask = _mm256_movemask_pd(negative);
+        for (int lane = 0; lane < 4; lane++) {
+            labels[i + lane] = polygonLabel(negativeMask, lane);
+        }
+        __m256d magnitude = _mm256_max_pd(_mm256_andnot_pd(signBit, px), _mm256_andnot_pd(signBit, py));
+        int uncertainMask = _mm256_movemask_pd(
+            _mm256_cmp_pd(ratio, _mm256_mul_pd(bound, _mm256_add_pd(magnitude, reach)), _CMP_LT_OQ));
+        if (uncertainMask)
+            resolveLabels(edges, edgeCount, points, i, unsigned(uncertainMask), 4, labels);
+    }
+    classifyPolygonRangeScalar(edges, edgeCount, points, i, count, labels);
+}
+
+HULLCORE_TARGET("avx512f,avx2")
+void classifyPolygonAVX512(const Line* edges, size_t edgeCount, const Point2* points, size_t count, uint8_t* labels)
+{
+    const __m256i deinterleave = _mm256_setr_epi32(0, 2, 4, 6, 1, 3, 5, 7);
+    const __m512d zero = _mm512_setzero_pd();
+    const __m512d reach = _mm512_set1_pd(vertexReach(edges, edgeCount));
+    const __m512d bound = _mm512_set1_pd(2 * orientErrorBound);
+
+    size_t i = 0;
+    for (; i + 8 <= count; i += 8) {
+        __m256 low = _mm256_permutevar8x32_ps(_mm256_loadu_ps(reinterpret_cast<const float*>(points + i)), deinterleave);
+        __m256 high = _mm256_permutevar8x32_ps(_mm256_loadu_ps(reinterpret_cast<const float*>(points + i + 4)), deinterleave);
+        __m512d px = _mm512_maskz_cvtps_pd(0xFF, _mm256_permute2f128_ps(low, high, 0x20));
+        __m512d py = _mm512_maskz_cvtps_pd(0xFF, _mm256_permute2f128_ps(low, high, 0x31));
+        __mmask8 negative = 0;
+        __m512d ratio = _mm512_set1_pd(HUGE_VAL);
+        for (size_t e = 0; e < edgeCount; e++) {
+            const Line& edge = edges[e];
+            __m512d left = _mm512_mul_pd(_mm512_sub_pd(py, _mm512_set1_pd(edge.y)), _mm512_set1_pd(edge.dx));
+            __m512d right = _mm512_mul_pd(_mm512_set1_pd(edge.dy), _mm512_sub_pd(px, _mm512_set1_pd(edge.x)));
+            __m512d d = _mm512_sub_pd(left, right);
+            ratio = _mm512_maskz_min_pd(0xFF, _mm512_mul_pd(_mm512_abs_pd(d), _mm512_set1_pd(edge.inverseScale)), ratio);
+            negative |= _mm512_cmp_pd_mask(d, zero, _CMP_LT_OQ);
+            if (negative == 0xFF)
+                break;
+        }
+        for (int lane = 0; lane < 8; lane++) {
+            labels[i + lane] = polygonLabel(negative, lane);
+        }
+        __m512d magnitude = _mm512_maskz_max_pd(0xFF, _mm512_abs_pd(px), _mm512_abs_pd(py));
+        __mmask8 uncertain = _mm512_cmp_pd_mask(ratio, _mm512_mul_pd(bound, _mm512_add_pd(magnitude, reach)), _CMP_LT_OQ);
+        if (uncertain)
+            resolveLabels(edges, edgeCount, points, i, uncertain, 8, labels);
+    }
+    classifyPolygonRangeScalar(edges, edgeCount, points, i, count, labels);
+}
+
+// The extreme point kernels keep, per direction and lane, the largest extent
+// seen and the position it came from; positions fit int32 because
+// FindExtremes hands them blocks of at most extremeBlock points.
+HULLCORE_TARGET("sse2")
+void extremesSSE2(const Point2* points, size_t count, ExtremeSet& result)
+{
+    __m128 best[8];
+    __m128i bestPosition[8];
+    for (int d = 0; d < 8; d++) {
+        best[d] = _mm_set1_ps(result.value[d]);
+        bestPosition[d] = _mm_set1_epi32(int32_t(result.position[d]));
+    }
+    const __m128 signBit = _mm_set1_ps(-0.0f);
+    __m128i position = _mm_setr_epi32(0, 1, 2, 3);
+    const __m128i step = _mm_set1_epi32(4);
+
+    size_t i = 0;
+    for (; i + 4 <= count; i += 4) {
+        __m128 low = _mm_loadu_ps(reinterpret_cast<const float*>(points + i));
+        __m128 high = _mm_loadu_ps(reinterpret_cast<const float*>(points + i + 2));
+        __m128 x = _mm_shuffle_ps(low, high, _MM_SHUFFLE(2, 0, 2, 0));
+        __m128 y = _mm_shuffle_ps(low, high, _MM_SHUFFLE(3, 1, 3, 1));
+        __m128 difference = _mm_sub_ps(x, y);
+        __m128 sum = _mm_add_ps(x, y);
+        __m128 extents[8] = {
+            _mm_xor_ps(y, signBit), difference, x, sum,
+            y, _mm_xor_ps(difference, signBit), _mm_xor_ps(x, signBit), _mm_xor_ps(sum, signBit),
+        };
+        for (int d = 0; d < 8; d++) {
+            __m128 greater = _mm_cmpgt_ps(extents[d], best[d]);
+            best[d] = _mm_or_ps(_mm_and_ps(greater, extents[d]), _mm_andnot_ps(greater, best[d]));
+            __m128i take = _mm_castps_si128(greater);
+            bestPosition[d] = _mm_or_si128(_mm_and_si128(take, position), _mm_andnot_si128(take, bestPosition[d]));
+        }
+        position = _mm_add_epi32(position, step);
+    }
+
+    for (int d = 0; d < 8; d++) {
+        float values[4];
+        int32_t positions[4];
+        _mm_storeu_ps(values, best[d]);
+        _mm_storeu_si128(reinterpret_cast<__m128i*>(positions), bestPosition[d]);
+        mergeExtremeLanes(values, positions, 4, d, result);
+    }
+    extremesRangeScalar(points, i, count, result);
+}
+
+HULLCORE_TARGET("avx2")
+void extremesAVX2(const Point2* points, size_t count, ExtremeSet& result)
+{
+    __m256 best[8];
+    __m256i bestPosition[8];
+    for (int d = 0; d < 8; d++) {
+        best[d] = _mm256_set1_ps(result.value[d]);
+        bestPosition[d] = _mm256_set1_epi32(int32_t(result.position[d]));
+    }
+    const __m256i deinterleave = _mm256_setr_epi32(0, 2, 4, 6, 1, 3, 5, 7);
+    const __m256 signBit = _mm256_set1_ps(-0.0f);
+    __m256i position = _mm256_setr_epi32(0, 1, 2, 3, 4, 5, 6, 7);
+    const __m256i step = _mm256_set1_epi32(8);
+
+    size_t i = 0;
+    for (; i + 8 <= count; i += 8) {
+        __m256 low = _mm256_permutevar8x32_ps(_mm256_loadu_ps(reinterpret_cast<const float*>(points + i)), deinterleave);
+        __m256 high = _mm256_permutevar8x32_ps(_mm256_loadu_ps(reinterpret_cast<const float*>(points + i + 4)), deinterleave);
+        __m256 x = _mm256_permute2f128_ps(low, high, 0x20);
+        __m256 y = _mm256_permute2f128_ps(low, high, 0x31);
+        __m256 difference = _mm256_sub_ps(x, y);
+        __m256 sum = _mm256_add_ps(x, y);
+        __m256 extents[8] = {
+            _mm256_xor_ps(y, signBit), difference, x, sum,
+            y, _mm256_xor_ps(difference, signBit), _mm256_xor_ps(x, signBit), _mm256_xor_ps(sum, signBit),
+        };
+        for (int d = 0; d < 8; d++) {
+            __m256 greater = _mm256_cmp_ps(extents[d], best[d], _CMP_GT_OQ);
+            best[d] = _mm256_blendv_ps(best[d], extents[d], greater);
+            bestPosition[d] = _mm256_castps_si256(_mm256_blendv_ps(
+                _mm256_castsi256_ps(bestPosition[d]), _mm256_castsi256_ps(position), greater));
+        }
+        position = _mm256_add_epi32(position, step);
+    }
+
+    for (int d = 0; d < 8; d++) {
+        float values[8];
+        int32_t positions[8];
+        _mm256_storeu_ps(values, best[d]);
+        _mm256_storeu_si256(reinterpret_cast<__m256i*>(positions), bestPosition[d]);
+        mergeExtremeLanes(values, positions, 8, d, result);
+    }
+    extremesRangeScalar(points, i, count, result);
+}
+
+HULLCORE_TARGET("avx512f")
+void extremesAVX512(const Point2* points, size_t count, ExtremeSet& result)
+{
+    __m512 best[8];
+    __m512i bestPosition[8];
+    for (int d = 0; d < 8; d++) {
+        best[d] = _mm512_set1_ps(result.value[d]);
+        bestPosition[d] = _mm512_set1_epi32(int32_t(result.position[d]));
+    }
+    const __m512i evenLanes = _mm512_setr_epi32(0, 2, 4, 6, 8, 10, 12, 14, 16, 18, 20, 22, 24, 26, 28, 30);
+    const __m512i oddLanes = _mm512_setr_epi32(1, 3, 5, 7, 9, 11, 13, 15, 17, 19, 21, 23, 25, 27, 29, 31);
+    __m512i position = _mm512_setr_epi32(0, 1, 2, 3, 4, 5, 6, 7, 8, 9, 10, 11, 12, 13, 14, 15);
+    const __m512i step = _mm512_set1_epi32(16);
+    const __m512 zero = _mm512_setzero_ps();
+
+    size_t i = 0;
+    for (; i + 16 <= count; i += 16) {
+        __m512 low = _mm512_loadu_ps(reinterpret_cast<const float*>(points + i));
+        __m512 high = _mm512_loadu_ps(reinterpret_cast<const float*>(points + i + 8));
+        __m512 x = _mm512_permutex2var_ps(low, evenLanes, high);
+        __m512 y = _mm512_permutex2var_ps(low, oddLanes, high);
+        __m512 difference = _mm512_sub_ps(x, y);
+        __m512 sum = _mm512_add_ps(x, y);
+        __m512 extents[8] = {
+            _mm512_sub_ps(zero, y), difference, x, sum,
+            y, _mm512_sub_ps(zero, difference), _mm512_sub_ps(zero, x), _mm512_sub_ps(zero, sum),
+        };
+        for (int d = 0; d < 8; d++) {
+            __mmask16 greater = _mm512_cmp_ps_mask(extents[d], best[d], _CMP_GT_OQ);
+            best[d] = _mm512_mask_mov_ps(best[d], greater, extents[d]);
+            bestPosition[d] = _mm512_mask_mov_epi32(bestPosition[d], greater, position);
+        }
+        position = _mm512_add_epi32(position, step);
+    }
+
+    for (int d = 0; d < 8; d++) {
+        float values[16];
+        int32_t positions[16];
+        _mm512_storeu_ps(values, best[d]);
+        _mm512_storeu_si512(positions, bestPosition[d]);
+        mergeExtremeLanes(values, positions, 16, d, result);
+    }
+    extremesRangeScalar(points, i, count, result);
+}
+
+SimdLevel detectCpu()
+{
+#ifdef _MSC_VER
+    int info[4];
+    __cpuid(info, 0);
+    if (info[0] < 7)
+        return SimdLevel::SSE2;
+    __cpuid(info, 1);
+    bool osxsave = (info[2] & (1 << 27)) != 0;
+    bool avx = (info[2] & (1 << 28)) != 0;
+    if (!osxsave || !avx)
+        return SimdLevel::SSE2;
+    unsigned long long xcr0 = _xgetbv(0);
+    __cpuidex(info, 7, 0);
+    bool avx2 = (info[1] & (1 << 5)) != 0 && (xcr0 & 0x6) == 0x6;
+    bool avx512 = (info[1] & (1 << 16)) != 0 && (xcr0 & 0xe6) == 0xe6;
+    if (avx512)
+        return SimdLevel::AVX512;
+    if (avx2)
+        return SimdLevel::AVX2;
+    return SimdLevel::SSE2;
+#else
+    __builtin_cpu_init();
+    if (__builtin_cpu_supports("avx512f"))
+        return SimdLevel::AVX512;
+    if (__builtin_cpu_supports("avx2"))
+        return SimdLevel::AVX2;
+    if (__builtin_cpu_supports("sse2"))
+        return SimdLevel::SSE2;
+    return SimdLevel::Scalar;
+#endif
+}
+
+#else
+
+SimdLevel detectCpu()
+{
+    return SimdLevel::Scalar;
+}
+
+#endif
+
+}
+
+SimdLevel DetectSimdLevel()
+{
+    static const SimdLevel level = detectCpu();
+    return level;
+}
+
+const char* SimdLevelName(SimdLevel level)
+{
+    switch (level) {
+    case SimdLevel::SSE2:
+        return "sse2";
+    case SimdLevel::AVX2:
+        return "avx2";
+    case SimdLevel::AVX512:
+        return "avx512";
+    case SimdLevel::Scalar:
+    default:
+        return "scalar";
+    }
+}
+
+FarthestPoint FindFarthest(const float* x, const float* y, size_t count, Point2 p1, Point2 p2, SimdLevel level)
+{
+    Line line = makeLine(p1, p2);
+    if (level > DetectSimdLevel())
+        level = DetectSimdLevel();
+
+    switch (level) {
+#ifdef HULLCORE_X86
+    case SimdLevel::AVX512:
+        return findFarthestAVX512(x, y, count, line);
+    case SimdLevel::AVX2:
+        return findFarthestAVX2(x, y, count, line);
+    case SimdLevel::SSE2:
+        return findFarthestSSE2(x, y, count, line);
+#endif
+    default: {
+        double runnerUp = 0;
+        Candidate best = scanScalar(x, y, 0, count, line, Candidate{ 0, 0, 0 }, runnerUp);
+        return FarthestPoint{ best.position, best.distance, runnerUp };
+    }
+    }
+}
+
+void ClassifySplit(const float* x, const float* y, size_t count, Point2 p1, Point2 p, Point2 p2,
+    uint8_t* sides, SimdLevel level)
+{
+    Line left = makeLine(p1, p);
+    Line right = makeLine(p, p2);
+    if (level > DetectSimdLevel())
+        level = DetectSimdLevel();
+
+    switch (level) {
+#ifdef HULLCORE_X86
+    case SimdLevel::AVX512:
+        classifyAVX512(x, y, count, left, right, sides);
+        break;
+    case SimdLevel::AVX2:
+        classifyAVX2(x, y, count, left, right, sides);
+        break;
+    case SimdLevel::SSE2:
+        classifySSE2(x, y, count, left, right, sides);
+        break;
+#endif
+    default:
+        classifyRangeScalar(x, y, 0, count, left, right, sides);
+        break;
+    }
+}
+
+void ClassifyPolygon(const Point2* polygon, size_t vertexCount, const Point2* points, size_t count,
+    uint8_t* labels, SimdLevel level)
+{
+    vector<Line> edges(vertexCount);
+    for (size_t i = 0; i < vertexCount; i++) {
+        edges[i] = makeLine(polygon[i], polygon[(i + 1) % vertexCount]);
+    }
+    if (level > DetectSimdLevel())
+        level = DetectSimdLevel();
+
+    switch (level) {
+#ifdef HULLCORE_X86
+    case SimdLevel::AVX512:
+        classifyPolygonAVX512(edges.data(), vertexCount, points, count, labels);
+        break;
+    case SimdLevel::AVX2:
+        classifyPolygonAVX2(edges.data(), vertexCount, points, count, labels);
+        break;
+    case SimdLevel::SSE2:
+        classifyPolygonSSE2(edges.data(), vertexCount, points, count, labels);
+        break;
+#endif
+    default:
+        classifyPolygonRangeScalar(edges.data(), vertexCount, points, 0, count, labels);
+        break;
+    }
+}
+
+void FindExtremes(const Point2* points, size_t count, size_t positions[8], SimdLevel level)
+{
+    if (level > DetectSimdLevel())
+        level = DetectSimdLevel();
+    if (count == 0) {
+        fill(positions, positions + 8, size_t(0));
+        return;
+    }
+
+    ExtremeSet result;
+    for (size_t blockBegin = 0; blockBegin < count; blockBegin += extremeBlock) {
+        size_t blockCount = min(extremeBlock, count - blockBegin);
+        ExtremeSet block;
+        extentsOf(points[blockBegin], block.value);
+        fill(begin(block.position), end(block.position), size_t(0));
+        switch (level) {
+#ifdef HULLCORE_X86
+        case SimdLevel::AVX512:
+            extremesAVX512(points + blockBegin, blockCount, block);
+            break;
+        case SimdLevel::AVX2:
+            extremesAVX2(points + blockBegin, blockCount, block);
+            break;
+        case SimdLevel::SSE2:
+            extremesSSE2(points + blockBegin, blockCount, block);
+            break;
+#endif
+        default:
+            extremesRangeScalar(points + blockBegin, 0, blockCount, block);
+            break;
+        }
+        for (int d = 0; d < 8; d++) {
+            if (blockBegin == 0 || block.value[d] > result.value[d]) {
+                result.value[d] = block.value[d];
+                result.position[d] = blockBegin + block.position[d];
+            }
+        }
+    }
+    copy(begin(result.position), end(result.position), positions);
+}
+
+}
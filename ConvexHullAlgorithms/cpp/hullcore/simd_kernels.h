@@ -0,0 +1,58 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+
+#include "point.h"
+
+namespace hullcore {
+
+enum class SimdLevel { Scalar, SSE2, AVX2, AVX512 };
+
+// Widest level supported by both this build and the running CPU; detected once.
+SimdLevel DetectSimdLevel();
+
+const char* SimdLevelName(SimdLevel level);
+
+struct FarthestPoint {
+    size_t position;
+    double distance;
+    // Largest distance among the other points, or 0 when none is positive;
+    // a close runner-up means rounding may have picked the wrong point.
+    double runnerUp;
+};
+
+// Over the structure-of-arrays points (x[i], y[i]) for i in [0, count), finds
+// the point farthest to the right of p1 -> p2 with the same tie-break as the
+// scalar QuickHull. distance is 0 when no point lies strictly right of the line.
+// Distances are evaluated in double, exactly as the fast path of Orient2d; a
+// point within rounding error of the line may be reported with distance 0,
+// and of points within rounding error of each other the wrong one may win.
+FarthestPoint FindFarthest(const float* x, const float* y, size_t count, Point2 p1, Point2 p2,
+    SimdLevel level = DetectSimdLevel());
+
+enum SplitSide : uint8_t { SPLIT_DISCARD = 0, SPLIT_LEFT = 1, SPLIT_RIGHT = 2 };
+
+// Classifies every point against the two edges created by splitting p1 -> p2 at
+// p: SPLIT_LEFT when right of p1 -> p, SPLIT_RIGHT when right of p -> p2.
+// Sides are exact: lanes the error filter cannot settle go through Orient2d.
+void ClassifySplit(const float* x, const float* y, size_t count, Point2 p1, Point2 p, Point2 p2,
+    uint8_t* sides, SimdLevel level = DetectSimdLevel());
+
+enum PolygonLabel : uint8_t { POLYGON_OUTSIDE = 0, POLYGON_BOUNDARY = 1, POLYGON_INSIDE = 2 };
+
+// Labels every point against the closed polygon given counter-clockwise with
+// at least three vertices, testing blocks of points against all edges at once.
+// Intended for small polygons where O(h) vector work beats a binary search.
+// Labels are exact, with the same filtered fallback as ClassifySplit.
+void ClassifyPolygon(const Point2* polygon, size_t vertexCount, const Point2* points, size_t count,
+    uint8_t* labels, SimdLevel level = DetectSimdLevel());
+
+// Positions of the first points reaching the largest -y, x - y, x, x + y, y,
+// y - x, -x and -(x + y), in that order, which walks the eight axis and
+// diagonal directions counter-clockwise. The diagonal extents are compared
+// in float, so their extremes may be off by a rounding step; every returned
+// position is still an input point.
+void FindExtremes(const Point2* points, size_t count, size_t positions[8], SimdLevel level = DetectSimdLevel());
+
+}
@@ -0,0 +1,194 @@
+#include "quickhull.h"
+
+#include <algorithm>
+
+#include "simd_kernels.h"
+
+using namespace std;
+
+namespace hullcore {
+
+namespace {
+
+// Candidates are kept as structure-of-arrays so the farthest point search and
+// the split classification stream straight through x/y with vector loads.
+// Survivors of each split are compacted in place: the left group slides to the
+// front, the right group goes through the spill buffers and lands behind it.
+struct SoaState {
+    SimdLevel level;
+    // Bounding box of all points, for the error bound of the distances.
+    Point2 low;
+    Point2 high;
+    vector<float> x;
+    vector<float> y;
+    vector<size_t> index;
+    vector<uint8_t> sides;
+    vector<float> spillX;
+    vector<float> spillY;
+    vector<size_t> spillIndex;
+};
+
+// The kernel's pick stands when every other point trails it by more than both
+// their rounding errors. Otherwise, including when all candidates lie within
+// rounding error of a -> b, the points that might still beat it are ranked
+// again exactly, as a point that is not the true farthest can lie inside the
+// hull.
+FarthestPoint farthestExact(const SoaState& state, const float* x, const float* y, size_t count, Point2 a, Point2 b,
+    FarthestPoint farthest)
+{
+    LineOrientation line(a, b, state.low, state.high);
+    double window = 2 * line.ErrorBound();
+    if (farthest.distance > window && farthest.runnerUp < farthest.distance - window)
+        return farthest;
+
+    double threshold = farthest.distance - window;
+    double dx = double(b.x) - a.x;
+    double dy = double(b.y) - a.y;
+    FarthestPoint best{ 0, 0, 0 };
+    bool found = false;
+    for (size_t i = 0; i < count; i++) {
+        Point2 point = { x[i], y[i] };
+        double distance = -((double(point.y) - a.y) * dx - dy * (double(point.x) - a.x));
+        if (distance >= threshold && (!found || isFartherExact(a, b, point, { x[best.position], y[best.position] }))) {
+            best.position = i;
+            found = true;
+        }
+    }
+    if (found)
+        best.distance = -line({ x[best.position], y[best.position] });
+    return best;
+}
+
+// p1 and p2 travel with their coordinates, so the recursion never looks at
+// the caller's input layout.
+void quickHull(SoaState& state, size_t p1, Point2 a, size_t p2, Point2 b, size_t begin, size_t end, vector<size_t>& out)
+{
+    if (begin == end)
+        return;
+
+    size_t count = end - begin;
+    float* x = state.x.data() + begin;
+    float* y = state.y.data() + begin;
+    size_t* index = state.index.data() + begin;
+
+    FarthestPoint farthest = farthestExact(state, x, y, count, a, b, FindFarthest(x, y, count, a, b, state.level));
+    if (farthest.distance <= 0)
+        return;
+
+    size_t p = index[farthest.position];
+    Point2 c = { x[farthest.position], y[farthest.position] };
+    ClassifySplit(x, y, count, a, c, b, state.sides.data(), state.level);
+
+    size_t leftCount = 0;
+    size_t rightCount = 0;
+    for (size_t i = 0; i < count; i++) {
+        uint8_t side = state.sides[i];
+        if (side == SPLIT_LEFT) {
+            x[leftCount] = x[i];
+            y[leftCount] = y[i];
+            index[leftCount] = index[i];
+            leftCount++;
+        }
+        else if (side == SPLIT_RIGHT) {
+            state.spillX[rightCount] = x[i];
+            state.spillY[rightCount] = y[i];
+            state.spillIndex[rightCount] = index[i];
+            rightCount++;
+        }
+    }
+    std::copy(state.spillX.begin(), state.spillX.begin() + rightCount, x + leftCount);
+    std::copy(state.spillY.begin(), state.spillY.begin() + rightCount, y + leftCount);
+    std::copy(state.spillIndex.begin(), state.spillIndex.begin() + rightCount, index + leftCount);
+
+    size_t leftEnd = begin + leftCount;
+    quickHull(state, p1, a, p, c, begin, leftEnd, out);
+    out.push_back(p);
+    quickHull(state, p, c, p2, b, leftEnd, leftEnd + rightCount, out);
+}
+
+bool lexicographicLess(const Point2& a, const Point2& b)
+{
+    return a.x < b.x || (a.x == b.x && a.y < b.y);
+}
+
+// Reads the input through at(i), so interleaved and split coordinate arrays
+// share the whole algorithm.
+template <class PointAt>
+void calculateHull(PointAt at, size_t count, vector<size_t>& hullIndices, SimdLevel level)
+{
+    hullIndices.clear();
+    if (count == 0) {
+        return;
+    }
+
+    size_t leftMostPoint = 0;
+    size_t rightMostPoint = 0;
+    float lowY = at(0).y;
+    float highY = lowY;
+    for (size_t i = 0; i < count; i++) {
+        Point2 point = at(i);
+        if (lexicographicLess(point, at(leftMostPoint)))
+            leftMostPoint = i;
+        if (lexicographicLess(at(rightMostPoint), point))
+            rightMostPoint = i;
+        lowY = min(lowY, point.y);
+        highY = max(highY, point.y);
+    }
+
+    hullIndices.push_back(leftMostPoint);
+    const Point2 left = at(leftMostPoint);
+    const Point2 right = at(rightMostPoint);
+    if (right == left) {
+        return;
+    }
+
+    SoaState state;
+    state.level = level;
+    state.low = { left.x, lowY };
+    state.high = { right.x, highY };
+    state.x.resize(count);
+    state.y.resize(count);
+    state.index.resize(count);
+
+    // Lower candidates fill the buffers from the front, upper ones from the back.
+    size_t lowerCount = 0;
+    size_t upperBegin = count;
+    for (size_t i = 0; i < count; i++) {
+        Point2 point = at(i);
+        int side = findSide(left, right, point);
+        size_t slot;
+        if (side < 0)
+            slot = lowerCount++;
+        else if (side > 0)
+            slot = --upperBegin;
+        else
+            continue;
+        state.x[slot] = point.x;
+        state.y[slot] = point.y;
+        state.index[slot] = i;
+    }
+
+    size_t largest = max(lowerCount, count - upperBegin);
+    state.sides.resize(largest);
+    state.spillX.resize(largest);
+    state.spillY.resize(largest);
+    state.spillIndex.resize(largest);
+
+    quickHull(state, leftMostPoint, left, rightMostPoint, right, 0, lowerCount, hullIndices);
+    hullIndices.push_back(rightMostPoint);
+    quickHull(state, rightMostPoint, right, leftMostPoint, left, upperBegin, count, hullIndices);
+}
+
+}
+
+void CalculateSimdQuickHull(const Point2* points, size_t count, vector<size_t>& hullIndices, SimdLevel level)
+{
+    calculateHull([points](size_t i) { return points[i]; }, count, hullIndices, level);
+}
+
+void CalculateSimdQuickHull(const float* x, const float* y, size_t count, vector<size_t>& hullIndices, SimdLevel level)
+{
+    calculateHull([x, y](size_t i) { return Point2{ x[i], y[i] }; }, count, hullIndices, level);
+}
+
+}
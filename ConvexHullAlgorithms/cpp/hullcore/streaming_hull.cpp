@@ -0,0 +1,127 @@
+#include "streaming_hull.h"
+
+#include <algorithm>
+#include <cstdio>
+#include <future>
+#include <vector>
+
+#include "mapped_file.h"
+
+using namespace std;
+
+namespace hullcore {
+
+StreamingHull::StreamingHull(HullEngine engine, HullOptions options)
+    : engine(engine), options(options)
+{
+}
+
+void StreamingHull::Add(const Point2* points, size_t count)
+{
+    if (count == 0) {
+        return;
+    }
+
+    CalculateHull(points, count, chunkHull, engine, options);
+
+    // The running hull and the chunk hull are both small, so their union is
+    // simply re-hulled.
+    mergePoints.assign(vertices.begin(), vertices.end());
+    mergeIndices.assign(indices.begin(), indices.end());
+    for (size_t index : chunkHull) {
+        mergePoints.push_back(points[index]);
+        mergeIndices.push_back(pointCount + index);
+    }
+    CalculateHull(mergePoints.data(), mergePoints.size(), mergedHull, HullEngine::MonotoneChain);
+
+    vertices.clear();
+    indices.clear();
+    for (size_t index : mergedHull) {
+        vertices.push_back(mergePoints[index]);
+        indices.push_back(mergeIndices[index]);
+    }
+    pointCount += count;
+}
+
+void StreamingHull::Reset()
+{
+    vertices.clear();
+    indices.clear();
+    pointCount = 0;
+}
+
+namespace {
+
+bool streamRead(const char* path, size_t chunkPoints, StreamingHull& hull)
+{
+    FILE* file = fopen(path, "rb");
+    if (!file) {
+        return false;
+    }
+
+    vector<Point2> buffers[2] = { vector<Point2>(chunkPoints), vector<Point2>(chunkPoints) };
+    bool partial = false;
+    auto readChunk = [&](Point2* buffer) {
+        size_t bytes = fread(buffer, 1, chunkPoints * sizeof(Point2), file);
+        partial = partial || bytes % sizeof(Point2) != 0;
+        return bytes / sizeof(Point2);
+    };
+
+    // Only one read is ever in flight, so the FILE is never used concurrently.
+    int current = 0;
+    future<size_t> pending = async(launch::async, readChunk, buffers[current].data());
+    while (true) {
+        size_t count = pending.get();
+        if (count == 0)
+            break;
+        pending = async(launch::async, readChunk, buffers[1 - current].data());
+        hull.Add(buffers[current].data(), count);
+        current = 1 - current;
+    }
+
+    bool complete = !partial && !ferror(file);
+    fclose(file);
+    return complete;
+}
+
+bool streamMap(const char* path, size_t chunkPoints, StreamingHull& hull)
+{
+    MappedFile file;
+    if (!file.Open(path)) {
+        return false;
+    }
+    if (file.Size() % sizeof(Point2) != 0) {
+        return false;
+    }
+
+    // Views have to start on the mapping granularity.
+    size_t granularity = MappedFile::Granularity();
+    size_t chunkBytes = chunkPoints * sizeof(Point2);
+    chunkBytes = max(granularity, chunkBytes / granularity * granularity);
+
+    for (uint64_t offset = 0; offset < file.Size(); offset += chunkBytes) {
+        size_t length = size_t(min<uint64_t>(chunkBytes, file.Size() - offset));
+        if (offset + length < file.Size()) {
+            file.Prefetch(offset + length, size_t(min<uint64_t>(chunkBytes, file.Size() - offset - length)));
+        }
+        const void* view = file.MapView(offset, length);
+        if (!view) {
+            return false;
+        }
+        hull.Add(static_cast<const Point2*>(view), length / sizeof(Point2));
+    }
+    return true;
+}
+
+}
+
+bool StreamFileHull(const char* path, const StreamingOptions& options, StreamingHull& hull)
+{
+    size_t chunkPoints = max<size_t>(options.chunkPoints, 1);
+    if (options.source == StreamSource::Map) {
+        return streamMap(path, chunkPoints, hull);
+    }
+    return streamRead(path, chunkPoints, hull);
+}
+
+}
@@ -0,0 +1,62 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+#include "hull.h"
+#include "point.h"
+
+namespace hullcore {
+
+// Hull of a point stream too large to hold at once. Every chunk passed to
+// Add is reduced to its own hull, which is merged into the running hull, so
+// only O(h) state is kept between chunks.
+class StreamingHull {
+public:
+    explicit StreamingHull(HullEngine engine = HullEngine::QuickHull, HullOptions options = HullOptions());
+
+    void Add(const Point2* points, size_t count);
+    void Reset();
+
+    // Counter-clockwise from the lowest of the leftmost points, as CalculateHull.
+    const std::vector<Point2>& Vertices() const { return vertices; }
+
+    // Position of each vertex in the stream, counting every point ever added.
+    const std::vector<uint64_t>& Indices() const { return indices; }
+
+    uint64_t PointCount() const { return pointCount; }
+
+private:
+    HullEngine engine;
+    HullOptions options;
+    std::vector<Point2> vertices;
+    std::vector<uint64_t> indices;
+    uint64_t pointCount = 0;
+
+    std::vector<size_t> chunkHull;
+    std::vector<Point2> mergePoints;
+    std::vector<uint64_t> mergeIndices;
+    std::vector<size_t> mergedHull;
+};
+
+enum class StreamSource {
+    // Two buffers filled by plain reads, the next one on a background thread
+    // while the current one is processed.
+    Read,
+    // One mapped view per chunk, with the following chunk prefetched.
+    Map,
+};
+
+struct StreamingOptions {
+    size_t chunkPoints = size_t(1) << 20;
+    StreamSource source = StreamSource::Read;
+};
+
+// Feeds a raw point file, consecutive native-endian float32 x, y pairs, through
+// hull chunk by chunk. Memory use is O(chunkPoints + h) whatever the file
+// size. Returns false if the file cannot be read or is not a whole number of
+// points.
+bool StreamFileHull(const char* path, const StreamingOptions& options, StreamingHull& hull);
+
+}
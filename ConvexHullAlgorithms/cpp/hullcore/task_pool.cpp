@@ -0,0 +1,153 @@
+#include "task_pool.h"
+
+using namespace std;
+
+namespace hullcore {
+
+namespace {
+
+thread_local const TaskPool* currentPool = nullptr;
+thread_local size_t currentIndex = 0;
+
+}
+
+TaskPool::TaskPool(unsigned threadCount)
+{
+    if (threadCount == 0) {
+        threadCount = max(1u, thread::hardware_concurrency());
+    }
+
+    // The extra queue at the end takes submissions from threads outside the pool.
+    for (unsigned i = 0; i <= threadCount; i++) {
+        queues.push_back(make_unique<Queue>());
+    }
+    for (unsigned i = 0; i < threadCount; i++) {
+        workers.emplace_back([this, i] { workerLoop(i); });
+    }
+}
+
+TaskPool::~TaskPool()
+{
+    {
+        lock_guard<mutex> guard(sleepLock);
+        stopping = true;
+    }
+    wake.notify_all();
+    for (thread& worker : workers) {
+        worker.join();
+    }
+}
+
+TaskPool& TaskPool::Default()
+{
+    static TaskPool pool;
+    return pool;
+}
+
+size_t TaskPool::currentQueue() const
+{
+    return currentPool == this ? currentIndex : workers.size();
+}
+
+void TaskPool::push(function<void()> task)
+{
+    queued++;
+    Queue& queue = *queues[currentQueue()];
+    {
+        lock_guard<mutex> guard(queue.lock);
+        queue.tasks.push_back(std::move(task));
+    }
+    {
+        lock_guard<mutex> guard(sleepLock);
+    }
+    wake.notify_one();
+}
+
+bool TaskPool::runOne()
+{
+    size_t self = currentQueue();
+    function<void()> task;
+
+    {
+        Queue& own = *queues[self];
+        lock_guard<mutex> guard(own.lock);
+        if (!own.tasks.empty()) {
+            task = std::move(own.tasks.back());
+            own.tasks.pop_back();
+        }
+    }
+
+    for (size_t i = 1; !task && i < queues.size(); i++) {
+        Queue& victim = *queues[(self + i) % queues.size()];
+        lock_guard<mutex> guard(victim.lock);
+        if (!victim.tasks.empty()) {
+            task = std::move(victim.tasks.front());
+            victim.tasks.pop_front();
+        }
+    }
+
+    if (!task) {
+        return false;
+    }
+    queued--;
+    task();
+    return true;
+}
+
+void TaskPool::workerLoop(size_t index)
+{
+    currentPool = this;
+    currentIndex = index;
+
+    while (true) {
+        if (runOne()) {
+            continue;
+        }
+        unique_lock<mutex> guard(sleepLock);
+        wake.wait(guard, [this] { return stopping || queued > 0; });
+        if (stopping && queued == 0) {
+            return;
+        }
+    }
+}
+
+void TaskPool::ParallelFor(size_t begin, size_t end, size_t grain, const function<void(size_t, size_t)>& body)
+{
+    if (grain == 0) {
+        grain = 1;
+    }
+    if (end - begin <= grain) {
+        if (begin < end) {
+            body(begin, end);
+        }
+        return;
+    }
+
+    TaskGroup group(*this);
+    for (size_t chunk = begin + grain; chunk < end; chunk += grain) {
+        size_t chunkEnd = min(end, chunk + grain);
+        group.Run([&body, chunk, chunkEnd] { body(chunk, chunkEnd); });
+    }
+    body(begin, begin + grain);
+    group.Wait();
+}
+
+void TaskGroup::Run(function<void()> task)
+{
+    pending++;
+    pool.push([this, task = std::move(task)] {
+        task();
+        pending--;
+    });
+}
+
+void TaskGroup::Wait()
+{
+    while (pending > 0) {
+        if (!pool.runOne()) {
+            this_thread::yield();
+        }
+    }
+}
+
+}
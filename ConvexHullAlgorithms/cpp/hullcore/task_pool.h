@@ -0,0 +1,73 @@
+#pragma once
+
+#include <atomic>
+#include <condition_variable>
+#include <cstddef>
+#include <deque>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+namespace hullcore {
+
+// Work-stealing pool for fork-join style recursion. Every worker owns a deque
+// it pushes to and pops from at the back; idle workers and threads waiting on
+// a TaskGroup steal from the front of the other deques.
+class TaskPool {
+public:
+    explicit TaskPool(unsigned threadCount = 0);
+    ~TaskPool();
+
+    TaskPool(const TaskPool&) = delete;
+    TaskPool& operator=(const TaskPool&) = delete;
+
+    static TaskPool& Default();
+
+    unsigned ThreadCount() const { return static_cast<unsigned>(workers.size()); }
+
+    // Calls body(chunkBegin, chunkEnd) for consecutive chunks of exactly grain
+    // elements (the last one may be shorter) and returns once all are done.
+    void ParallelFor(size_t begin, size_t end, size_t grain, const std::function<void(size_t, size_t)>& body);
+
+private:
+    friend class TaskGroup;
+
+    struct Queue {
+        std::mutex lock;
+        std::deque<std::function<void()>> tasks;
+    };
+
+    void push(std::function<void()> task);
+    bool runOne();
+    size_t currentQueue() const;
+    void workerLoop(size_t index);
+
+    std::vector<std::unique_ptr<Queue>> queues;
+    std::vector<std::thread> workers;
+    std::atomic<size_t> queued{ 0 };
+    std::mutex sleepLock;
+    std::condition_variable wake;
+    bool stopping = false;
+};
+
+// Tasks spawned through a group can be waited on together; the waiting thread
+// keeps executing pool work instead of blocking, so groups may nest freely.
+class TaskGroup {
+public:
+    explicit TaskGroup(TaskPool& pool) : pool(pool) { }
+    ~TaskGroup() { Wait(); }
+
+    TaskGroup(const TaskGroup&) = delete;
+    TaskGroup& operator=(const TaskGroup&) = delete;
+
+    void Run(std::function<void()> task);
+    void Wait();
+
+private:
+    TaskPool& pool;
+    std::atomic<size_t> pending{ 0 };
+};
+
+}
@@ -14,6 +14,8 @@ using namespace std;
 #pragma comment(lib, "dwrite.lib") 
 
 #include "basewin.h"
+#include "scene/picker.h"
+#include "scene/shapes.h"
 
 template <class T> void SafeRelease(T** ppT)
 {
@@ -53,391 +55,72 @@ static int GetRandomNumber(int min, int max) {
 float DPIScale::scaleX = 1.0f;
 float DPIScale::scaleY = 1.0f;
 
+// Canvas over the window's render target: the one brush is recolored for
+// every call, and text goes through the window's text format.
+class D2dCanvas : public Canvas
+{
+    ID2D1RenderTarget* pRenderTarget;
+    ID2D1SolidColorBrush* pBrush;
+    IDWriteTextFormat* pTextFormat;
 
-enum AppState { QUICK_HULL, POINT_CONVEX_HULL, GJK, M_SUM, M_DIFF, NONE };
-static AppState currentAppState;
-
-struct Shape {
-
-    AppState targetAppState = NONE;
-
-    virtual void Draw(ID2D1RenderTarget* pRenderTarget, ID2D1SolidColorBrush* pBrush) = 0;
-
-    virtual void WriteText(
-        ID2D1RenderTarget* pRenderTarget,
-        ID2D1SolidColorBrush* pBrush,
-        IDWriteTextFormat* pTextFormat) { };
-
-    virtual bool IsMouseOverlapping(float mousePosX, float mousePosY) { return 0; };
-
-    virtual void OnMouseClick(float x, float y) { };
-
-    virtual void OnMouseDrag(float x, float y) { };
-};
-
-struct Grid : Shape {
-
-    float lineSpacing;
-    float gridLinesStrokeWidth;
-    float axisLinesStrokeWidth;
-    D2D1_COLOR_F gridLinesColor;
-    D2D1_COLOR_F axisLinesColor;
-
-    void Draw(ID2D1RenderTarget* pRenderTarget, ID2D1SolidColorBrush* pBrush) {
-        D2D1_SIZE_F rtSize = pRenderTarget->GetSize();
-        float centerX = rtSize.width / 2;
-        float centerY = rtSize.height / 2;
-        pBrush->SetColor(gridLinesColor);
-        for (float x = centerX; x < rtSize.width; x += lineSpacing)
-        {
-            pRenderTarget->DrawLine(
-                D2D1::Point2F(x, 0.0f),
-                D2D1::Point2F(x, rtSize.height),
-                pBrush,
-                gridLinesStrokeWidth
-            );
-        }
-        for (float x = centerX; x > 0; x -= lineSpacing)
-        {
-            pRenderTarget->DrawLine(
-                D2D1::Point2F(x, 0.0f),
-                D2D1::Point2F(x, rtSize.height),
-                pBrush,
-                gridLinesStrokeWidth
-            );
-        }
-        for (float y = centerY; y < rtSize.height; y += lineSpacing)
-        {
-            pRenderTarget->DrawLine(
-                D2D1::Point2F(0.0f, y),
-                D2D1::Point2F(rtSize.width, y),
-                pBrush,
-                gridLinesStrokeWidth
-            );
-        }
-        for (float y = centerY; y > 0; y -= lineSpacing)
-        {
-            pRenderTarget->DrawLine(
-                D2D1::Point2F(0.0f, y),
-                D2D1::Point2F(rtSize.width, y),
-                pBrush,
-                gridLinesStrokeWidth
-            );
-        }
-        pBrush->SetColor(axisLinesColor);
-        pRenderTarget->DrawLine(
-            D2D1::Point2F(centerX, 0),
-            D2D1::Point2F(centerX, rtSize.height),
-            pBrush,
-            axisLinesStrokeWidth
-        );
-        pRenderTarget->DrawLine(
-            D2D1::Point2F(0, centerY),
-            D2D1::Point2F(rtSize.width, centerY),
-            pBrush,
-            axisLinesStrokeWidth
-        );
-
-    }
-
-};
-
-struct MoveablePoint : Shape {
-
-    D2D1_POINT_2F center;
-    float radius;
-    D2D1_COLOR_F fillColor;
-
-
-    void Draw(ID2D1RenderTarget* pRenderTarget, ID2D1SolidColorBrush* pBrush) {
-        D2D1_ELLIPSE ellipse = D2D1::Ellipse(
-            center,
-            radius,
-            radius
-        );
-        pBrush->SetColor(fillColor);
-        pRenderTarget->FillEllipse(ellipse, pBrush);
-    }
-
-    void OnMouseClick() {
-        fillColor = D2D1::ColorF(D2D1::ColorF::Red);
-    }
-
-    void OnMouseDrag(float x, float y) {
-        center.x = x;
-        center.y = y;
-    }
-
-    bool IsMouseOverlapping(float x, float y) {
-        float a = (x - center.x) * (x - center.x);
-        float b = (y - center.y) * (y - center.y);
-        return a * b < radius* radius;
-    }
-
-};
-
-struct NPolygon : Shape {
-
-    vector<D2D1_POINT_2F> points;
-    D2D1_COLOR_F color;
-    float strokeWidth;
-
-    void Draw(ID2D1RenderTarget* pRenderTarget, ID2D1SolidColorBrush* pBrush) {
-        pBrush->SetColor(color);
-        for (int i = 1; i < points.size(); i++) {
-            pRenderTarget->DrawLine(points[i - 1], points[i], pBrush, strokeWidth);
-        }
-        pRenderTarget->DrawLine(points[0], points[points.size() - 1], pBrush, strokeWidth);
-    }
-
-    bool IsMouseOverlapping(float x, float y) {
-        return 0;
-    }
-
-};
-
-struct Button : Shape {
-
-    D2D1_RECT_F rectangle;
-    D2D1_COLOR_F fillColor;
-    D2D1_COLOR_F outlineColor;
-    D2D1_COLOR_F textColor;
-    string text;
-    float outlineWidth;
-    void (*onClickCallback) ();
-
-    void Draw(ID2D1RenderTarget* pRenderTarget, ID2D1SolidColorBrush* pBrush) {
-        pBrush->SetColor(outlineColor);
-        pRenderTarget->DrawRectangle(rectangle, pBrush, outlineWidth);
-        pBrush->SetColor(fillColor);
-        pRenderTarget->FillRectangle(rectangle, pBrush);
-    }
-
-    void WriteText(
-        ID2D1RenderTarget* pRenderTarget,
-        ID2D1SolidColorBrush* pBrush,
-        IDWriteTextFormat* pTextFormat) {
-
-        std::wstring widestr = std::wstring(text.begin(), text.end());
-        const wchar_t* widecstr = widestr.c_str();
-
-        pBrush->SetColor(textColor);
-        pRenderTarget->DrawTextW(
-            widecstr,
-            text.size(),
-            pTextFormat,
-            rectangle,
-            pBrush
-        );
-    };
-
-    void OnMouseClick(float x, float y) {
-        onClickCallback();
+    static D2D1_COLOR_F ToD2d(Color color)
+    {
+        return D2D1::ColorF(color.r, color.g, color.b, color.a);
     }
 
-    bool IsMouseOverlapping(float x, float y) {
-        return x < rectangle.right&& x > rectangle.left && y > rectangle.top && y < rectangle.bottom;
+    static D2D1_RECT_F ToD2d(const Rect& rect)
+    {
+        return D2D1::RectF(rect.left, rect.top, rect.right, rect.bottom);
     }
 
-};
-
-struct QuickHull : Shape {
-
-    vector<MoveablePoint*> points;
-    vector<MoveablePoint*> hullPoints;
-
-    void Draw(ID2D1RenderTarget* pRenderTarget, ID2D1SolidColorBrush* pBrush) {
-        CalculateHull();
-
-        for (int i = 1; i < hullPoints.size(); i++) {
-
-            MoveablePoint* pointA = hullPoints[i - 1];
-            MoveablePoint* pointB = hullPoints[i];
-            pBrush->SetColor(pointA->fillColor);
-            pRenderTarget->DrawLine(pointA->center, pointB->center, pBrush, 2.0f);
-        }
-        pRenderTarget->DrawLine(hullPoints[hullPoints.size() - 1]->center, hullPoints[0]->center, pBrush, 2.0f);
-
+public:
+    D2dCanvas(ID2D1RenderTarget* pRenderTarget, ID2D1SolidColorBrush* pBrush, IDWriteTextFormat* pTextFormat)
+        : pRenderTarget(pRenderTarget), pBrush(pBrush), pTextFormat(pTextFormat)
+    {
     }
 
-    void CalculateHull() {
-        hullPoints.clear();
-        MoveablePoint* leftMostPoint = points[0];
-        MoveablePoint* rightMostPoint = points[0];
-
-        for (int i = 0; i < points.size(); i++) {
-            MoveablePoint* pt = points[i];
-            if (pt->center.x < leftMostPoint->center.x)
-                leftMostPoint = pt;
-            if (pt->center.x > rightMostPoint->center.x)
-                rightMostPoint = pt;
-        }
-
-        hullPoints.push_back(leftMostPoint);
-        hullPoints.push_back(rightMostPoint);
+    float Width() const override { return pRenderTarget->GetSize().width; }
+    float Height() const override { return pRenderTarget->GetSize().height; }
 
-        quickHull(leftMostPoint, rightMostPoint, 1);
-        quickHull(leftMostPoint, rightMostPoint, -1);
-
-        std::sort(hullPoints.begin(), hullPoints.end(),
-            [&](MoveablePoint* a, MoveablePoint* b) -> bool
-            {
-                float slopeA = (a->center.y - leftMostPoint->center.y) / (a->center.x - leftMostPoint->center.x);
-                float slopeB = (b->center.y - leftMostPoint->center.y) / (b->center.x - leftMostPoint->center.x);
-                return slopeA < slopeB;
-            });
-
-    }
-
-    void quickHull(MoveablePoint* p1, MoveablePoint* p2, int side)
+    void Clear(Color color) override
     {
-        MoveablePoint* p = nullptr;
-        int maxDistance = 0;
-
-        for (int i = 0; i < points.size(); i++)
-        {
-            int distance = abs(signedLineDist(p1, p2, points[i]));
-            if (findSide(p1, p2, points[i]) == side && distance > maxDistance)
-            {
-                p = points[i];
-                maxDistance = distance;
-            }
-        }
-
-        if (p == nullptr)
-        {
-            if (std::count(hullPoints.begin(), hullPoints.end(), p1) == 0) {
-                hullPoints.push_back(p1);
-            }
-            if (std::count(hullPoints.begin(), hullPoints.end(), p2) == 0) {
-                hullPoints.push_back(p2);
-            }
-            return;
-        }
-
-        quickHull(p, p1, -findSide(p, p1, p2));
-        quickHull(p, p2, -findSide(p, p2, p1));
+        pRenderTarget->Clear(ToD2d(color));
     }
 
-    int findSide(MoveablePoint* p1, MoveablePoint* p2, MoveablePoint* pTest)
+    void DrawLine(hullcore::Point2 from, hullcore::Point2 to, Color color, float strokeWidth) override
     {
-        int d = signedLineDist(p1, p2, pTest);
-
-        if (d > 0)
-            return 1;
-        if (d < 0)
-            return -1;
-        return 0;
+        pBrush->SetColor(ToD2d(color));
+        pRenderTarget->DrawLine(D2D1::Point2F(from.x, from.y), D2D1::Point2F(to.x, to.y), pBrush, strokeWidth);
     }
 
-    int signedLineDist(MoveablePoint* p1, MoveablePoint* p2, MoveablePoint* pTest)
+    void FillEllipse(hullcore::Point2 center, float radiusX, float radiusY, Color color) override
     {
-        return (pTest->center.y - p1->center.y) * (p2->center.x - p1->center.x) -
-            (p2->center.y - p1->center.y) * (pTest->center.x - p1->center.x);
-    }
-
-};
-
-
-struct PointConvexHull : Shape {
-
-    QuickHull hull;
-    MoveablePoint* point;
-    D2D1_COLOR_F inColor;
-    D2D1_COLOR_F outColor;
-
-    void Draw(ID2D1RenderTarget* pRenderTarget, ID2D1SolidColorBrush* pBrush) {
-        if (isPointInside()) {
-            point->fillColor = inColor;
-        }
-        else {
-            point->fillColor = outColor;
-        }
-        hull.Draw(pRenderTarget, pBrush);
-
+        pBrush->SetColor(ToD2d(color));
+        pRenderTarget->FillEllipse(D2D1::Ellipse(D2D1::Point2F(center.x, center.y), radiusX, radiusY), pBrush);
     }
 
-    bool isPointInside() {
-
-        hull.points.push_back(point);
-        hull.CalculateHull();
-        bool isPartOfHull = std::count(hull.hullPoints.begin(), hull.hullPoints.end(), point) > 0;
-
-        hull.points.erase(std::remove(hull.points.begin(), hull.points.end(), point), hull.points.end());
-        hull.hullPoints.erase(std::remove(hull.hullPoints.begin(), hull.hullPoints.end(), point), hull.hullPoints.end());
-
-        return !isPartOfHull;
+    void DrawRectangle(const Rect& rect, Color color, float strokeWidth) override
+    {
+        pBrush->SetColor(ToD2d(color));
+        pRenderTarget->DrawRectangle(ToD2d(rect), pBrush, strokeWidth);
     }
 
-};
-
-struct MinkowskiSum : Shape {
-
-    QuickHull* hull1;
-    QuickHull* hull2;
-    QuickHull* result;
-    D2D1_COLOR_F resultColor;
-
-    void Draw(ID2D1RenderTarget* pRenderTarget, ID2D1SolidColorBrush* pBrush) {
-
-        hull1->Draw(pRenderTarget, pBrush);
-        hull2->Draw(pRenderTarget, pBrush);
-        CalculateSum();
-        result->Draw(pRenderTarget, pBrush);
+    void FillRectangle(const Rect& rect, Color color) override
+    {
+        pBrush->SetColor(ToD2d(color));
+        pRenderTarget->FillRectangle(ToD2d(rect), pBrush);
     }
 
-    void CalculateSum() {
-        result->hullPoints.clear();
-        for (int i = 0; i < hull1->hullPoints.size(); i++) {
-            MoveablePoint* point1 = hull1->hullPoints[i];
-            for (int k = 0; k < hull2->hullPoints.size(); k++) {
-                MoveablePoint* point2 = hull2->hullPoints[k];
-                MoveablePoint* newPoint = new MoveablePoint();
-                float pointsXAdded = point1->center.x + point2->center.x;
-                float pointsYAdded = point1->center.y + point2->center.y;
-                newPoint->center = D2D1::Point2F(pointsXAdded, pointsYAdded);
-                newPoint->radius = 1;
-                newPoint->fillColor = D2D1::ColorF(D2D1::ColorF::Red);
-                result->points.push_back(newPoint);
-            }
-        }
+    void DrawString(const string& text, const Rect& rect, Color color) override
+    {
+        std::wstring widestr = std::wstring(text.begin(), text.end());
+        pBrush->SetColor(ToD2d(color));
+        pRenderTarget->DrawTextW(widestr.c_str(), UINT32(widestr.size()), pTextFormat, ToD2d(rect), pBrush);
     }
-
 };
 
-struct MinkowskiDifference : Shape {
 
-    QuickHull* hull1;
-    QuickHull* hull2;
-    QuickHull* result;
-    D2D1_COLOR_F resultColor;
-
-    void Draw(ID2D1RenderTarget* pRenderTarget, ID2D1SolidColorBrush* pBrush) {
-
-        hull1->Draw(pRenderTarget, pBrush);
-        hull2->Draw(pRenderTarget, pBrush);
-        CalculateDiff();
-        result->Draw(pRenderTarget, pBrush);
-    }
-
-    void CalculateDiff() {
-        result->hullPoints.clear();
-        for (int i = 0; i < hull1->hullPoints.size(); i++) {
-            MoveablePoint* point1 = hull1->hullPoints[i];
-            for (int k = 0; k < hull2->hullPoints.size(); k++) {
-                MoveablePoint* point2 = hull2->hullPoints[k];
-                MoveablePoint* newPoint = new MoveablePoint();
-                float pointsXAdded = point1->center.x - point2->center.x;
-                float pointsYAdded = point1->center.y - point2->center.y;
-                newPoint->center = D2D1::Point2F(pointsXAdded, pointsYAdded);
-                newPoint->radius = 1;
-                newPoint->fillColor = D2D1::ColorF(D2D1::ColorF::Red);
-                result->points.push_back(newPoint);
-            }
-        }
-    }
-
-};
+static AppState currentAppState;
 
 
 class MainWindow : public BaseWindow<MainWindow>
@@ -452,7 +135,9 @@ class MainWindow : public BaseWindow<MainWindow>
     IDWriteTextFormat* pTextFormat;
 
     vector<Shape*> shapes;
+    ShapePicker picker;
     Shape* selection = nullptr;
+    int selectionIndex = -1;
 
     void    CalculateLayout() { }
     HRESULT CreateGraphicsResources();
@@ -601,14 +286,11 @@ void MainWindow::OnLButtonDown(int pixelX, int pixelY, DWORD flags)
         return;
     }
 
-    for (int i = shapes.size() - 1; i >= 0; i--)
-    {
-        boolean interactable = shapes[i]->targetAppState == NONE || shapes[i]->targetAppState == currentAppState;
-        if (interactable && shapes[i]->IsMouseOverlapping(pixelX, pixelY)) {
-            selection = shapes[i];
-            shapes[i]->OnMouseClick(pixelX, pixelY);
-            break;
-        }
+    int picked = picker.Pick(pixelX, pixelY, currentAppState);
+    if (picked >= 0) {
+        selection = shapes[picked];
+        selectionIndex = picked;
+        selection->OnMouseClick(pixelX, pixelY);
     }
 
     InvalidateRect(m_hwnd, NULL, FALSE);
@@ -621,6 +303,7 @@ void MainWindow::OnMouseMove(int pixelX, int pixelY, DWORD flags)
         boolean interactable = selection->targetAppState == NONE || selection->targetAppState == currentAppState;
 
         selection->OnMouseDrag(pixelX, pixelY);
+        picker.Moved(selectionIndex);
 
         InvalidateRect(m_hwnd, NULL, FALSE);
     }
@@ -629,6 +312,7 @@ void MainWindow::OnMouseMove(int pixelX, int pixelY, DWORD flags)
 void MainWindow::OnLButtonUp()
 {
     selection = nullptr;
+    selectionIndex = -1;
     ReleaseCapture();
 }
 
@@ -720,21 +404,21 @@ void MainWindow::CreateScene() {
     Grid* grid = new Grid();
     shapes.push_back(grid);
     grid->lineSpacing = 50.0f;
-    grid->gridLinesColor = D2D1::ColorF(D2D1::ColorF::Gray);
+    grid->gridLinesColor = ColorFromRgb(D2D1::ColorF::Gray);
     grid->gridLinesStrokeWidth = 1.0f;
-    grid->axisLinesColor = D2D1::ColorF(D2D1::ColorF::White);
+    grid->axisLinesColor = ColorFromRgb(D2D1::ColorF::White);
     grid->axisLinesStrokeWidth = 2.0f;
 
 
     //Create Button
     Button* button1 = new Button();
     shapes.push_back(button1);
-    button1->fillColor = D2D1::ColorF(D2D1::ColorF::White);
-    button1->outlineColor = D2D1::ColorF(D2D1::ColorF::Red);
-    button1->textColor = D2D1::ColorF(D2D1::ColorF::Black);
+    button1->fillColor = ColorFromRgb(D2D1::ColorF::White);
+    button1->outlineColor = ColorFromRgb(D2D1::ColorF::Red);
+    button1->textColor = ColorFromRgb(D2D1::ColorF::Black);
     button1->text = "Quick Hull";
     button1->outlineWidth = 5.0f;
-    button1->rectangle = D2D1::RectF(50, 50, 200, 100);
+    button1->rectangle = { 50, 50, 200, 100 };
     button1->onClickCallback = []() {
         currentAppState = QUICK_HULL;
     };
@@ -742,12 +426,12 @@ void MainWindow::CreateScene() {
     //Create Button
     Button* button2 = new Button();
     shapes.push_back(button2);
-    button2->fillColor = D2D1::ColorF(D2D1::ColorF::White);
-    button2->outlineColor = D2D1::ColorF(D2D1::ColorF::Red);
-    button2->textColor = D2D1::ColorF(D2D1::ColorF::Black);
+    button2->fillColor = ColorFromRgb(D2D1::ColorF::White);
+    button2->outlineColor = ColorFromRgb(D2D1::ColorF::Red);
+    button2->textColor = ColorFromRgb(D2D1::ColorF::Black);
     button2->text = "Point Convex Hull";
     button2->outlineWidth = 5.0f;
-    button2->rectangle = D2D1::RectF(50, 150, 200, 200);
+    button2->rectangle = { 50, 150, 200, 200 };
     button2->onClickCallback = []() -> void {
         currentAppState = POINT_CONVEX_HULL;
     };
@@ -755,12 +439,12 @@ void MainWindow::CreateScene() {
     //Create Button
     Button* button3 = new Button();
     shapes.push_back(button3);
-    button3->fillColor = D2D1::ColorF(D2D1::ColorF::White);
-    button3->outlineColor = D2D1::ColorF(D2D1::ColorF::Red);
-    button3->textColor = D2D1::ColorF(D2D1::ColorF::Black);
+    button3->fillColor = ColorFromRgb(D2D1::ColorF::White);
+    button3->outlineColor = ColorFromRgb(D2D1::ColorF::Red);
+    button3->textColor = ColorFromRgb(D2D1::ColorF::Black);
     button3->text = "GJK";
     button3->outlineWidth = 5.0f;
-    button3->rectangle = D2D1::RectF(50, 250, 200, 300);
+    button3->rectangle = { 50, 250, 200, 300 };
     button3->onClickCallback = []() -> void {
         currentAppState = GJK;
     };
@@ -768,12 +452,12 @@ void MainWindow::CreateScene() {
     //Create Button
     Button* button4 = new Button();
     shapes.push_back(button4);
-    button4->fillColor = D2D1::ColorF(D2D1::ColorF::White);
-    button4->outlineColor = D2D1::ColorF(D2D1::ColorF::Red);
-    button4->textColor = D2D1::ColorF(D2D1::ColorF::Black);
+    button4->fillColor = ColorFromRgb(D2D1::ColorF::White);
+    button4->outlineColor = ColorFromRgb(D2D1::ColorF::Red);
+    button4->textColor = ColorFromRgb(D2D1::ColorF::Black);
     button4->text = "Minkowski Sum";
     button4->outlineWidth = 5.0f;
-    button4->rectangle = D2D1::RectF(50, 350, 200, 400);
+    button4->rectangle = { 50, 350, 200, 400 };
     button4->onClickCallback = []() -> void {
         currentAppState = M_SUM;
     };
@@ -781,12 +465,12 @@ void MainWindow::CreateScene() {
     //Create Button
     Button* button5 = new Button();
     shapes.push_back(button5);
-    button5->fillColor = D2D1::ColorF(D2D1::ColorF::White);
-    button5->outlineColor = D2D1::ColorF(D2D1::ColorF::Red);
-    button5->textColor = D2D1::ColorF(D2D1::ColorF::Black);
+    button5->fillColor = ColorFromRgb(D2D1::ColorF::White);
+    button5->outlineColor = ColorFromRgb(D2D1::ColorF::Red);
+    button5->textColor = ColorFromRgb(D2D1::ColorF::Black);
     button5->text = "Minkowski Difference";
     button5->outlineWidth = 5.0f;
-    button5->rectangle = D2D1::RectF(50, 450, 200, 500);
+    button5->rectangle = { 50, 450, 200, 500 };
     button5->onClickCallback = []() -> void {
         currentAppState = M_DIFF;
     };
@@ -802,9 +486,9 @@ void MainWindow::CreateScene() {
         D2D1_SIZE_F rtSize = pRenderTarget->GetSize();
         float randomX = GetRandomNumber(0, rtSize.width);
         float randomY = GetRandomNumber(0, rtSize.height);
-        point->center = D2D1::Point2F(randomX, randomY);
+        point->center = { randomX, randomY };
         point->radius = 20.0f;
-        point->fillColor = D2D1::ColorF(D2D1::ColorF::Blue);
+        point->fillColor = ColorFromRgb(D2D1::ColorF::Blue);
     }
     shapes.push_back(quickHull);
 
@@ -812,18 +496,46 @@ void MainWindow::CreateScene() {
     PointConvexHull* pointConvexHull = new PointConvexHull();
     pointConvexHull->targetAppState = POINT_CONVEX_HULL;
     pointConvexHull->hull = *quickHull;
-    pointConvexHull->inColor = D2D1::ColorF(D2D1::ColorF::Red);
-    pointConvexHull->outColor = D2D1::ColorF(D2D1::ColorF::Blue);
+    pointConvexHull->inColor = ColorFromRgb(D2D1::ColorF::Red);
+    pointConvexHull->outColor = ColorFromRgb(D2D1::ColorF::Blue);
     MoveablePoint* point = new MoveablePoint();
     point->targetAppState = POINT_CONVEX_HULL;
     pointConvexHull->point = point;
     D2D1_SIZE_F rtSize = pRenderTarget->GetSize();
-    point->center = D2D1::Point2F(rtSize.width / 2, rtSize.height / 2);
+    point->center = { rtSize.width / 2, rtSize.height / 2 };
     point->radius = 20.0f;
     shapes.push_back(pointConvexHull);
     shapes.push_back(point);
 
 
+    //GJK
+    GjkCollision* gjk = new GjkCollision();
+    gjk->targetAppState = GJK;
+    QuickHull* gjkHulls[2];
+    for (int h = 0; h < 2; h++) {
+        gjkHulls[h] = new QuickHull();
+        gjkHulls[h]->targetAppState = GJK;
+        for (int i = 0; i < 5; i++) {
+            MoveablePoint* point = new MoveablePoint();
+            gjkHulls[h]->points.push_back(point);
+            point->targetAppState = GJK;
+            D2D1_SIZE_F rtSize = pRenderTarget->GetSize();
+            float randomX = GetRandomNumber(0, rtSize.width);
+            float randomY = GetRandomNumber(0, rtSize.height);
+            point->center = { randomX, randomY };
+            point->radius = 20.0f;
+            point->fillColor = ColorFromRgb(D2D1::ColorF::Blue);
+            shapes.push_back(point);
+        }
+    }
+    gjk->hull1 = gjkHulls[0];
+    gjk->hull2 = gjkHulls[1];
+    gjk->separatedColor = ColorFromRgb(D2D1::ColorF::Blue);
+    gjk->collidingColor = ColorFromRgb(D2D1::ColorF::Red);
+
+    shapes.push_back(gjk);
+
+
     //Minkowski Sum
     MinkowskiSum* mSum = new MinkowskiSum();
     mSum->targetAppState = M_SUM;
@@ -837,9 +549,9 @@ void MainWindow::CreateScene() {
         D2D1_SIZE_F rtSize = pRenderTarget->GetSize();
         float randomX = GetRandomNumber(0, rtSize.width);
         float randomY = GetRandomNumber(0, rtSize.height);
-        point->center = D2D1::Point2F(randomX, randomY);
+        point->center = { randomX, randomY };
         point->radius = 20.0f;
-        point->fillColor = D2D1::ColorF(D2D1::ColorF::Blue);
+        point->fillColor = ColorFromRgb(D2D1::ColorF::Blue);
         shapes.push_back(point);
     }
     QuickHull* quickHull2 = new QuickHull();
@@ -851,15 +563,14 @@ void MainWindow::CreateScene() {
         D2D1_SIZE_F rtSize = pRenderTarget->GetSize();
         float randomX = GetRandomNumber(0, rtSize.width);
         float randomY = GetRandomNumber(0, rtSize.height);
-        point->center = D2D1::Point2F(randomX, randomY);
+        point->center = { randomX, randomY };
         point->radius = 20.0f;
-        point->fillColor = D2D1::ColorF(D2D1::ColorF::Blue);
+        point->fillColor = ColorFromRgb(D2D1::ColorF::Blue);
         shapes.push_back(point);
     }
-    QuickHull* resultHull = new QuickHull();
     mSum->hull1 = quickHull1;
     mSum->hull2 = quickHull2;
-    mSum->result = resultHull;
+    mSum->resultColor = ColorFromRgb(D2D1::ColorF::Red);
 
     shapes.push_back(mSum);
 
@@ -876,9 +587,9 @@ void MainWindow::CreateScene() {
         D2D1_SIZE_F rtSize = pRenderTarget->GetSize();
         float randomX = GetRandomNumber(0, rtSize.width);
         float randomY = GetRandomNumber(0, rtSize.height);
-        point->center = D2D1::Point2F(randomX, randomY);
+        point->center = { randomX, randomY };
         point->radius = 20.0f;
-        point->fillColor = D2D1::ColorF(D2D1::ColorF::Blue);
+        point->fillColor = ColorFromRgb(D2D1::ColorF::Blue);
         shapes.push_back(point);
     }
     QuickHull* quickHull4 = new QuickHull();
@@ -890,26 +601,27 @@ void MainWindow::CreateScene() {
         D2D1_SIZE_F rtSize = pRenderTarget->GetSize();
         float randomX = GetRandomNumber(0, rtSize.width);
         float randomY = GetRandomNumber(0, rtSize.height);
-        point->center = D2D1::Point2F(randomX, randomY);
+        point->center = { randomX, randomY };
         point->radius = 20.0f;
-        point->fillColor = D2D1::ColorF(D2D1::ColorF::Blue);
+        point->fillColor = ColorFromRgb(D2D1::ColorF::Blue);
         shapes.push_back(point);
     }
-    QuickHull* resultHull2 = new QuickHull();
     mDiff->hull1 = quickHull3;
     mDiff->hull2 = quickHull4;
-    mDiff->result = resultHull2;
+    mDiff->resultColor = ColorFromRgb(D2D1::ColorF::Red);
 
     shapes.push_back(mDiff);
 
+    picker.Build(shapes);
 }
 
 void MainWindow::UpdateScene() {
+    D2dCanvas canvas(pRenderTarget, pBrush, pTextFormat);
     for each (Shape * shape in shapes)
     {
         if (shape->targetAppState == NONE || shape->targetAppState == currentAppState) {
-            shape->Draw(pRenderTarget, pBrush);
-            shape->WriteText(pRenderTarget, pBrush, pTextFormat);
+            shape->Draw(canvas);
+            shape->WriteText(canvas);
         }
     }
 }
@@ -0,0 +1,49 @@
+#pragma once
+
+#include <cstdint>
+#include <string>
+
+#include "hullcore/point.h"
+
+// Same layout as D2D1_COLOR_F: straight (not premultiplied) alpha, every
+// channel in [0, 1].
+struct Color {
+    float r;
+    float g;
+    float b;
+    float a;
+};
+
+// Color from a 0xRRGGBB value, so D2D1::ColorF's named colors carry over.
+inline Color ColorFromRgb(uint32_t rgb, float alpha = 1.0f)
+{
+    return { ((rgb >> 16) & 0xff) / 255.0f, ((rgb >> 8) & 0xff) / 255.0f, (rgb & 0xff) / 255.0f, alpha };
+}
+
+// Same layout as D2D1_RECT_F.
+struct Rect {
+    float left;
+    float top;
+    float right;
+    float bottom;
+};
+
+// Everything the shapes draw with, in device-independent pixels with y
+// pointing down. Strokes are centered on the geometry and have flat ends,
+// as in Direct2D, so every backend draws the same picture.
+class Canvas {
+public:
+    virtual ~Canvas() { }
+
+    virtual float Width() const = 0;
+    virtual float Height() const = 0;
+
+    virtual void Clear(Color color) = 0;
+    virtual void DrawLine(hullcore::Point2 from, hullcore::Point2 to, Color color, float strokeWidth) = 0;
+    virtual void FillEllipse(hullcore::Point2 center, float radiusX, float radiusY, Color color) = 0;
+    virtual void DrawRectangle(const Rect& rect, Color color, float strokeWidth) = 0;
+    virtual void FillRectangle(const Rect& rect, Color color) = 0;
+
+    // Centered in rect on both axes.
+    virtual void DrawString(const std::string& text, const Rect& rect, Color color) = 0;
+};
@@ -0,0 +1,62 @@
+#include "scene/picker.h"
+
+using namespace std;
+using hullcore::PointGrid;
+
+ShapePicker::ShapePicker(float cellSize)
+{
+    for (PointGrid& grid : grids) {
+        grid = PointGrid(cellSize);
+    }
+}
+
+void ShapePicker::Build(const vector<Shape*>& shapes)
+{
+    for (PointGrid& grid : grids) {
+        grid.Clear();
+    }
+    points.assign(shapes.size(), nullptr);
+    others.clear();
+    for (size_t i = 0; i < shapes.size(); i++) {
+        MoveablePoint* point = dynamic_cast<MoveablePoint*>(shapes[i]);
+        if (point) {
+            points[i] = point;
+            grids[point->targetAppState].Insert(uint32_t(i), point->center, point->radius);
+        }
+        else {
+            others.push_back({ int(i), shapes[i] });
+        }
+    }
+}
+
+int ShapePicker::Pick(float x, float y, AppState state) const
+{
+    int picked = -1;
+    uint32_t id = grids[state].Pick({ x, y });
+    if (id != PointGrid::None) {
+        picked = int(id);
+    }
+    if (state != NONE) {
+        id = grids[NONE].Pick({ x, y });
+        if (id != PointGrid::None && int(id) > picked) {
+            picked = int(id);
+        }
+    }
+
+    // Only shapes drawn above the picked point can still cover it.
+    for (auto other = others.rbegin(); other != others.rend() && other->index > picked; ++other) {
+        AppState target = other->shape->targetAppState;
+        if ((target == NONE || target == state) && other->shape->IsMouseOverlapping(x, y)) {
+            return other->index;
+        }
+    }
+    return picked;
+}
+
+void ShapePicker::Moved(int index)
+{
+    MoveablePoint* point = points[size_t(index)];
+    if (point) {
+        grids[point->targetAppState].Move(uint32_t(index), point->center);
+    }
+}
@@ -0,0 +1,37 @@
+#pragma once
+
+#include <vector>
+
+#include "hullcore/point_grid.h"
+#include "scene/shapes.h"
+
+// Hit-testing over the app's shape list, in which later shapes are drawn on
+// top. MoveablePoints go into one PointGrid per app state, keyed by their
+// index in the list; the few other shapes are still asked one by one.
+class ShapePicker {
+public:
+    explicit ShapePicker(float cellSize = 64.0f);
+
+    // Indexes the shapes as they are now; call again after adding or
+    // removing any.
+    void Build(const std::vector<Shape*>& shapes);
+
+    // Index of the topmost shape under (x, y) that is interactable in state,
+    // or -1: the shape a backwards walk with IsMouseOverlapping would find.
+    int Pick(float x, float y, AppState state) const;
+
+    // Refiles the shape at index after a drag; only points need it.
+    void Moved(int index);
+
+private:
+    struct Other {
+        int index;
+        Shape* shape;
+    };
+
+    hullcore::PointGrid grids[NONE + 1];
+    // Indexed like the shape list, null where the shape is not a point.
+    std::vector<MoveablePoint*> points;
+    // In list order.
+    std::vector<Other> others;
+};
@@ -0,0 +1,322 @@
+#include "scene/raster_canvas.h"
+
+#include <algorithm>
+#include <cmath>
+#include <cstdio>
+#include <cstdlib>
+
+using namespace std;
+using hullcore::Point2;
+
+namespace {
+
+float clamp01(float value)
+{
+    return value < 0 ? 0 : (value > 1 ? 1 : value);
+}
+
+uint8_t toByte(float value)
+{
+    return uint8_t(clamp01(value) * 255.0f + 0.5f);
+}
+
+// Length of [low, high] inside the pixel [center - 0.5, center + 0.5], which
+// is exact coverage along one axis.
+float overlap(float center, float low, float high)
+{
+    return clamp01(min(center + 0.5f, high) - max(center - 0.5f, low));
+}
+
+}
+
+RasterCanvas::RasterCanvas(int width, int height)
+    : width(max(width, 0)), height(max(height, 0)), pixels(size_t(this->width) * this->height * 4, 0)
+{
+}
+
+void RasterCanvas::Clear(Color color)
+{
+    uint8_t value[4] = { toByte(color.r), toByte(color.g), toByte(color.b), toByte(color.a) };
+    for (size_t i = 0; i < pixels.size(); i += 4) {
+        pixels[i] = value[0];
+        pixels[i + 1] = value[1];
+        pixels[i + 2] = value[2];
+        pixels[i + 3] = value[3];
+    }
+}
+
+void RasterCanvas::blend(uint8_t* pixel, Color color, float coverage)
+{
+    float source = color.a * coverage;
+    if (source <= 0) {
+        return;
+    }
+    float destination = pixel[3] / 255.0f * (1 - source);
+    float alpha = source + destination;
+    pixel[0] = toByte((color.r * source + pixel[0] / 255.0f * destination) / alpha);
+    pixel[1] = toByte((color.g * source + pixel[1] / 255.0f * destination) / alpha);
+    pixel[2] = toByte((color.b * source + pixel[2] / 255.0f * destination) / alpha);
+    pixel[3] = toByte(alpha);
+}
+
+// Visits the rows whose centers lie in [top, bottom]; spanOf gives the pixels
+// of a row that may be touched, coverageAt how much of a pixel is.
+template <class SpanOf, class CoverageAt>
+void RasterCanvas::fill(float top, float bottom, Color color, SpanOf spanOf, CoverageAt coverageAt)
+{
+    int rowBegin = int(min(float(height), max(0.0f, ceil(top - 0.5f))));
+    int rowEnd = int(max(0.0f, min(float(height), floor(bottom - 0.5f) + 1)));
+    for (int y = rowBegin; y < rowEnd; y++) {
+        float centerY = y + 0.5f;
+        Span span = spanOf(centerY);
+        uint8_t* row = pixels.data() + size_t(y) * width * 4;
+        for (int x = max(span.begin, 0); x < min(span.end, width); x++) {
+            float coverage = coverageAt(x + 0.5f, centerY);
+            if (coverage > 0) {
+                blend(row + size_t(x) * 4, color, coverage);
+            }
+        }
+    }
+}
+
+// Coverage is estimated from the distance to the nearest edge, which is
+// exact along straight edges and close enough at corners.
+void RasterCanvas::fillConvex(const Point2* corners, int count, Color color)
+{
+    struct Edge {
+        float nx;
+        float ny;
+        float offset;
+    };
+    Edge edges[4];
+
+    float area = 0;
+    for (int i = 0, j = count - 1; i < count; j = i++) {
+        area += corners[j].x * corners[i].y - corners[j].y * corners[i].x;
+    }
+    if (area == 0) {
+        return;
+    }
+    float sign = area > 0 ? 1.0f : -1.0f;
+
+    int edgeCount = 0;
+    float top = corners[0].y;
+    float bottom = corners[0].y;
+    for (int i = 0, j = count - 1; i < count; j = i++) {
+        float dx = corners[i].x - corners[j].x;
+        float dy = corners[i].y - corners[j].y;
+        float length = sqrt(dx * dx + dy * dy);
+        top = min(top, corners[i].y);
+        bottom = max(bottom, corners[i].y);
+        if (length == 0) {
+            continue;
+        }
+        // Inward unit normal; distance(p) = nx * p.x + ny * p.y + offset.
+        float nx = -sign * dy / length;
+        float ny = sign * dx / length;
+        edges[edgeCount++] = { nx, ny, -(nx * corners[j].x + ny * corners[j].y) };
+    }
+
+    auto spanOf = [&](float y) {
+        float low = -1e30f;
+        float high = 1e30f;
+        for (int e = 0; e < edgeCount; e++) {
+            const Edge& edge = edges[e];
+            float bound = -0.5f - edge.offset - edge.ny * y;
+            if (edge.nx > 1e-6f) {
+                low = max(low, bound / edge.nx);
+            }
+            else if (edge.nx < -1e-6f) {
+                high = min(high, bound / edge.nx);
+            }
+            else if (bound > 0) {
+                return Span{ 0, 0 };
+            }
+        }
+        low = max(low, -1.0f);
+        high = min(high, float(width) + 1);
+        if (low > high) {
+            return Span{ 0, 0 };
+        }
+        return Span{ int(ceil(low - 0.5f)), int(floor(high - 0.5f)) + 1 };
+    };
+    auto coverageAt = [&](float x, float y) {
+        float distance = 1e30f;
+        for (int e = 0; e < edgeCount; e++) {
+            distance = min(distance, edges[e].nx * x + edges[e].ny * y + edges[e].offset);
+        }
+        return clamp01(distance + 0.5f);
+    };
+    fill(top - 0.5f, bottom + 0.5f, color, spanOf, coverageAt);
+}
+
+void RasterCanvas::DrawLine(Point2 from, Point2 to, Color color, float strokeWidth)
+{
+    float dx = to.x - from.x;
+    float dy = to.y - from.y;
+    float length = sqrt(dx * dx + dy * dy);
+    if (length == 0 || strokeWidth <= 0) {
+        return;
+    }
+    float half = strokeWidth / 2;
+    float nx = -dy / length * half;
+    float ny = dx / length * half;
+    Point2 corners[4] = {
+        { from.x + nx, from.y + ny },
+        { from.x - nx, from.y - ny },
+        { to.x - nx, to.y - ny },
+        { to.x + nx, to.y + ny },
+    };
+    fillConvex(corners, 4, color);
+}
+
+void RasterCanvas::FillEllipse(Point2 center, float radiusX, float radiusY, Color color)
+{
+    if (radiusX <= 0 || radiusY <= 0) {
+        return;
+    }
+    float inverseX = 1 / (radiusX * radiusX);
+    float inverseY = 1 / (radiusY * radiusY);
+    auto spanOf = [&](float y) {
+        float t = (y - center.y) / (radiusY + 0.5f);
+        float q = 1 - t * t;
+        if (q <= 0) {
+            return Span{ 0, 0 };
+        }
+        float half = (radiusX + 0.5f) * sqrt(q);
+        return Span{ int(ceil(max(center.x - half, -1.0f) - 0.5f)),
+            int(floor(min(center.x + half, float(width) + 1) - 0.5f)) + 1 };
+    };
+    // First-order distance to the boundary: the implicit function over the
+    // length of its gradient.
+    auto coverageAt = [&](float x, float y) {
+        float dx = x - center.x;
+        float dy = y - center.y;
+        float implicit = dx * dx * inverseX + dy * dy * inverseY - 1;
+        float gradient = 2 * sqrt(dx * dx * inverseX * inverseX + dy * dy * inverseY * inverseY);
+        if (gradient == 0) {
+            return 1.0f;
+        }
+        return clamp01(0.5f - implicit / gradient);
+    };
+    fill(center.y - radiusY - 0.5f, center.y + radiusY + 0.5f, color, spanOf, coverageAt);
+}
+
+void RasterCanvas::FillRectangle(const Rect& rect, Color color)
+{
+    float left = min(rect.left, rect.right);
+    float right = max(rect.left, rect.right);
+    float top = min(rect.top, rect.bottom);
+    float bottom = max(rect.top, rect.bottom);
+    auto spanOf = [&](float) {
+        return Span{ int(floor(max(left, -1.0f))), int(ceil(min(right, float(width) + 1))) };
+    };
+    auto coverageAt = [&](float x, float y) { return overlap(x, left, right) * overlap(y, top, bottom); };
+    fill(top - 0.5f, bottom + 0.5f, color, spanOf, coverageAt);
+}
+
+// The stroke is the outer rectangle minus the inner one, so corners are
+// covered once and no seams show where the sides meet.
+void RasterCanvas::DrawRectangle(const Rect& rect, Color color, float strokeWidth)
+{
+    if (strokeWidth <= 0) {
+        return;
+    }
+    float half = strokeWidth / 2;
+    float left = min(rect.left, rect.right);
+    float right = max(rect.left, rect.right);
+    float top = min(rect.top, rect.bottom);
+    float bottom = max(rect.top, rect.bottom);
+    Rect outer = { left - half, top - half, right + half, bottom + half };
+    Rect inner = { left + half, top + half, right - half, bottom - half };
+    bool hollow = inner.left < inner.right && inner.top < inner.bottom;
+
+    auto spanOf = [&](float) {
+        return Span{ int(floor(max(outer.left, -1.0f))), int(ceil(min(outer.right, float(width) + 1))) };
+    };
+    auto coverageAt = [&](float x, float y) {
+        float coverage = overlap(x, outer.left, outer.right) * overlap(y, outer.top, outer.bottom);
+        if (hollow) {
+            coverage -= overlap(x, inner.left, inner.right) * overlap(y, inner.top, inner.bottom);
+        }
+        return coverage;
+    };
+    fill(outer.top - 0.5f, outer.bottom + 0.5f, color, spanOf, coverageAt);
+}
+
+bool RasterCanvas::WritePpm(const char* path) const
+{
+    FILE* file = fopen(path, "wb");
+    if (!file) {
+        return false;
+    }
+    bool ok = fprintf(file, "P6\n%d %d\n255\n", width, height) > 0;
+    vector<uint8_t> row(size_t(width) * 3);
+    for (int y = 0; y < height && ok; y++) {
+        const uint8_t* source = pixels.data() + size_t(y) * width * 4;
+        for (int x = 0; x < width; x++) {
+            row[size_t(x) * 3] = source[size_t(x) * 4];
+            row[size_t(x) * 3 + 1] = source[size_t(x) * 4 + 1];
+            row[size_t(x) * 3 + 2] = source[size_t(x) * 4 + 2];
+        }
+        ok = fwrite(row.data(), 1, row.size(), file) == row.size();
+    }
+    ok = fclose(file) == 0 && ok;
+    return ok;
+}
+
+bool RasterCanvas::ReadPpm(const char* path)
+{
+    FILE* file = fopen(path, "rb");
+    if (!file) {
+        return false;
+    }
+    int fileWidth = 0;
+    int fileHeight = 0;
+    int maxValue = 0;
+    bool ok = fscanf(file, "P6 %d %d %d", &fileWidth, &fileHeight, &maxValue) == 3 && fileWidth >= 0 &&
+        fileHeight >= 0 && maxValue == 255 && fgetc(file) != EOF;
+    vector<uint8_t> rgb;
+    if (ok) {
+        rgb.resize(size_t(fileWidth) * fileHeight * 3);
+        ok = fread(rgb.data(), 1, rgb.size(), file) == rgb.size();
+    }
+    fclose(file);
+    if (!ok) {
+        return false;
+    }
+
+    width = fileWidth;
+    height = fileHeight;
+    pixels.assign(size_t(width) * height * 4, 255);
+    for (size_t i = 0; i < size_t(width) * height; i++) {
+        pixels[i * 4] = rgb[i * 3];
+        pixels[i * 4 + 1] = rgb[i * 3 + 1];
+        pixels[i * 4 + 2] = rgb[i * 3 + 2];
+    }
+    return true;
+}
+
+ImageDifference CompareImages(const RasterCanvas& a, const RasterCanvas& b, int tolerance)
+{
+    ImageDifference difference;
+    if (a.PixelWidth() != b.PixelWidth() || a.PixelHeight() != b.PixelHeight()) {
+        difference.differentPixels = max(size_t(a.PixelWidth()) * a.PixelHeight(), size_t(b.PixelWidth()) * b.PixelHeight());
+        difference.maxChannelDelta = 255;
+        return difference;
+    }
+    size_t count = size_t(a.PixelWidth()) * a.PixelHeight();
+    const uint8_t* pixelsA = a.Pixels();
+    const uint8_t* pixelsB = b.Pixels();
+    for (size_t i = 0; i < count; i++) {
+        int delta = 0;
+        for (int channel = 0; channel < 4; channel++) {
+            delta = max(delta, abs(int(pixelsA[i * 4 + channel]) - int(pixelsB[i * 4 + channel])));
+        }
+        difference.maxChannelDelta = max(difference.maxChannelDelta, delta);
+        if (delta > tolerance) {
+            difference.differentPixels++;
+        }
+    }
+    return difference;
+}
@@ -0,0 +1,63 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+#include "scene/canvas.h"
+
+// Software rasterizer into an 8-bit RGBA image, one pixel per unit, so scenes
+// render without a window. Every primitive is a convex region whose edge
+// pixels are shaded by coverage and blended source-over. There is no font to
+// draw text with, so DrawString is skipped; SvgCanvas keeps it.
+class RasterCanvas : public Canvas {
+public:
+    RasterCanvas(int width, int height);
+
+    float Width() const override { return float(width); }
+    float Height() const override { return float(height); }
+
+    void Clear(Color color) override;
+    void DrawLine(hullcore::Point2 from, hullcore::Point2 to, Color color, float strokeWidth) override;
+    void FillEllipse(hullcore::Point2 center, float radiusX, float radiusY, Color color) override;
+    void DrawRectangle(const Rect& rect, Color color, float strokeWidth) override;
+    void FillRectangle(const Rect& rect, Color color) override;
+    void DrawString(const std::string&, const Rect&, Color) override { }
+
+    int PixelWidth() const { return width; }
+    int PixelHeight() const { return height; }
+
+    // Rows top to bottom, four bytes per pixel in R, G, B, A order.
+    const uint8_t* Pixels() const { return pixels.data(); }
+
+    // Binary PPM (P6); alpha is dropped.
+    bool WritePpm(const char* path) const;
+
+    // Replaces the image with a PPM as WritePpm writes it, fully opaque, so
+    // golden images can be compared with CompareImages.
+    bool ReadPpm(const char* path);
+
+private:
+    struct Span {
+        int begin;
+        int end;
+    };
+
+    template <class SpanOf, class CoverageAt>
+    void fill(float top, float bottom, Color color, SpanOf spanOf, CoverageAt coverageAt);
+    void fillConvex(const hullcore::Point2* corners, int count, Color color);
+    void blend(uint8_t* pixel, Color color, float coverage);
+
+    int width;
+    int height;
+    std::vector<uint8_t> pixels;
+};
+
+struct ImageDifference {
+    size_t differentPixels = 0;
+    int maxChannelDelta = 0;
+};
+
+// Pixels of a and b whose channels differ by more than tolerance, and the
+// largest difference seen. Images of different sizes differ everywhere.
+ImageDifference CompareImages(const RasterCanvas& a, const RasterCanvas& b, int tolerance = 0);
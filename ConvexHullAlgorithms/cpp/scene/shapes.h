@@ -0,0 +1,496 @@
+#pragma once
+
+#include <string>
+#include <vector>
+
+#include "hullcore/calipers.h"
+#include "hullcore/containment.h"
+#include "hullcore/gjk.h"
+#include "hullcore/hull.h"
+#include "hullcore/intersection.h"
+#include "hullcore/minkowski.h"
+#include "hullcore/point_arena.h"
+#include "scene/canvas.h"
+
+// The window app's scene objects. They draw through Canvas only, so the same
+// scene renders in the window or headless into a RasterCanvas or SvgCanvas.
+
+enum AppState { QUICK_HULL, POINT_CONVEX_HULL, GJK, M_SUM, M_DIFF, NONE };
+
+struct Shape {
+
+    AppState targetAppState = NONE;
+
+    virtual ~Shape() { }
+
+    virtual void Draw(Canvas& canvas) = 0;
+
+    virtual void WriteText(Canvas&) { };
+
+    virtual bool IsMouseOverlapping(float, float) { return 0; };
+
+    virtual void OnMouseClick(float, float) { };
+
+    virtual void OnMouseDrag(float, float) { };
+};
+
+struct Grid : Shape {
+
+    float lineSpacing;
+    float gridLinesStrokeWidth;
+    float axisLinesStrokeWidth;
+    Color gridLinesColor;
+    Color axisLinesColor;
+
+    void Draw(Canvas& canvas) {
+        float width = canvas.Width();
+        float height = canvas.Height();
+        float centerX = width / 2;
+        float centerY = height / 2;
+        for (float x = centerX; x < width; x += lineSpacing)
+        {
+            canvas.DrawLine({ x, 0.0f }, { x, height }, gridLinesColor, gridLinesStrokeWidth);
+        }
+        for (float x = centerX; x > 0; x -= lineSpacing)
+        {
+            canvas.DrawLine({ x, 0.0f }, { x, height }, gridLinesColor, gridLinesStrokeWidth);
+        }
+        for (float y = centerY; y < height; y += lineSpacing)
+        {
+            canvas.DrawLine({ 0.0f, y }, { width, y }, gridLinesColor, gridLinesStrokeWidth);
+        }
+        for (float y = centerY; y > 0; y -= lineSpacing)
+        {
+            canvas.DrawLine({ 0.0f, y }, { width, y }, gridLinesColor, gridLinesStrokeWidth);
+        }
+        canvas.DrawLine({ centerX, 0 }, { centerX, height }, axisLinesColor, axisLinesStrokeWidth);
+        canvas.DrawLine({ 0, centerY }, { width, centerY }, axisLinesColor, axisLinesStrokeWidth);
+
+    }
+
+};
+
+// Counts how often a cached result was reused and how often it had to be
+// recomputed because one of its inputs changed.
+struct CacheStats {
+    size_t hits = 0;
+    size_t recomputations = 0;
+};
+
+struct MoveablePoint : Shape {
+
+    hullcore::Point2 center;
+    float radius;
+    Color fillColor;
+    // Bumped on every move, so hulls built from the point can tell they are
+    // stale without comparing coordinates.
+    unsigned version = 0;
+
+
+    void Draw(Canvas& canvas) {
+        canvas.FillEllipse(center, radius, radius, fillColor);
+    }
+
+    void OnMouseClick() {
+        fillColor = ColorFromRgb(0xFF0000);
+    }
+
+    void OnMouseDrag(float x, float y) {
+        center.x = x;
+        center.y = y;
+        version++;
+    }
+
+    bool IsMouseOverlapping(float x, float y) {
+        float a = (x - center.x) * (x - center.x);
+        float b = (y - center.y) * (y - center.y);
+        return a + b < radius * radius;
+    }
+
+};
+
+struct NPolygon : Shape {
+
+    std::vector<hullcore::Point2> points;
+    Color color;
+    float strokeWidth;
+
+    void Draw(Canvas& canvas) {
+        for (size_t i = 1; i < points.size(); i++) {
+            canvas.DrawLine(points[i - 1], points[i], color, strokeWidth);
+        }
+        canvas.DrawLine(points[0], points[points.size() - 1], color, strokeWidth);
+    }
+
+    bool IsMouseOverlapping(float, float) {
+        return 0;
+    }
+
+};
+
+struct Button : Shape {
+
+    Rect rectangle;
+    Color fillColor;
+    Color outlineColor;
+    Color textColor;
+    std::string text;
+    float outlineWidth;
+    void (*onClickCallback) ();
+
+    void Draw(Canvas& canvas) {
+        canvas.DrawRectangle(rectangle, outlineColor, outlineWidth);
+        canvas.FillRectangle(rectangle, fillColor);
+    }
+
+    void WriteText(Canvas& canvas) {
+        canvas.DrawString(text, rectangle, textColor);
+    };
+
+    void OnMouseClick(float, float) {
+        onClickCallback();
+    }
+
+    bool IsMouseOverlapping(float x, float y) {
+        return x < rectangle.right&& x > rectangle.left && y > rectangle.top && y < rectangle.bottom;
+    }
+
+};
+
+inline void DrawClosedPolygon(
+    Canvas& canvas,
+    const hullcore::Point2* points,
+    size_t count,
+    Color color,
+    float strokeWidth) {
+    for (size_t i = 0; i < count; i++) {
+        canvas.DrawLine(points[i], points[(i + 1) % count], color, strokeWidth);
+    }
+}
+
+struct QuickHull : Shape {
+
+    std::vector<MoveablePoint*> points;
+    std::vector<MoveablePoint*> hullPoints;
+    hullcore::HullEngine engine = hullcore::HullEngine::QuickHull;
+
+    void Draw(Canvas& canvas) {
+        UpdateHull();
+        if (hullPoints.empty()) {
+            return;
+        }
+
+        // Each edge takes the color of the point it starts at; the closing
+        // edge keeps the color of the one before it.
+        Color color = hullPoints[0]->fillColor;
+        for (size_t i = 1; i < hullPoints.size(); i++) {
+
+            MoveablePoint* pointA = hullPoints[i - 1];
+            MoveablePoint* pointB = hullPoints[i];
+            color = pointA->fillColor;
+            canvas.DrawLine(pointA->center, pointB->center, color, 2.0f);
+        }
+        canvas.DrawLine(hullPoints[hullPoints.size() - 1]->center, hullPoints[0]->center, color, 2.0f);
+
+    }
+
+    void CalculateHull() {
+        corePoints.resize(points.size());
+        for (size_t i = 0; i < points.size(); i++) {
+            corePoints[i] = { points[i]->center.x, points[i]->center.y };
+        }
+        calculateHullFromCorePoints();
+    }
+
+    // Recomputes the hull only if a point was added, removed or moved since
+    // the last calculation; returns whether it did. Point versions only ever
+    // grow, so their sum changes whenever any point has been dragged.
+    bool UpdateHull() {
+        size_t pointVersions = 0;
+        for (MoveablePoint* point : points) {
+            pointVersions += point->version;
+        }
+        if (!hullPoints.empty() && builtPointCount == points.size() && builtPointVersions == pointVersions) {
+            cache.hits++;
+            return false;
+        }
+        CalculateHull();
+        builtPointCount = points.size();
+        builtPointVersions = pointVersions;
+        return true;
+    }
+
+    void calculateHullFromCorePoints() {
+        hullcore::CalculateHull(corePoints.data(), corePoints.size(), hullIndices, engine);
+
+        hullPoints.clear();
+        for (size_t index : hullIndices) {
+            hullPoints.push_back(points[index]);
+        }
+        version++;
+        cache.recomputations++;
+    }
+
+    void GetHullPoints(std::vector<hullcore::Point2>& out) {
+        out.clear();
+        for (MoveablePoint* point : hullPoints) {
+            out.push_back({ point->center.x, point->center.y });
+        }
+    }
+
+    void CopyHullPoints(hullcore::Point2* out) {
+        for (size_t i = 0; i < hullPoints.size(); i++) {
+            out[i] = { hullPoints[i]->center.x, hullPoints[i]->center.y };
+        }
+    }
+
+    // Caliper measurements of the current hull. The sweep runs again only
+    // for a new hull or for queries the cached sweep did not answer, and then
+    // answers those together with the ones already held.
+    const hullcore::CaliperResult& Calipers(unsigned queries) {
+        UpdateHull();
+        if (calipersVersion == version && (calipersQueries & queries) == queries) {
+            calipersCache.hits++;
+            return calipers;
+        }
+        if (calipersVersion != version) {
+            calipersQueries = 0;
+        }
+        calipersQueries |= queries;
+        std::vector<hullcore::Point2> vertices;
+        GetHullPoints(vertices);
+        hullcore::RotatingCalipers(vertices.data(), vertices.size(), calipersQueries, calipers);
+        calipersVersion = version;
+        calipersCache.recomputations++;
+        return calipers;
+    }
+
+    std::vector<hullcore::Point2> corePoints;
+    std::vector<size_t> hullIndices;
+    hullcore::CaliperResult calipers;
+    unsigned calipersQueries = 0;
+    CacheStats calipersCache;
+    unsigned calipersVersion = 0;
+
+    // Bumped by every recalculation; results derived from the hull keep the
+    // version they were built from.
+    unsigned version = 0;
+    CacheStats cache;
+    size_t builtPointCount = 0;
+    size_t builtPointVersions = 0;
+
+};
+
+
+struct PointConvexHull : Shape {
+
+    QuickHull hull;
+    MoveablePoint* point;
+    Color inColor;
+    Color outColor;
+    hullcore::ConvexHullQuery query;
+    unsigned queryVersion = 0;
+    CacheStats cache;
+
+    void Draw(Canvas& canvas) {
+        if (isPointInside()) {
+            point->fillColor = inColor;
+        }
+        else {
+            point->fillColor = outColor;
+        }
+        hull.Draw(canvas);
+
+    }
+
+    // The query structure is rebuilt only for a new hull; moving the tested
+    // point alone just costs the lookup.
+    bool isPointInside() {
+        hull.UpdateHull();
+        if (query.vertices.empty() || queryVersion != hull.version) {
+            std::vector<hullcore::Point2> vertices;
+            hull.GetHullPoints(vertices);
+            query.Build(vertices.data(), vertices.size());
+            queryVersion = hull.version;
+            cache.recomputations++;
+        }
+        else {
+            cache.hits++;
+        }
+        return query.Contains({ point->center.x, point->center.y });
+    }
+
+};
+
+struct MinkowskiSum : Shape {
+
+    QuickHull* hull1;
+    QuickHull* hull2;
+    Color resultColor;
+    hullcore::PointArena arena;
+    hullcore::Point2* resultPoints = nullptr;
+    size_t resultCount = 0;
+    unsigned version1 = 0;
+    unsigned version2 = 0;
+    CacheStats cache;
+
+    void Draw(Canvas& canvas) {
+
+        hull1->Draw(canvas);
+        hull2->Draw(canvas);
+        UpdateSum();
+        DrawClosedPolygon(canvas, resultPoints, resultCount, resultColor, 2.0f);
+    }
+
+    // Reuses the last sum unless either hull was recalculated since.
+    void UpdateSum() {
+        if (resultPoints && version1 == hull1->version && version2 == hull2->version) {
+            cache.hits++;
+            return;
+        }
+        CalculateSum();
+        version1 = hull1->version;
+        version2 = hull2->version;
+        cache.recomputations++;
+    }
+
+    // Inputs and result live in the arena, which is reset every evaluation, so
+    // after the first few evaluations AllocationCount() stays constant.
+    void CalculateSum() {
+        arena.Reset();
+        size_t count1 = hull1->hullPoints.size();
+        size_t count2 = hull2->hullPoints.size();
+        hullcore::Point2* points1 = arena.Allocate(count1);
+        hullcore::Point2* points2 = arena.Allocate(count2);
+        hull1->CopyHullPoints(points1);
+        hull2->CopyHullPoints(points2);
+        resultPoints = arena.Allocate(count1 + count2);
+        resultCount = hullcore::ConvexMinkowskiSum(points1, count1, points2, count2, resultPoints);
+    }
+
+    size_t AllocationCount() const { return arena.AllocationCount(); }
+
+};
+
+struct MinkowskiDifference : Shape {
+
+    QuickHull* hull1;
+    QuickHull* hull2;
+    Color resultColor;
+    hullcore::PointArena arena;
+    hullcore::Point2* resultPoints = nullptr;
+    size_t resultCount = 0;
+    unsigned version1 = 0;
+    unsigned version2 = 0;
+    CacheStats cache;
+
+    void Draw(Canvas& canvas) {
+
+        hull1->Draw(canvas);
+        hull2->Draw(canvas);
+        UpdateDiff();
+        DrawClosedPolygon(canvas, resultPoints, resultCount, resultColor, 2.0f);
+    }
+
+    void UpdateDiff() {
+        if (resultPoints && version1 == hull1->version && version2 == hull2->version) {
+            cache.hits++;
+            return;
+        }
+        CalculateDiff();
+        version1 = hull1->version;
+        version2 = hull2->version;
+        cache.recomputations++;
+    }
+
+    void CalculateDiff() {
+        arena.Reset();
+        size_t count1 = hull1->hullPoints.size();
+        size_t count2 = hull2->hullPoints.size();
+        hullcore::Point2* points1 = arena.Allocate(count1);
+        hullcore::Point2* points2 = arena.Allocate(count2);
+        hull1->CopyHullPoints(points1);
+        hull2->CopyHullPoints(points2);
+        resultPoints = arena.Allocate(count1 + count2);
+        resultCount = hullcore::ConvexMinkowskiDiff(points1, count1, points2, count2, resultPoints);
+    }
+
+    size_t AllocationCount() const { return arena.AllocationCount(); }
+
+};
+
+
+struct GjkCollision : Shape {
+
+    QuickHull* hull1;
+    QuickHull* hull2;
+    Color separatedColor;
+    Color collidingColor;
+    hullcore::GjkResult result;
+
+    void Draw(Canvas& canvas) {
+        hull1->UpdateHull();
+        hull2->UpdateHull();
+        if (calculated && version1 == hull1->version && version2 == hull2->version) {
+            cache.hits++;
+        }
+        else {
+            CalculateCollision();
+            version1 = hull1->version;
+            version2 = hull2->version;
+            calculated = true;
+            cache.recomputations++;
+        }
+
+        Color color = result.intersecting ? collidingColor : separatedColor;
+        for (MoveablePoint* point : hull1->points) {
+            point->fillColor = color;
+        }
+        for (MoveablePoint* point : hull2->points) {
+            point->fillColor = color;
+        }
+        hull1->Draw(canvas);
+        hull2->Draw(canvas);
+
+        if (result.intersecting) {
+            // Penetration vector, drawn from the centroid of the second hull.
+            hullcore::Point2 from = { 0, 0 };
+            for (MoveablePoint* point : hull2->hullPoints) {
+                from.x += point->center.x / hull2->hullPoints.size();
+                from.y += point->center.y / hull2->hullPoints.size();
+            }
+            hullcore::Point2 to = {
+                from.x + float(result.normalX * result.penetrationDepth),
+                from.y + float(result.normalY * result.penetrationDepth) };
+            canvas.DrawLine(from, to, color, 2.0f);
+            DrawClosedPolygon(canvas, overlap.data(), overlap.size(), color, 1.0f);
+        }
+        else {
+            canvas.DrawLine(result.closestA, result.closestB, color, 2.0f);
+        }
+    }
+
+    // Works on the two hulls directly through support queries, so no
+    // Minkowski difference is ever built.
+    void CalculateCollision() {
+        hull1->GetHullPoints(points1);
+        hull2->GetHullPoints(points2);
+        result = hullcore::GjkQuery(points1.data(), points1.size(), points2.data(), points2.size());
+        overlap.clear();
+        overlapArea = 0;
+        if (result.intersecting) {
+            overlapArea = hullcore::ConvexIntersection(points1.data(), points1.size(), points2.data(), points2.size(), overlap);
+        }
+    }
+
+    std::vector<hullcore::Point2> points1;
+    std::vector<hullcore::Point2> points2;
+    // What the two hulls share, outlined while they collide.
+    std::vector<hullcore::Point2> overlap;
+    double overlapArea = 0;
+    bool calculated = false;
+    unsigned version1 = 0;
+    unsigned version2 = 0;
+    CacheStats cache;
+
+};
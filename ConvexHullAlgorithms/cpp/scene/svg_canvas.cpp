@@ -0,0 +1,128 @@
+#include "scene/svg_canvas.h"
+
+#include <algorithm>
+#include <cmath>
+#include <cstdarg>
+#include <cstdio>
+
+using namespace std;
+using hullcore::Point2;
+
+namespace {
+
+void appendFormat(string& out, const char* format, ...)
+{
+    char buffer[512];
+    va_list args;
+    va_start(args, format);
+    int length = vsnprintf(buffer, sizeof(buffer), format, args);
+    va_end(args);
+    if (length > 0) {
+        out.append(buffer, min(size_t(length), sizeof(buffer) - 1));
+    }
+}
+
+int channel(float value)
+{
+    return int(max(0.0f, min(1.0f, value)) * 255.0f + 0.5f);
+}
+
+// fill="..." or stroke="..." with its opacity, which is left out when opaque.
+void appendPaint(string& out, const char* attribute, Color color)
+{
+    appendFormat(out, " %s=\"#%02x%02x%02x\"", attribute, channel(color.r), channel(color.g), channel(color.b));
+    if (color.a < 1) {
+        appendFormat(out, " %s-opacity=\"%g\"", attribute, max(0.0f, color.a));
+    }
+}
+
+void appendEscaped(string& out, const string& text)
+{
+    for (char c : text) {
+        switch (c) {
+        case '&': out += "&amp;"; break;
+        case '<': out += "&lt;"; break;
+        case '>': out += "&gt;"; break;
+        case '"': out += "&quot;"; break;
+        default: out += c; break;
+        }
+    }
+}
+
+}
+
+void SvgCanvas::Clear(Color color)
+{
+    body.clear();
+    appendFormat(body, "<rect x=\"0\" y=\"0\" width=\"%g\" height=\"%g\"", width, height);
+    appendPaint(body, "fill", color);
+    body += "/>\n";
+}
+
+void SvgCanvas::DrawLine(Point2 from, Point2 to, Color color, float strokeWidth)
+{
+    appendFormat(body, "<line x1=\"%g\" y1=\"%g\" x2=\"%g\" y2=\"%g\" stroke-width=\"%g\"", from.x, from.y, to.x, to.y,
+        strokeWidth);
+    appendPaint(body, "stroke", color);
+    body += "/>\n";
+}
+
+void SvgCanvas::FillEllipse(Point2 center, float radiusX, float radiusY, Color color)
+{
+    appendFormat(body, "<ellipse cx=\"%g\" cy=\"%g\" rx=\"%g\" ry=\"%g\"", center.x, center.y, radiusX, radiusY);
+    appendPaint(body, "fill", color);
+    body += "/>\n";
+}
+
+void SvgCanvas::DrawRectangle(const Rect& rect, Color color, float strokeWidth)
+{
+    appendFormat(body, "<rect x=\"%g\" y=\"%g\" width=\"%g\" height=\"%g\" fill=\"none\" stroke-width=\"%g\"",
+        min(rect.left, rect.right), min(rect.top, rect.bottom), abs(rect.right - rect.left), abs(rect.bottom - rect.top),
+        strokeWidth);
+    appendPaint(body, "stroke", color);
+    body += "/>\n";
+}
+
+void SvgCanvas::FillRectangle(const Rect& rect, Color color)
+{
+    appendFormat(body, "<rect x=\"%g\" y=\"%g\" width=\"%g\" height=\"%g\"", min(rect.left, rect.right),
+        min(rect.top, rect.bottom), abs(rect.right - rect.left), abs(rect.bottom - rect.top));
+    appendPaint(body, "fill", color);
+    body += "/>\n";
+}
+
+// Matches the window app's text format: Verdana 20, centered both ways.
+void SvgCanvas::DrawString(const string& text, const Rect& rect, Color color)
+{
+    appendFormat(body,
+        "<text x=\"%g\" y=\"%g\" font-family=\"Verdana\" font-size=\"20\" text-anchor=\"middle\" "
+        "dominant-baseline=\"central\"",
+        (rect.left + rect.right) / 2, (rect.top + rect.bottom) / 2);
+    appendPaint(body, "fill", color);
+    body += ">";
+    appendEscaped(body, text);
+    body += "</text>\n";
+}
+
+string SvgCanvas::Document() const
+{
+    string document;
+    appendFormat(document,
+        "<svg xmlns=\"http://www.w3.org/2000/svg\" width=\"%g\" height=\"%g\" viewBox=\"0 0 %g %g\">\n", width,
+        height, width, height);
+    document += body;
+    document += "</svg>\n";
+    return document;
+}
+
+bool SvgCanvas::Save(const char* path) const
+{
+    FILE* file = fopen(path, "wb");
+    if (!file) {
+        return false;
+    }
+    string document = Document();
+    bool ok = fwrite(document.data(), 1, document.size(), file) == document.size();
+    ok = fclose(file) == 0 && ok;
+    return ok;
+}
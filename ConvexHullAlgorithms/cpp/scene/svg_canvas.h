@@ -0,0 +1,31 @@
+#pragma once
+
+#include <string>
+
+#include "scene/canvas.h"
+
+// Records every call as an SVG element, text included, for scenes that are
+// easier to inspect or diff as markup than as pixels.
+class SvgCanvas : public Canvas {
+public:
+    SvgCanvas(float width, float height) : width(width), height(height) { }
+
+    float Width() const override { return width; }
+    float Height() const override { return height; }
+
+    // Paints over everything, so what was drawn before is dropped.
+    void Clear(Color color) override;
+    void DrawLine(hullcore::Point2 from, hullcore::Point2 to, Color color, float strokeWidth) override;
+    void FillEllipse(hullcore::Point2 center, float radiusX, float radiusY, Color color) override;
+    void DrawRectangle(const Rect& rect, Color color, float strokeWidth) override;
+    void FillRectangle(const Rect& rect, Color color) override;
+    void DrawString(const std::string& text, const Rect& rect, Color color) override;
+
+    std::string Document() const;
+    bool Save(const char* path) const;
+
+private:
+    float width;
+    float height;
+    std::string body;
+};
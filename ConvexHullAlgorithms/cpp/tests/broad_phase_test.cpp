@@ -0,0 +1,133 @@
+#include <algorithm>
+#include <cstdio>
+#include <random>
+#include <set>
+#include <vector>
+
+#include "hullcore/broad_phase.h"
+#include "hullcore/task_pool.h"
+#include "test_support.h"
+
+using namespace std;
+using namespace hullcore;
+
+namespace {
+
+Aabb randomBox(mt19937& random, float world)
+{
+    uniform_real_distribution<float> position(0.0f, world);
+    uniform_real_distribution<float> size(0.0f, 12.0f);
+    float x = position(random);
+    float y = position(random);
+    return { x, y, x + size(random), y + size(random) };
+}
+
+bool pairLess(const ProxyPair& a, const ProxyPair& b)
+{
+    return a.first < b.first || (a.first == b.first && a.second < b.second);
+}
+
+bool samePairs(vector<ProxyPair> a, vector<ProxyPair> b)
+{
+    sort(a.begin(), a.end(), pairLess);
+    sort(b.begin(), b.end(), pairLess);
+    return equal(a.begin(), a.end(), b.begin(), b.end(),
+        [](const ProxyPair& x, const ProxyPair& y) { return x.first == y.first && x.second == y.second; });
+}
+
+vector<ProxyPair> allPairs(const SweepAndPrune& broadPhase, const set<uint32_t>& live)
+{
+    vector<ProxyPair> pairs;
+    for (auto a = live.begin(); a != live.end(); ++a) {
+        for (auto b = next(a); b != live.end(); ++b) {
+            if (Overlaps(broadPhase.ProxyBox(*a), broadPhase.ProxyBox(*b)))
+                pairs.push_back({ *a, *b });
+        }
+    }
+    return pairs;
+}
+
+// Frames of moves, removals and additions, each checked against testing every
+// pair of live proxies. Removed ids are removed a second time and updated, and
+// must neither disturb the sweep nor come back twice from AddProxy.
+void testAgainstAllPairs(size_t proxyCount, int frames, float world)
+{
+    mt19937 random{ unsigned(proxyCount) };
+    SweepAndPrune broadPhase;
+    set<uint32_t> live;
+    vector<uint32_t> removed;
+    for (size_t i = 0; i < proxyCount; i++) {
+        live.insert(broadPhase.AddProxy(randomBox(random, world)));
+    }
+
+    vector<ProxyPair> pairs;
+    vector<ProxyPair> parallelPairs;
+    uniform_real_distribution<float> step(-2.0f, 2.0f);
+    for (int frame = 0; frame < frames; frame++) {
+        for (uint32_t id : live) {
+            Aabb box = broadPhase.ProxyBox(id);
+            float dx = step(random);
+            float dy = step(random);
+            broadPhase.UpdateProxy(id, { box.minX + dx, box.minY + dy, box.maxX + dx, box.maxY + dy });
+        }
+
+        removed.clear();
+        for (size_t k = 0; k < proxyCount / 20 && !live.empty(); k++) {
+            auto victim = live.begin();
+            advance(victim, random() % live.size());
+            removed.push_back(*victim);
+            broadPhase.RemoveProxy(*victim);
+            live.erase(victim);
+        }
+        for (uint32_t id : removed) {
+            broadPhase.RemoveProxy(id);
+            CHECK(!broadPhase.IsProxy(id));
+        }
+        for (size_t k = 0; k < proxyCount / 25; k++) {
+            uint32_t id = broadPhase.AddProxy(randomBox(random, world));
+            CHECK(live.insert(id).second);
+        }
+        CHECK(broadPhase.ProxyCount() == live.size());
+
+        broadPhase.FindPairs(pairs);
+        broadPhase.FindPairs(parallelPairs, TaskPool::Default());
+        vector<ProxyPair> expected = allPairs(broadPhase, live);
+        CHECK(samePairs(pairs, expected));
+        CHECK(samePairs(parallelPairs, expected));
+        for (const ProxyPair& pair : pairs) {
+            CHECK(pair.first < pair.second);
+        }
+    }
+}
+
+void testUnknownIds()
+{
+    SweepAndPrune broadPhase;
+    broadPhase.RemoveProxy(0);
+    broadPhase.RemoveProxy(12345);
+    uint32_t a = broadPhase.AddProxy({ 0, 0, 1, 1 });
+    uint32_t b = broadPhase.AddProxy({ 0.5f, 0.5f, 2, 2 });
+    broadPhase.RemoveProxy(a);
+    broadPhase.RemoveProxy(a);
+    CHECK(broadPhase.ProxyCount() == 1);
+
+    uint32_t c = broadPhase.AddProxy({ 1, 1, 3, 3 });
+    uint32_t d = broadPhase.AddProxy({ 2.5f, 2.5f, 4, 4 });
+    CHECK(c == a);
+    CHECK(d != a && d != b);
+
+    vector<ProxyPair> pairs;
+    broadPhase.FindPairs(pairs);
+    CHECK(samePairs(pairs, { { min(b, c), max(b, c) }, { min(c, d), max(c, d) } }));
+}
+
+}
+
+int main()
+{
+    testUnknownIds();
+    testAgainstAllPairs(200, 40, 150.0f);
+    // Enough proxies for the pool overload to split the sweep into chunks.
+    testAgainstAllPairs(5000, 4, 1500.0f);
+    return TestResult();
+}
@@ -0,0 +1,207 @@
+#include <algorithm>
+#include <cmath>
+#include <cstdio>
+#include <random>
+#include <set>
+#include <utility>
+#include <vector>
+
+#include "hullcore/calipers.h"
+#include "test_support.h"
+
+using namespace std;
+using namespace hullcore;
+
+namespace {
+
+vector<Point2> randomPoints(mt19937& random, int kind, size_t count)
+{
+    uniform_real_distribution<float> coordinate(-1000.0f, 1000.0f);
+    uniform_int_distribution<int> grid(-8, 8);
+    uniform_int_distribution<int> exponent(-40, 40);
+    uniform_real_distribution<float> angle(0.0f, 6.2831853f);
+    vector<Point2> points(count);
+    for (Point2& point : points) {
+        switch (kind) {
+        case 0:
+            point = { coordinate(random), coordinate(random) };
+            break;
+        case 1:
+            // Hulls on a small grid have many parallel edges.
+            point = { float(grid(random)), float(grid(random)) };
+            break;
+        case 2: {
+            float a = angle(random);
+            point = { 500 * cos(a), 200 * sin(a) };
+            break;
+        }
+        default: {
+            int e = exponent(random);
+            point = { ldexp(coordinate(random), e), ldexp(coordinate(random), e) };
+            break;
+        }
+        }
+    }
+    return points;
+}
+
+double distance(Point2 a, Point2 b)
+{
+    double dx = double(b.x) - a.x;
+    double dy = double(b.y) - a.y;
+    return sqrt(dx * dx + dy * dy);
+}
+
+bool near(double value, double expected, double scale)
+{
+    return fabs(value - expected) <= 1e-9 * scale;
+}
+
+// Directions d with (p - q) x d >= 0 and d x (s - r) >= 0: for the turn at a
+// strictly convex vertex, every direction from edge qp round to edge rs.
+bool inArc(Point2 q, Point2 p, Point2 r, Point2 s, Point2 d0, Point2 d1)
+{
+    return CrossEdges(q, p, d0, d1) >= 0 && CrossEdges(d0, d1, r, s) >= 0;
+}
+
+// Vertices i and j admit parallel supporting lines exactly when some
+// direction of the turn at i, reversed, is a direction of the turn at j.
+bool antipodal(const vector<Point2>& hull, size_t i, size_t j)
+{
+    size_t n = hull.size();
+    Point2 a0 = hull[(i + n - 1) % n], a1 = hull[i], a2 = hull[(i + 1) % n];
+    Point2 b0 = hull[(j + n - 1) % n], b1 = hull[j], b2 = hull[(j + 1) % n];
+    // The turn at j reversed runs from edge (b1, b0) to edge (b2, b1).
+    return inArc(a0, a1, a1, a2, b1, b0) || inArc(a0, a1, a1, a2, b2, b1) || inArc(b1, b0, b2, b1, a0, a1) ||
+        inArc(b1, b0, b2, b1, a1, a2);
+}
+
+struct BruteForce {
+    double diameter = 0;
+    double width = HUGE_VAL;
+    double minArea = HUGE_VAL;
+    double minPerimeter = HUGE_VAL;
+    set<pair<size_t, size_t>> pairs;
+};
+
+// Every pair, and every edge against every vertex: O(h^2).
+BruteForce bruteForce(const vector<Point2>& hull)
+{
+    BruteForce result;
+    size_t n = hull.size();
+    for (size_t i = 0; i < n; i++) {
+        for (size_t j = i + 1; j < n; j++) {
+            result.diameter = max(result.diameter, distance(hull[i], hull[j]));
+            if (antipodal(hull, i, j)) {
+                result.pairs.insert({ i, j });
+            }
+        }
+
+        Point2 origin = hull[i];
+        Point2 next = hull[(i + 1) % n];
+        double length = distance(origin, next);
+        double axisX = (double(next.x) - origin.x) / length;
+        double axisY = (double(next.y) - origin.y) / length;
+        double lower = HUGE_VAL, upper = -HUGE_VAL, breadth = 0;
+        for (const Point2& point : hull) {
+            double dx = double(point.x) - origin.x;
+            double dy = double(point.y) - origin.y;
+            lower = min(lower, dx * axisX + dy * axisY);
+            upper = max(upper, dx * axisX + dy * axisY);
+            breadth = max(breadth, axisX * dy - axisY * dx);
+        }
+        result.width = min(result.width, breadth);
+        result.minArea = min(result.minArea, (upper - lower) * breadth);
+        result.minPerimeter = min(result.minPerimeter, 2 * (upper - lower + breadth));
+    }
+    return result;
+}
+
+// The rectangle is flush with its edge and holds every vertex.
+bool checkRect(const CaliperRect& rect, const vector<Point2>& hull, double scale)
+{
+    size_t n = hull.size();
+    Point2 origin = hull[rect.edge];
+    Point2 next = hull[(rect.edge + 1) % n];
+    double length = distance(origin, next);
+    bool ok = rect.edge < n && near(rect.axisX, (double(next.x) - origin.x) / length, 1) &&
+        near(rect.axisY, (double(next.y) - origin.y) / length, 1) &&
+        near(rect.area, rect.length * rect.breadth, scale * scale) &&
+        near(rect.perimeter, 2 * (rect.length + rect.breadth), scale);
+    Point2 corner = rect.corners[0];
+    // The corners are rounded to float.
+    double slack = 1e-6 * scale;
+    for (const Point2& point : hull) {
+        double dx = double(point.x) - corner.x;
+        double dy = double(point.y) - corner.y;
+        double along = dx * rect.axisX + dy * rect.axisY;
+        double across = rect.axisX * dy - rect.axisY * dx;
+        ok = ok && along >= -slack && along <= rect.length + slack && across >= -slack && across <= rect.breadth + slack;
+    }
+    return ok;
+}
+
+void testAgainstBruteForce()
+{
+    mt19937 random(22);
+    for (int round = 0; round < 400; round++) {
+        vector<Point2> hull = HullOf(randomPoints(random, round % 4, 3 + random() % 300));
+        if (hull.size() < 3) {
+            continue;
+        }
+        BruteForce expected = bruteForce(hull);
+        double scale = expected.diameter;
+
+        CaliperResult result;
+        RotatingCalipers(hull.data(), hull.size(), CALIPER_ALL, result);
+        CHECK(near(result.diameter, expected.diameter, scale));
+        CHECK(result.diameterA < hull.size() && result.diameterB < hull.size() &&
+            near(distance(hull[result.diameterA], hull[result.diameterB]), expected.diameter, scale));
+
+        CHECK(near(result.width, expected.width, scale));
+        CHECK(result.widthEdge < hull.size() && result.widthVertex < hull.size());
+
+        CHECK(near(result.minAreaRect.area, expected.minArea, scale * scale));
+        CHECK(near(result.minPerimeterRect.perimeter, expected.minPerimeter, scale));
+        CHECK(checkRect(result.minAreaRect, hull, scale));
+        CHECK(checkRect(result.minPerimeterRect, hull, scale));
+
+        set<pair<size_t, size_t>> pairs(result.antipodalPairs.begin(), result.antipodalPairs.end());
+        CHECK(pairs.size() == result.antipodalPairs.size());
+        CHECK(pairs == expected.pairs);
+
+        // Each query alone gives what it gave as part of the full sweep.
+        CHECK(HullDiameter(hull.data(), hull.size()) == result.diameter);
+        CHECK(HullWidth(hull.data(), hull.size()) == result.width);
+        CaliperResult single;
+        RotatingCalipers(hull.data(), hull.size(), CALIPER_MIN_AREA_RECT, single);
+        CHECK(single.minAreaRect.area == result.minAreaRect.area && single.antipodalPairs.empty() &&
+            single.diameter == 0);
+    }
+}
+
+void testDegenerate()
+{
+    CaliperResult result;
+    RotatingCalipers(nullptr, 0, CALIPER_ALL, result);
+    CHECK(result.diameter == 0 && result.width == 0 && result.antipodalPairs.empty());
+
+    vector<Point2> point = { { 3, 4 } };
+    RotatingCalipers(point.data(), point.size(), CALIPER_ALL, result);
+    CHECK(result.diameter == 0 && result.minAreaRect.area == 0 && result.antipodalPairs.empty());
+
+    vector<Point2> segment = { { 0, 0 }, { 3, 4 } };
+    RotatingCalipers(segment.data(), segment.size(), CALIPER_ALL, result);
+    CHECK(result.diameter == 5 && result.width == 0 && result.minAreaRect.length == 5);
+    CHECK(result.minAreaRect.breadth == 0 && result.minPerimeterRect.perimeter == 10);
+    CHECK(result.antipodalPairs.size() == 1 && result.antipodalPairs[0] == make_pair(size_t(0), size_t(1)));
+}
+
+}
+
+int main()
+{
+    testAgainstBruteForce();
+    testDegenerate();
+    return TestResult();
+}
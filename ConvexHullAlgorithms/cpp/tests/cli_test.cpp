@@ -0,0 +1,224 @@
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <random>
+#include <string>
+#include <vector>
+
+#ifndef _WIN32
+#include <sys/wait.h>
+#endif
+
+#include "hullcore/minkowski.h"
+#include "hullcore/point_set.h"
+#include "test_support.h"
+
+using namespace std;
+using namespace hullcore;
+
+namespace {
+
+const char* outputPath = "cli_test_output.txt";
+
+// Exit code of the driver run with arguments, its output in outputPath.
+int runCli(const string& arguments)
+{
+    string command = string("\"") + HULLCORE_CLI + "\" -o " + outputPath + " " + arguments;
+    int status = system(command.c_str());
+#ifdef _WIN32
+    return status;
+#else
+    return WIFEXITED(status) ? WEXITSTATUS(status) : -1;
+#endif
+}
+
+vector<string> readLines(const char* path)
+{
+    vector<string> lines;
+    FILE* file = fopen(path, "r");
+    if (!file) {
+        return lines;
+    }
+    char line[1 << 16];
+    while (fgets(line, sizeof(line), file)) {
+        lines.push_back(line);
+    }
+    fclose(file);
+    return lines;
+}
+
+bool writeCsv(const char* path, const vector<Point2>& points)
+{
+    FILE* file = fopen(path, "w");
+    if (!file) {
+        return false;
+    }
+    fprintf(file, "x,y\n");
+    for (const Point2& point : points) {
+        fprintf(file, "%.9g,%.9g\n", point.x, point.y);
+    }
+    return fclose(file) == 0;
+}
+
+bool writeRaw(const char* path, const vector<Point2>& points)
+{
+    FILE* file = fopen(path, "wb");
+    if (!file) {
+        return false;
+    }
+    bool ok = fwrite(points.data(), sizeof(Point2), points.size(), file) == points.size();
+    return fclose(file) == 0 && ok;
+}
+
+bool has(const string& line, const string& text)
+{
+    return line.find(text) != string::npos;
+}
+
+// The "vertices" array of a result line; null entries read as NaN.
+vector<Point2> vertices(const string& line)
+{
+    vector<Point2> result;
+    size_t at = line.find("\"vertices\":[");
+    if (at == string::npos) {
+        return result;
+    }
+    const char* cursor = line.c_str() + at + strlen("\"vertices\":[");
+    while (*cursor == '[' || *cursor == ',') {
+        if (*cursor == ',')
+            cursor++;
+        if (*cursor != '[')
+            break;
+        char* end;
+        float x = strtof(cursor + 1, &end);
+        if (end == cursor + 1 && strncmp(end, "null", 4) == 0) {
+            x = NAN;
+            end += 4;
+        }
+        const char* yText = end + 1;
+        float y = strtof(yText, &end);
+        if (end == yText && strncmp(end, "null", 4) == 0) {
+            y = NAN;
+            end += 4;
+        }
+        result.push_back({ x, y });
+        cursor = end + 1;
+    }
+    return result;
+}
+
+string containmentCounts(const vector<Point2>& hull, const vector<Point2>& queries)
+{
+    unsigned long long inside = 0, boundary = 0, outside = 0;
+    for (const Point2& query : queries) {
+        Containment label = ReferenceClassify(hull, query);
+        (label == Containment::Outside ? outside : label == Containment::Boundary ? boundary : inside)++;
+    }
+    char text[128];
+    snprintf(text, sizeof(text), "\"inside\":%llu,\"boundary\":%llu,\"outside\":%llu", inside, boundary, outside);
+    return text;
+}
+
+void testJobs()
+{
+    mt19937 random(15);
+    uniform_int_distribution<int> coordinate(-50, 50);
+    auto points = [&](size_t count) {
+        vector<Point2> result(count);
+        for (Point2& point : result) {
+            point = { float(coordinate(random)), float(coordinate(random)) };
+        }
+        return result;
+    };
+    vector<Point2> a = points(500);
+    vector<Point2> b = points(40);
+    vector<Point2> queries1 = points(3000);
+    vector<Point2> queries2 = points(10);
+    CHECK(writeCsv("cli_test_a.csv", a));
+    CHECK(WritePointSet("cli_test_b.hps", b.data(), b.size()));
+    CHECK(writeRaw("cli_test_q1.bin", queries1));
+    CHECK(writeRaw("cli_test_q2.bin", queries2));
+
+    int status = runCli("--threads 3 hull cli_test_a.csv cli_test_b.hps contains cli_test_a.csv cli_test_q1.bin "
+                        "cli_test_q2.bin sum cli_test_a.csv cli_test_b.hps diff cli_test_a.csv cli_test_b.hps "
+                        "import cli_test_a.csv cli_test_imported.hps");
+    CHECK(status == 0);
+    vector<string> lines = readLines(outputPath);
+    CHECK(lines.size() == 7);
+    if (lines.size() != 7) {
+        return;
+    }
+    for (size_t i = 0; i < lines.size(); i++) {
+        CHECK(has(lines[i], "{\"job\":" + to_string(i) + ",") && has(lines[i], "\"ok\":true"));
+    }
+
+    vector<Point2> hullA = ReferenceHull(a);
+    CHECK(vertices(lines[0]) == hullA);
+    CHECK(vertices(lines[1]) == ReferenceHull(b));
+    CHECK(has(lines[2], containmentCounts(hullA, queries1)));
+    CHECK(has(lines[3], containmentCounts(hullA, queries2)));
+    CHECK(has(lines[2], "\"hull_vertices\":" + to_string(hullA.size())));
+
+    vector<Point2> cloud;
+    CalculateSum(a.data(), a.size(), b.data(), b.size(), cloud);
+    CHECK(SameCycle(vertices(lines[4]), ReferenceHull(cloud)));
+    cloud.clear();
+    CalculateDiff(a.data(), a.size(), b.data(), b.size(), cloud);
+    CHECK(SameCycle(vertices(lines[5]), ReferenceHull(cloud)));
+
+    CHECK(has(lines[6], "\"points\":500,\"skipped_lines\":1"));
+    PointSetFile imported;
+    CHECK(imported.Open("cli_test_imported.hps") && imported.Count() == a.size());
+    imported.Close();
+
+    // The same jobs as binary records start with the result magic.
+    CHECK(runCli("--format binary hull cli_test_b.hps") == 0);
+    FILE* binary = fopen(outputPath, "rb");
+    char magic[8] = {};
+    CHECK(binary && fread(magic, 1, sizeof(magic), binary) == sizeof(magic) && memcmp(magic, "HULLRES", 8) == 0);
+    if (binary) {
+        fclose(binary);
+    }
+
+    for (const char* path : { "cli_test_a.csv", "cli_test_b.hps", "cli_test_q1.bin", "cli_test_q2.bin",
+             "cli_test_imported.hps" }) {
+        remove(path);
+    }
+}
+
+// Every line must stay valid JSON: non-finite inputs are refused, and a sum
+// that overflows float writes null for the coordinates it lost.
+void testNonFinite()
+{
+    FILE* file = fopen("cli_test_bad.csv", "w");
+    fprintf(file, "0,0\n1,inf\n2,1\nnan,3\n");
+    fclose(file);
+    vector<Point2> huge = { { 3e38f, 0 }, { 3.2e38f, 1 }, { 3.1e38f, -2 } };
+    CHECK(writeRaw("cli_test_huge.bin", huge));
+
+    CHECK(runCli("hull cli_test_bad.csv contains cli_test_huge.bin cli_test_bad.csv sum cli_test_huge.bin "
+                 "cli_test_huge.bin") == 1);
+    vector<string> lines = readLines(outputPath);
+    CHECK(lines.size() == 3);
+    if (lines.size() != 3) {
+        return;
+    }
+    CHECK(has(lines[0], "\"ok\":false") && has(lines[0], "not finite"));
+    CHECK(has(lines[1], "\"ok\":false") && has(lines[1], "not finite"));
+    CHECK(has(lines[2], "\"ok\":true") && has(lines[2], "null"));
+    for (const string& line : lines) {
+        CHECK(!has(line, "inf") && !has(line, "nan"));
+    }
+    remove("cli_test_bad.csv");
+    remove("cli_test_huge.bin");
+}
+
+}
+
+int main()
+{
+    testJobs();
+    testNonFinite();
+    remove(outputPath);
+    return TestResult();
+}
@@ -0,0 +1,125 @@
+#include <cmath>
+#include <cstdio>
+#include <map>
+#include <random>
+#include <vector>
+
+#include "hullcore/dynamic_hull.h"
+#include "test_support.h"
+
+using namespace std;
+using namespace hullcore;
+
+namespace {
+
+Point2 randomPoint(mt19937& random, int kind)
+{
+    uniform_real_distribution<float> coordinate(-1000.0f, 1000.0f);
+    uniform_int_distribution<int> grid(-5, 5);
+    uniform_int_distribution<int> exponent(-30, 30);
+    switch (kind) {
+    case 0:
+        return { coordinate(random), coordinate(random) };
+    case 1:
+        // Few distinct points, so ids pile up on shared leaves.
+        return { float(grid(random)), float(grid(random)) };
+    case 2:
+        return { ldexp(float(grid(random)), exponent(random)), ldexp(float(grid(random)), exponent(random)) };
+    default: {
+        int t = grid(random) * 20 + grid(random);
+        return { float(t), float(-2 * t + 3) };
+    }
+    }
+}
+
+// The live points of the model, keyed by id, against the hull's answer.
+bool matchesModel(const DynamicHull& hull, const map<size_t, Point2>& model)
+{
+    vector<Point2> live;
+    for (const auto& entry : model) {
+        live.push_back(entry.second);
+        if (hull.Position(entry.first) != entry.second) {
+            return false;
+        }
+    }
+    vector<Point2> vertices;
+    vector<size_t> ids;
+    hull.Vertices(vertices, &ids);
+    if (hull.Size() != model.size() || vertices != ReferenceHull(live) || ids.size() != vertices.size()) {
+        return false;
+    }
+    for (size_t i = 0; i < ids.size(); i++) {
+        auto entry = model.find(ids[i]);
+        if (entry == model.end() || entry->second != vertices[i]) {
+            return false;
+        }
+    }
+    return true;
+}
+
+// Random inserts, erases and moves, each checked against the hull of the
+// live points recomputed from scratch.
+void testRandomUpdates(int rounds, size_t initialCount, int operations, int checkEvery)
+{
+    mt19937 random(20 + unsigned(initialCount));
+    for (int round = 0; round < rounds; round++) {
+        int kind = round % 4;
+        vector<Point2> initial(initialCount);
+        for (Point2& point : initial) {
+            point = randomPoint(random, kind);
+        }
+        DynamicHull hull;
+        hull.Build(initial.data(), initial.size());
+        map<size_t, Point2> model;
+        vector<size_t> liveIds;
+        for (size_t i = 0; i < initial.size(); i++) {
+            model[i] = initial[i];
+            liveIds.push_back(i);
+        }
+        CHECK(matchesModel(hull, model));
+
+        for (int operation = 0; operation < operations; operation++) {
+            unsigned choice = random() % 3;
+            if (choice == 0 || model.empty()) {
+                Point2 point = randomPoint(random, kind);
+                size_t id = hull.Insert(point);
+                CHECK(model.count(id) == 0);
+                model[id] = point;
+                liveIds.push_back(id);
+            }
+            else {
+                size_t slot = random() % liveIds.size();
+                size_t id = liveIds[slot];
+                if (choice == 1) {
+                    hull.Erase(id);
+                    model.erase(id);
+                    liveIds[slot] = liveIds.back();
+                    liveIds.pop_back();
+                }
+                else {
+                    Point2 point = randomPoint(random, kind);
+                    hull.Move(id, point);
+                    model[id] = point;
+                }
+            }
+            if (operation % checkEvery == 0) {
+                CHECK(matchesModel(hull, model));
+            }
+        }
+        CHECK(matchesModel(hull, model));
+
+        hull.Reset();
+        model.clear();
+        CHECK(matchesModel(hull, model));
+    }
+}
+
+}
+
+int main()
+{
+    testRandomUpdates(100, 0, 200, 1);
+    testRandomUpdates(40, 50, 300, 1);
+    testRandomUpdates(4, 20000, 20000, 2500);
+    return TestResult();
+}
@@ -0,0 +1,120 @@
+#include <cmath>
+#include <cstdio>
+#include <random>
+#include <vector>
+
+#include "hullcore/containment.h"
+#include "hullcore/hull.h"
+#include "hullcore/minkowski.h"
+#include "test_support.h"
+
+using namespace std;
+using namespace hullcore;
+
+namespace {
+
+// Small integer coordinates, so queries land on edges and vertices often and
+// every Minkowski vertex sum is exact in float.
+vector<Point2> gridPoints(mt19937& random, size_t count, int range)
+{
+    uniform_int_distribution<int> coordinate(-range, range);
+    vector<Point2> points(count);
+    for (Point2& point : points) {
+        point = { float(coordinate(random)), float(coordinate(random)) };
+    }
+    return points;
+}
+
+void testContainment()
+{
+    mt19937 random(2024);
+    for (int round = 0; round < 100; round++) {
+        vector<Point2> hull = HullOf(gridPoints(random, 4 + random() % 60, 20));
+        if (hull.size() < 3) {
+            continue;
+        }
+        ConvexHullQuery query;
+        query.Build(hull.data(), hull.size());
+
+        vector<Point2> points = gridPoints(random, 500, 24);
+        vector<Containment> labels(points.size());
+        query.ClassifyBatch(points.data(), points.size(), labels.data());
+        vector<uint64_t> mask((points.size() + 63) / 64);
+        query.ContainsBatch(points.data(), points.size(), mask.data());
+        for (size_t i = 0; i < points.size(); i++) {
+            Containment expected = ReferenceClassify(hull, points[i]);
+            CHECK(query.Classify(points[i]) == expected);
+            CHECK(labels[i] == expected);
+            CHECK(bool((mask[i / 64] >> (i % 64)) & 1) == (expected != Containment::Outside));
+        }
+    }
+}
+
+// Degenerate hulls of one segment. Coordinates as small as 1e-30 make any float
+// product of offsets underflow, so only exact tests get the ends right.
+void testSegmentHull()
+{
+    ConvexHullQuery query;
+    Point2 segment[] = { { 0, 0 }, { 1e-30f, 1e-30f } };
+    query.Build(segment, 2);
+    CHECK(query.Classify({ 2e-30f, 2e-30f }) == Containment::Outside);
+    CHECK(query.Classify({ -1e-30f, -1e-30f }) == Containment::Outside);
+    CHECK(query.Classify({ 5e-31f, 5e-31f }) == Containment::Boundary);
+    CHECK(query.Classify({ 1e-30f, 1e-30f }) == Containment::Boundary);
+    CHECK(query.Classify({ 1e-30f, 0 }) == Containment::Outside);
+
+    // Along a line the ends bound the segment coordinate by coordinate, which
+    // needs no arithmetic to check.
+    mt19937 random(31);
+    uniform_int_distribution<int> step(-8, 8);
+    uniform_int_distribution<int> exponent(-140, 100);
+    for (int round = 0; round < 2000; round++) {
+        float scale = ldexp(1.0f, exponent(random));
+        Point2 a = { scale * step(random), scale * step(random) };
+        int dx = step(random);
+        int dy = step(random);
+        int t0 = step(random);
+        int t1 = step(random);
+        Point2 ends[] = { { a.x + scale * dx * t0, a.y + scale * dy * t0 }, { a.x + scale * dx * t1, a.y + scale * dy * t1 } };
+        if (ends[0] == ends[1] || Orient2dExact(ends[0], ends[1], a) != 0) {
+            continue;
+        }
+        query.Build(ends, 2);
+        bool between = min(ends[0].x, ends[1].x) <= a.x && a.x <= max(ends[0].x, ends[1].x) &&
+            min(ends[0].y, ends[1].y) <= a.y && a.y <= max(ends[0].y, ends[1].y);
+        CHECK(query.Classify(a) == (between ? Containment::Boundary : Containment::Outside));
+    }
+}
+
+void testMinkowski()
+{
+    mt19937 random(99);
+    for (int round = 0; round < 100; round++) {
+        vector<Point2> a = HullOf(gridPoints(random, 3 + random() % 40, 50));
+        vector<Point2> b = HullOf(gridPoints(random, 3 + random() % 40, 50));
+        if (a.size() < 3 || b.size() < 3) {
+            continue;
+        }
+
+        vector<Point2> cloud;
+        vector<Point2> result;
+        CalculateSum(a.data(), a.size(), b.data(), b.size(), cloud);
+        ConvexMinkowskiSum(a.data(), a.size(), b.data(), b.size(), result);
+        CHECK(SameCycle(result, ReferenceHull(cloud)));
+
+        cloud.clear();
+        CalculateDiff(a.data(), a.size(), b.data(), b.size(), cloud);
+        ConvexMinkowskiDiff(a.data(), a.size(), b.data(), b.size(), result);
+        CHECK(SameCycle(result, ReferenceHull(cloud)));
+    }
+}
+
+}
+
+int main()
+{
+    testContainment();
+    testSegmentHull();
+    testMinkowski();
+    return TestResult();
+}
@@ -0,0 +1,153 @@
+#include <algorithm>
+#include <cmath>
+#include <cstdio>
+#include <random>
+#include <vector>
+
+#include "hullcore/gjk.h"
+#include "hullcore/minkowski.h"
+#include "test_support.h"
+
+using namespace std;
+using namespace hullcore;
+
+namespace {
+
+// Relative to the size of the polygons, which stay within a few hundred units.
+const double tolerance = 1e-6;
+
+vector<Point2> randomPolygon(mt19937& random, float centerX, float centerY)
+{
+    uniform_real_distribution<float> radius(1.0f, 60.0f);
+    uniform_real_distribution<float> angle(0.0f, 6.2831853f);
+    float size = radius(random);
+    vector<Point2> points(3 + random() % 30);
+    for (Point2& point : points) {
+        float a = angle(random);
+        float r = size * sqrt(float(random() % 1001) / 1000);
+        point = { centerX + r * cos(a), centerY + r * sin(a) };
+    }
+    return HullOf(points);
+}
+
+double edgeLineDistance(const Point2& a, const Point2& b, double x, double y)
+{
+    double ex = double(b.x) - a.x;
+    double ey = double(b.y) - a.y;
+    return (ex * (y - a.y) - ey * (x - a.x)) / sqrt(ex * ex + ey * ey);
+}
+
+double segmentDistance(const Point2& a, const Point2& b)
+{
+    double ex = double(b.x) - a.x;
+    double ey = double(b.y) - a.y;
+    double t = -(double(a.x) * ex + double(a.y) * ey) / (ex * ex + ey * ey);
+    t = min(max(t, 0.0), 1.0);
+    return hypot(a.x + t * ex, a.y + t * ey);
+}
+
+// Distance from the origin to the counter-clockwise polygon, and how deep the
+// origin sits inside it, the smallest distance to an edge line, when it does.
+void referenceQuery(const vector<Point2>& difference, double& distance, double& depth)
+{
+    distance = 0;
+    depth = INFINITY;
+    bool inside = true;
+    double nearest = INFINITY;
+    for (size_t i = 0; i < difference.size(); i++) {
+        const Point2& a = difference[i];
+        const Point2& b = difference[(i + 1) % difference.size()];
+        double side = edgeLineDistance(a, b, 0, 0);
+        inside = inside && side >= 0;
+        depth = min(depth, side);
+        nearest = min(nearest, segmentDistance(a, b));
+    }
+    if (!inside) {
+        distance = nearest;
+        depth = 0;
+    }
+}
+
+// The difference a - b is the hull of every pairwise vertex difference; GJK
+// must agree with it on separation, distance and penetration depth.
+void testAgainstMinkowskiDifference()
+{
+    mt19937 random(909);
+    uniform_real_distribution<float> offset(-100.0f, 100.0f);
+    size_t separated = 0;
+    size_t overlapping = 0;
+    for (int round = 0; round < 2000; round++) {
+        vector<Point2> a = randomPolygon(random, offset(random), offset(random));
+        vector<Point2> b = randomPolygon(random, offset(random), offset(random));
+        if (a.size() < 3 || b.size() < 3) {
+            continue;
+        }
+        vector<Point2> cloud;
+        CalculateDiff(a.data(), a.size(), b.data(), b.size(), cloud);
+        vector<Point2> difference = ReferenceHull(cloud);
+        double distance = 0;
+        double depth = 0;
+        referenceQuery(difference, distance, depth);
+
+        GjkResult result = GjkQuery(a.data(), a.size(), b.data(), b.size());
+        double scale = 200 * tolerance;
+        if (distance > scale) {
+            separated++;
+            CHECK(!result.intersecting);
+            CHECK(fabs(result.distance - distance) <= scale);
+            double gap = hypot(double(result.closestA.x) - result.closestB.x, double(result.closestA.y) - result.closestB.y);
+            CHECK(fabs(gap - distance) <= scale);
+        }
+        else if (depth > scale) {
+            overlapping++;
+            CHECK(result.intersecting);
+            CHECK(fabs(result.penetrationDepth - depth) <= scale);
+            CHECK(fabs(hypot(result.normalX, result.normalY) - 1) <= tolerance);
+            // Moving b by the depth along the normal must leave the origin on
+            // the boundary of a - b, that is on its supporting line that way.
+            double support = -INFINITY;
+            for (const Point2& vertex : difference) {
+                support = max(support, vertex.x * result.normalX + vertex.y * result.normalY);
+            }
+            CHECK(fabs(support - result.penetrationDepth) <= scale);
+        }
+
+        // A warm cache must not change the answer.
+        GjkCache cache;
+        GjkQuery(a.data(), a.size(), b.data(), b.size(), &cache);
+        GjkResult cached = GjkQuery(a.data(), a.size(), b.data(), b.size(), &cache);
+        CHECK(cached.intersecting == result.intersecting);
+        CHECK(fabs(cached.distance - result.distance) <= scale);
+        CHECK(fabs(cached.penetrationDepth - result.penetrationDepth) <= scale);
+    }
+    // Both branches must actually have been exercised.
+    CHECK(separated > 100);
+    CHECK(overlapping > 100);
+}
+
+void testSupportVertex()
+{
+    mt19937 random(17);
+    uniform_real_distribution<double> direction(-1.0, 1.0);
+    for (int round = 0; round < 200; round++) {
+        vector<Point2> polygon = randomPolygon(random, 0, 0);
+        double dx = direction(random);
+        double dy = direction(random);
+        double best = -INFINITY;
+        for (const Point2& vertex : polygon) {
+            best = max(best, vertex.x * dx + vertex.y * dy);
+        }
+        size_t hint = random() % polygon.size();
+        size_t index = SupportVertex(polygon.data(), polygon.size(), dx, dy, hint);
+        CHECK(polygon[index].x * dx + polygon[index].y * dy >= best - tolerance);
+    }
+}
+
+}
+
+int main()
+{
+    testAgainstMinkowskiDifference();
+    testSupportVertex();
+    return TestResult();
+}
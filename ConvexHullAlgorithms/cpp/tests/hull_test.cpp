@@ -0,0 +1,228 @@
+#include <cmath>
+#include <cstdint>
+#include <cstdio>
+#include <random>
+#include <string>
+#include <vector>
+
+#include "hullcore/hull.h"
+#include "hullcore/quickhull.h"
+#include "test_support.h"
+
+using namespace std;
+using namespace hullcore;
+
+namespace {
+
+struct Engine {
+    HullEngine engine;
+    const char* name;
+};
+
+const Engine engines[] = {
+    { HullEngine::QuickHull, "quickhull" },
+    { HullEngine::MonotoneChain, "monotone-chain" },
+    { HullEngine::ParallelQuickHull, "parallel-quickhull" },
+    { HullEngine::SimdQuickHull, "simd-quickhull" },
+    { HullEngine::Chan, "chan" },
+};
+
+vector<Point2> pointsAt(const vector<Point2>& points, const vector<size_t>& indices)
+{
+    vector<Point2> result;
+    for (size_t index : indices) {
+        result.push_back(points[index]);
+    }
+    return result;
+}
+
+// Every engine, with and without the prefilter, and the SIMD engine at every
+// level this machine runs, must give exactly the reference hull.
+void checkAllEngines(const char* name, const vector<Point2>& points)
+{
+    vector<Point2> reference = ReferenceHull(points);
+    vector<size_t> indices;
+    for (const Engine& engine : engines) {
+        for (bool prefilter : { false, true }) {
+            HullOptions options;
+            options.prefilter = prefilter;
+            CalculateHull(points.data(), points.size(), indices, engine.engine, options);
+            bool same = pointsAt(points, indices) == reference;
+            if (!same) {
+                fprintf(stderr, "%s: %s%s gave %zu vertices, expected %zu\n", name, engine.name,
+                    prefilter ? "+prefilter" : "", indices.size(), reference.size());
+            }
+            CHECK(same);
+        }
+    }
+    for (int level = 0; level <= int(DetectSimdLevel()); level++) {
+        CalculateSimdQuickHull(points.data(), points.size(), indices, SimdLevel(level));
+        bool same = pointsAt(points, indices) == reference;
+        if (!same) {
+            fprintf(stderr, "%s: simd-quickhull at %s gave %zu vertices, expected %zu\n", name,
+                SimdLevelName(SimdLevel(level)), indices.size(), reference.size());
+        }
+        CHECK(same);
+    }
+}
+
+float mixedExponent(mt19937& random, int lowExponent, int highExponent)
+{
+    uniform_int_distribution<int> exponent(lowExponent, highExponent);
+    uniform_real_distribution<float> mantissa(-1.0f, 1.0f);
+    return ldexp(mantissa(random), exponent(random));
+}
+
+void testDegenerateInputs()
+{
+    checkAllEngines("empty", {});
+    checkAllEngines("single", { { 3, 4 } });
+    checkAllEngines("duplicates", vector<Point2>(50, Point2{ -2, 7 }));
+    checkAllEngines("two points", { { 1, 1 }, { 5, -3 }, { 1, 1 } });
+
+    vector<Point2> line;
+    for (int i = -40; i <= 40; i++) {
+        line.push_back({ float(i), float(3 * i - 2) });
+    }
+    checkAllEngines("collinear", line);
+
+    vector<Point2> square;
+    for (int x = 0; x <= 10; x++) {
+        for (int y = 0; y <= 10; y++) {
+            square.push_back({ float(x), float(y) });
+        }
+    }
+    checkAllEngines("grid", square);
+}
+
+void testRandomInputs()
+{
+    mt19937 random(12345);
+    for (int round = 0; round < 200; round++) {
+        size_t count = 3 + random() % (round % 10 == 0 ? 3000 : 80);
+        vector<Point2> points(count);
+        string name = "random " + to_string(round);
+        switch (round % 4) {
+        case 0: {
+            uniform_real_distribution<float> coordinate(-1000.0f, 1000.0f);
+            for (Point2& point : points) {
+                point = { coordinate(random), coordinate(random) };
+            }
+            break;
+        }
+        case 1: {
+            // Small integer grids pile up duplicates and collinear points.
+            int range = 1 + int(random() % 12);
+            uniform_int_distribution<int> coordinate(-range, range);
+            for (Point2& point : points) {
+                point = { float(coordinate(random)), float(coordinate(random)) };
+            }
+            break;
+        }
+        case 2: {
+            uniform_real_distribution<float> angle(0.0f, 6.2831853f);
+            for (Point2& point : points) {
+                float a = angle(random);
+                point = { 1000.0f * cos(a), 1000.0f * sin(a) };
+            }
+            break;
+        }
+        default:
+            for (Point2& point : points) {
+                point = { mixedExponent(random, -40, 40), mixedExponent(random, -40, 40) };
+            }
+            break;
+        }
+        checkAllEngines(name.c_str(), points);
+    }
+}
+
+void checkDataFile(const char* name)
+{
+    vector<Point2> points;
+    bool loaded = ReadPoints(TestDataPath(name), points);
+    if (!loaded) {
+        fprintf(stderr, "cannot read %s\n", TestDataPath(name).c_str());
+    }
+    CHECK(loaded);
+    checkAllEngines(name, points);
+}
+
+// Inputs that once gave a wrong hull or never finished.
+void testRegressionInputs()
+{
+    checkDataFile("chan_collinear_outliers.txt");
+    checkDataFile("chan_collinear_full.txt");
+    checkDataFile("quickhull_near_tie_53.txt");
+    checkDataFile("quickhull_near_tie_767.txt");
+    checkDataFile("quickhull_near_tie_1318.txt");
+}
+
+// Points on one line with a few thrown far off it, so many candidates tie in
+// direction from a hull vertex and only their distance along the line tells
+// them apart.
+void testCollinearOutliers()
+{
+    mt19937 random(4242);
+    for (int round = 0; round < 100; round++) {
+        int range = 1 + int(random() % (round % 2 ? 20 : 100000));
+        uniform_int_distribution<int> t(-range, range);
+        vector<Point2> points(3 + random() % (round % 10 == 0 ? 2000 : 80));
+        for (Point2& point : points) {
+            int x = t(random);
+            point = { float(x), float(2 * x + 1) };
+            if (random() % 5 == 0) {
+                point.y = ldexp(random() % 2 ? 1.0f : -1.0f, 20 + int(random() % 100));
+            }
+        }
+        string name = "collinear outliers " + to_string(round);
+        checkAllEngines(name.c_str(), points);
+    }
+}
+
+// Small integers scaled by powers of two across 80 binades, so many points lie
+// on shared lines at wildly different scales and the farthest point from a
+// hull edge often ties with others to within the rounding of its distance.
+void testScaledIntegers()
+{
+    mt19937 random(5150);
+    uniform_int_distribution<int> mantissa(-3, 3);
+    uniform_int_distribution<int> exponent(-40, 40);
+    for (int round = 0; round < 200; round++) {
+        vector<Point2> points(3 + random() % (round % 4 ? 60 : 1500));
+        for (Point2& point : points) {
+            point = { ldexp(float(mantissa(random)), exponent(random)), ldexp(float(mantissa(random)), exponent(random)) };
+        }
+        string name = "scaled integers " + to_string(round);
+        checkAllEngines(name.c_str(), points);
+    }
+}
+
+// Large enough for the parallel engines to split their scans across the pool.
+void testLargeInput()
+{
+    mt19937 random(777);
+    uniform_real_distribution<float> coordinate(-1.0f, 1.0f);
+    vector<Point2> points(300000);
+    for (Point2& point : points) {
+        point = { coordinate(random), coordinate(random) };
+        float length = sqrt(point.x * point.x + point.y * point.y);
+        if (length > 1.0f) {
+            point = { point.x / length, point.y / length };
+        }
+    }
+    checkAllEngines("large disk", points);
+}
+
+}
+
+int main()
+{
+    testDegenerateInputs();
+    testRandomInputs();
+    testRegressionInputs();
+    testCollinearOutliers();
+    testScaledIntegers();
+    testLargeInput();
+    return TestResult();
+}
@@ -0,0 +1,144 @@
+#include <cmath>
+#include <cstdint>
+#include <cstdio>
+#include <random>
+#include <string>
+#include <vector>
+
+#include "hullcore/incremental_hull.h"
+#include "test_support.h"
+
+using namespace std;
+using namespace hullcore;
+
+namespace {
+
+vector<Point2> randomStream(mt19937& random, int kind, size_t count)
+{
+    uniform_real_distribution<float> coordinate(-1000.0f, 1000.0f);
+    uniform_int_distribution<int> grid(-6, 6);
+    uniform_int_distribution<int> exponent(-30, 30);
+    uniform_real_distribution<float> angle(0.0f, 6.2831853f);
+    vector<Point2> points(count);
+    for (size_t i = 0; i < count; i++) {
+        Point2& point = points[i];
+        switch (kind) {
+        case 0:
+            point = { coordinate(random), coordinate(random) };
+            break;
+        case 1:
+            point = { float(grid(random)), float(grid(random)) };
+            break;
+        case 2: {
+            // Points on a circle that grows, so most inserts change the hull.
+            float a = angle(random);
+            float r = 1.0f + float(i);
+            point = { r * cos(a), r * sin(a) };
+            break;
+        }
+        case 3:
+            point = { ldexp(float(grid(random)), exponent(random)), ldexp(float(grid(random)), exponent(random)) };
+            break;
+        default: {
+            int t = grid(random) * 100 + grid(random);
+            point = { float(t), float(3 * t - 7) };
+            break;
+        }
+        }
+    }
+    return points;
+}
+
+bool matchesReference(const IncrementalHull& hull, const vector<Point2>& inserted, const vector<Point2>& reference)
+{
+    vector<Point2> vertices;
+    vector<uint64_t> indices;
+    hull.Vertices(vertices, &indices);
+    if (vertices != reference || hull.VertexCount() != vertices.size() || indices.size() != vertices.size() ||
+        hull.PointCount() != inserted.size()) {
+        return false;
+    }
+    for (size_t i = 0; i < vertices.size(); i++) {
+        if (indices[i] >= inserted.size() || inserted[indices[i]] != vertices[i]) {
+            return false;
+        }
+    }
+    return true;
+}
+
+// Small streams are checked after every insert, including what Insert
+// returns and what Contains says about random queries; the reference hull of
+// the prefix is recomputed each time.
+void testEveryInsert()
+{
+    mt19937 random(19);
+    for (int round = 0; round < 100; round++) {
+        vector<Point2> points = randomStream(random, round % 5, 1 + random() % 120);
+        vector<Point2> queries = randomStream(random, round % 5, 20);
+        IncrementalHull hull;
+        vector<Point2> inserted;
+        vector<Point2> reference;
+        for (const Point2& point : points) {
+            bool outside = ReferenceClassify(reference, point) == Containment::Outside;
+            CHECK(hull.Insert(point) == outside);
+            inserted.push_back(point);
+            reference = ReferenceHull(inserted);
+            CHECK(matchesReference(hull, inserted, reference));
+            for (const Point2& query : queries) {
+                CHECK(hull.Contains(query) == (ReferenceClassify(reference, query) != Containment::Outside));
+            }
+        }
+    }
+}
+
+void testLongStreams()
+{
+    mt19937 random(190);
+    for (int round = 0; round < 20; round++) {
+        vector<Point2> points = randomStream(random, round % 5, 20000);
+        IncrementalHull hull;
+        vector<Point2> inserted;
+        for (size_t i = 0; i < points.size(); i++) {
+            hull.Insert(points[i]);
+            inserted.push_back(points[i]);
+            if (i % 4999 == 0 || i + 1 == points.size()) {
+                CHECK(matchesReference(hull, inserted, ReferenceHull(inserted)));
+            }
+        }
+
+        hull.Reset();
+        CHECK(hull.VertexCount() == 0 && hull.PointCount() == 0);
+    }
+}
+
+// Seeding from a finished hull and inserting the rest must end where
+// inserting everything would.
+void testSeed()
+{
+    mt19937 random(191);
+    for (int round = 0; round < 50; round++) {
+        vector<Point2> points = randomStream(random, round % 5, 2 + random() % 3000);
+        size_t seeded = random() % points.size();
+        vector<size_t> hullIndices;
+        CalculateHull(points.data(), seeded, hullIndices);
+
+        IncrementalHull hull;
+        hull.Seed(points.data(), seeded, hullIndices);
+        for (size_t i = seeded; i < points.size(); i++) {
+            hull.Insert(points[i]);
+        }
+        vector<Point2> vertices;
+        hull.Vertices(vertices);
+        CHECK(vertices == ReferenceHull(points));
+    }
+}
+
+}
+
+int main()
+{
+    testEveryInsert();
+    testLongStreams();
+    testSeed();
+    return TestResult();
+}
@@ -0,0 +1,205 @@
+#include <algorithm>
+#include <cmath>
+#include <cstdio>
+#include <random>
+#include <vector>
+
+#include "hullcore/intersection.h"
+#include "test_support.h"
+
+using namespace std;
+using namespace hullcore;
+
+namespace {
+
+struct Vec {
+    double x;
+    double y;
+};
+
+double cross(Vec o, Vec a, Vec b)
+{
+    return (a.x - o.x) * (b.y - o.y) - (a.y - o.y) * (b.x - o.x);
+}
+
+double area(const vector<Vec>& polygon)
+{
+    double twice = 0;
+    for (size_t i = 0; i < polygon.size(); i++) {
+        const Vec& p = polygon[i];
+        const Vec& q = polygon[(i + 1) % polygon.size()];
+        twice += p.x * q.y - p.y * q.x;
+    }
+    return twice / 2;
+}
+
+// Sutherland-Hodgman: clip a by the half-plane left of each edge of b in turn.
+double clippedArea(const vector<Point2>& a, const vector<Point2>& b)
+{
+    vector<Vec> polygon;
+    for (const Point2& point : a) {
+        polygon.push_back({ point.x, point.y });
+    }
+    for (size_t i = 0; i < b.size() && !polygon.empty(); i++) {
+        Vec e0 = { b[i].x, b[i].y };
+        Vec e1 = { b[(i + 1) % b.size()].x, b[(i + 1) % b.size()].y };
+        vector<Vec> clipped;
+        for (size_t j = 0; j < polygon.size(); j++) {
+            Vec p = polygon[j];
+            Vec q = polygon[(j + 1) % polygon.size()];
+            double sideP = cross(e0, e1, p);
+            double sideQ = cross(e0, e1, q);
+            if (sideP >= 0) {
+                clipped.push_back(p);
+            }
+            if ((sideP >= 0) != (sideQ >= 0)) {
+                double t = sideP / (sideP - sideQ);
+                clipped.push_back({ p.x + t * (q.x - p.x), p.y + t * (q.y - p.y) });
+            }
+        }
+        polygon = clipped;
+    }
+    return polygon.size() < 3 ? 0 : area(polygon);
+}
+
+vector<Point2> randomHull(mt19937& random, int kind)
+{
+    uniform_real_distribution<float> coordinate(-100.0f, 100.0f);
+    uniform_real_distribution<float> offset(-150.0f, 150.0f);
+    uniform_int_distribution<int> grid(-4, 4);
+    uniform_real_distribution<float> angle(0.0f, 6.2831853f);
+    size_t count = 3 + random() % 60;
+    vector<Point2> points(count);
+    float dx = offset(random), dy = offset(random);
+    float radius = 10 + fabs(coordinate(random));
+    for (Point2& point : points) {
+        switch (kind) {
+        case 0:
+            point = { dx + coordinate(random), dy + coordinate(random) };
+            break;
+        case 1: {
+            float a = angle(random);
+            point = { dx + radius * cos(a), dy + radius * sin(a) };
+            break;
+        }
+        default:
+            // Grid hulls share edges, vertices and whole polygons.
+            point = { float(grid(random)), float(grid(random)) };
+            break;
+        }
+    }
+    return HullOf(points);
+}
+
+// A counter-clockwise convex polygon inside both inputs.
+bool checkResult(const vector<Point2>& result, const vector<Point2>& a, const vector<Point2>& b, double scale)
+{
+    if (result.empty()) {
+        return true;
+    }
+    bool ok = result.size() >= 3;
+    double slack = 1e-5 * scale;
+    for (size_t i = 0; ok && i < result.size(); i++) {
+        Vec p = { result[i].x, result[i].y };
+        Vec q = { result[(i + 1) % result.size()].x, result[(i + 1) % result.size()].y };
+        Vec r = { result[(i + 2) % result.size()].x, result[(i + 2) % result.size()].y };
+        ok = cross(p, q, r) >= -slack * scale;
+        for (const vector<Point2>* polygon : { &a, &b }) {
+            for (size_t j = 0; ok && j < polygon->size(); j++) {
+                Point2 e0 = (*polygon)[j];
+                Point2 e1 = (*polygon)[(j + 1) % polygon->size()];
+                double length = hypot(double(e1.x) - e0.x, double(e1.y) - e0.y);
+                ok = cross({ e0.x, e0.y }, { e1.x, e1.y }, p) >= -slack * length;
+            }
+        }
+    }
+    return ok;
+}
+
+void testAgainstClipping()
+{
+    mt19937 random(23);
+    for (int round = 0; round < 2000; round++) {
+        vector<Point2> a = randomHull(random, round % 3);
+        vector<Point2> b = round % 7 == 0 ? a : randomHull(random, (round / 3) % 3);
+        if (a.size() < 3 || b.size() < 3) {
+            continue;
+        }
+        // Any starting vertex will do.
+        rotate(b.begin(), b.begin() + random() % b.size(), b.end());
+
+        double scale = 1;
+        for (const Point2& point : a) {
+            scale = max(scale, double(max(fabs(point.x), fabs(point.y))));
+        }
+        for (const Point2& point : b) {
+            scale = max(scale, double(max(fabs(point.x), fabs(point.y))));
+        }
+        double expected = clippedArea(a, b);
+        vector<Point2> result;
+        double computed = ConvexIntersection(a.data(), a.size(), b.data(), b.size(), result);
+        CHECK(fabs(computed - expected) <= 1e-9 * scale * scale);
+        CHECK(checkResult(result, a, b, scale));
+        CHECK(result.empty() == (computed == 0));
+        CHECK(fabs(PolygonArea(result.data(), result.size()) - computed) <= 1e-5 * scale * scale);
+
+        // Intersection is symmetric.
+        vector<Point2> swapped;
+        CHECK(fabs(ConvexIntersection(b.data(), b.size(), a.data(), a.size(), swapped) - computed) <=
+            1e-9 * scale * scale);
+    }
+}
+
+// The batch gives each pair what the single call gives, bounding box
+// rejection included.
+void testBatch()
+{
+    mt19937 random(230);
+    for (int round = 0; round < 20; round++) {
+        vector<Point2> a = randomHull(random, round % 3);
+        vector<vector<Point2>> others(1 + random() % 500);
+        vector<PolygonRef> refs;
+        for (size_t i = 0; i < others.size(); i++) {
+            others[i] = randomHull(random, int(i % 3));
+            refs.push_back({ others[i].data(), others[i].size() });
+        }
+        vector<double> areas(others.size());
+        vector<vector<Point2>> results(others.size());
+        ConvexIntersectionBatch(a.data(), a.size(), refs.data(), refs.size(), areas.data(), results.data());
+        vector<double> areasOnly(others.size());
+        ConvexIntersectionBatch(a.data(), a.size(), refs.data(), refs.size(), areasOnly.data());
+        for (size_t i = 0; i < others.size(); i++) {
+            vector<Point2> result;
+            double expected = ConvexIntersection(a.data(), a.size(), others[i].data(), others[i].size(), result);
+            CHECK(areas[i] == expected && areasOnly[i] == expected && results[i] == result);
+        }
+    }
+}
+
+void testDegenerate()
+{
+    vector<Point2> square = { { 0, 0 }, { 2, 0 }, { 2, 2 }, { 0, 2 } };
+    vector<Point2> touching = { { 2, 0 }, { 4, 0 }, { 4, 2 }, { 2, 2 } };
+    vector<Point2> corner = { { 2, 2 }, { 4, 2 }, { 4, 4 } };
+    vector<Point2> inner = { { 0.5f, 0.5f }, { 1, 0.5f }, { 1, 1 } };
+    vector<Point2> result;
+    CHECK(ConvexIntersection(square.data(), square.size(), touching.data(), touching.size(), result) == 0 &&
+        result.empty());
+    CHECK(ConvexIntersection(square.data(), square.size(), corner.data(), corner.size(), result) == 0 &&
+        result.empty());
+    CHECK(ConvexIntersection(square.data(), 2, square.data(), square.size(), result) == 0 && result.empty());
+    CHECK(ConvexIntersection(square.data(), square.size(), inner.data(), inner.size(), result) == 0.125);
+    CHECK(SameCycle(result, inner));
+    CHECK(ConvexIntersection(square.data(), square.size(), square.data(), square.size(), result) == 4);
+    CHECK(SameCycle(result, square));
+}
+
+}
+
+int main()
+{
+    testAgainstClipping();
+    testBatch();
+    testDegenerate();
+    return TestResult();
+}
@@ -0,0 +1,193 @@
+#include <cstdio>
+#include <memory>
+#include <random>
+#include <vector>
+
+#include "hullcore/point_grid.h"
+#include "scene/picker.h"
+#include "scene/shapes.h"
+#include "test_support.h"
+
+using namespace std;
+using hullcore::Point2;
+using hullcore::PointGrid;
+
+namespace {
+
+struct Circle {
+    Point2 center;
+    float radius;
+    bool live;
+};
+
+// Largest live id whose circle holds p strictly inside, by looking at all.
+uint32_t linearPick(const vector<Circle>& circles, Point2 p)
+{
+    for (size_t id = circles.size(); id-- > 0;) {
+        const Circle& circle = circles[id];
+        float dx = p.x - circle.center.x;
+        float dy = p.y - circle.center.y;
+        if (circle.live && dx * dx + dy * dy < circle.radius * circle.radius) {
+            return uint32_t(id);
+        }
+    }
+    return PointGrid::None;
+}
+
+Point2 randomPoint(mt19937& random, int kind)
+{
+    uniform_real_distribution<float> coordinate(-2000.0f, 2000.0f);
+    normal_distribution<float> cluster(0.0f, 15.0f);
+    uniform_int_distribution<int> grid(-20, 20);
+    switch (kind) {
+    case 0:
+        return { coordinate(random), coordinate(random) };
+    case 1:
+        // Crowded into a few cells.
+        return { cluster(random), cluster(random) };
+    default:
+        // On cell borders and corners.
+        return { 64.0f * float(grid(random) / 4), 32.0f * float(grid(random)) };
+    }
+}
+
+// Random inserts, moves and erases, with picks at random spots and right next
+// to circles checked against the linear scan after every step.
+void testGrid(float cellSize, float maxRadius, int kind)
+{
+    mt19937 random{ unsigned(cellSize + maxRadius) + unsigned(kind) };
+    uniform_real_distribution<float> radius(0.5f, maxRadius);
+    uniform_real_distribution<float> jitter(-1.0f, 1.0f);
+    PointGrid grid(cellSize);
+    vector<Circle> circles;
+    for (int operation = 0; operation < 3000; operation++) {
+        unsigned choice = random() % 4;
+        if (choice < 2 || circles.empty()) {
+            // Reuse a free id now and then, as callers keep ids dense.
+            uint32_t id = uint32_t(circles.size());
+            if (random() % 2 && !circles.empty() && !circles[random() % circles.size()].live) {
+                id = uint32_t(random() % circles.size());
+            }
+            if (id < circles.size() && circles[id].live) {
+                id = uint32_t(circles.size());
+            }
+            Circle circle = { randomPoint(random, kind), radius(random), true };
+            grid.Insert(id, circle.center, circle.radius);
+            if (id == circles.size()) {
+                circles.push_back(circle);
+            }
+            else {
+                circles[id] = circle;
+            }
+        }
+        else {
+            uint32_t id = uint32_t(random() % circles.size());
+            if (!circles[id].live) {
+                continue;
+            }
+            if (choice == 2) {
+                circles[id].center = randomPoint(random, kind);
+                grid.Move(id, circles[id].center);
+            }
+            else {
+                circles[id].live = false;
+                grid.Erase(id);
+            }
+        }
+
+        size_t live = 0;
+        for (uint32_t id = 0; id < circles.size(); id++) {
+            live += circles[id].live;
+            CHECK(grid.Contains(id) == circles[id].live);
+        }
+        CHECK(grid.Size() == live);
+        for (int query = 0; query < 8; query++) {
+            Point2 p = randomPoint(random, kind);
+            if (query % 2) {
+                const Circle& near = circles[random() % circles.size()];
+                p = { near.center.x + near.radius * jitter(random), near.center.y + near.radius * jitter(random) };
+            }
+            CHECK(grid.Pick(p) == linearPick(circles, p));
+        }
+    }
+
+    grid.Clear();
+    CHECK(grid.Size() == 0 && grid.Pick({ 0, 0 }) == PointGrid::None);
+}
+
+// What the window did before the picker: walk the list from the top and take
+// the first shape that is interactable in state and under the mouse.
+int linearPick(const vector<Shape*>& shapes, float x, float y, AppState state)
+{
+    for (size_t i = shapes.size(); i-- > 0;) {
+        AppState target = shapes[i]->targetAppState;
+        if ((target == NONE || target == state) && shapes[i]->IsMouseOverlapping(x, y)) {
+            return int(i);
+        }
+    }
+    return -1;
+}
+
+void testShapePicker()
+{
+    mt19937 random(25);
+    uniform_real_distribution<float> coordinate(0.0f, 800.0f);
+    uniform_real_distribution<float> size(5.0f, 200.0f);
+    uniform_int_distribution<int> stateOf(QUICK_HULL, NONE);
+    for (int round = 0; round < 20; round++) {
+        vector<unique_ptr<Shape>> owned;
+        vector<Shape*> shapes;
+        size_t count = 1 + random() % 400;
+        for (size_t i = 0; i < count; i++) {
+            unsigned kind = random() % 10;
+            if (kind < 7) {
+                auto point = make_unique<MoveablePoint>();
+                point->center = { coordinate(random), coordinate(random) };
+                point->radius = size(random) / 10;
+                owned.push_back(std::move(point));
+            }
+            else if (kind < 9) {
+                auto button = make_unique<Button>();
+                float left = coordinate(random), top = coordinate(random);
+                button->rectangle = { left, top, left + size(random), top + size(random) / 4 };
+                owned.push_back(std::move(button));
+            }
+            else {
+                owned.push_back(make_unique<NPolygon>());
+            }
+            owned.back()->targetAppState = AppState(stateOf(random));
+            shapes.push_back(owned.back().get());
+        }
+
+        ShapePicker picker(round % 2 ? 16.0f : 64.0f);
+        picker.Build(shapes);
+        for (int step = 0; step < 300; step++) {
+            float x = coordinate(random), y = coordinate(random);
+            for (int state = QUICK_HULL; state <= NONE; state++) {
+                CHECK(picker.Pick(x, y, AppState(state)) == linearPick(shapes, x, y, AppState(state)));
+            }
+
+            // Drag whatever is on top, as the window does.
+            AppState state = AppState(stateOf(random));
+            int picked = picker.Pick(x, y, state);
+            if (picked >= 0) {
+                shapes[size_t(picked)]->OnMouseDrag(coordinate(random), coordinate(random));
+                picker.Moved(picked);
+            }
+        }
+    }
+}
+
+}
+
+int main()
+{
+    testGrid(64.0f, 12.0f, 0);
+    testGrid(64.0f, 12.0f, 1);
+    testGrid(64.0f, 12.0f, 2);
+    testGrid(8.0f, 40.0f, 0);
+    // Radii much larger than the cells make Pick fall back to every cell.
+    testGrid(4.0f, 3000.0f, 1);
+    testShapePicker();
+    return TestResult();
+}
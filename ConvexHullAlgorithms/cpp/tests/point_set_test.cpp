@@ -0,0 +1,166 @@
+#include <cmath>
+#include <cstdint>
+#include <cstdio>
+#include <random>
+#include <string>
+#include <vector>
+
+#include "hullcore/point_set.h"
+#include "hullcore/task_pool.h"
+#include "test_support.h"
+
+using namespace std;
+using namespace hullcore;
+
+namespace {
+
+const char* pointSetPath = "point_set_test.hps";
+const char* csvPath = "point_set_test.csv";
+
+vector<Point2> randomPoints(mt19937& random, size_t count)
+{
+    uniform_int_distribution<int> mantissa(-(1 << 23), 1 << 23);
+    uniform_int_distribution<int> exponent(-60, 20);
+    vector<Point2> points(count);
+    for (Point2& point : points) {
+        point = { ldexp(float(mantissa(random)), exponent(random)), ldexp(float(mantissa(random)), exponent(random)) };
+    }
+    return points;
+}
+
+bool matchesFile(const PointSetFile& file, const vector<Point2>& points)
+{
+    if (file.Count() != points.size()) {
+        return false;
+    }
+    Aabb bounds = ComputeAabb(points.data(), points.size());
+    const Aabb stored = file.Bounds();
+    if (stored.minX != bounds.minX || stored.minY != bounds.minY || stored.maxX != bounds.maxX ||
+        stored.maxY != bounds.maxY) {
+        return false;
+    }
+    for (size_t i = 0; i < points.size(); i++) {
+        if (file.X()[i] != points[i].x || file.Y()[i] != points[i].y) {
+            return false;
+        }
+    }
+    return true;
+}
+
+void testRoundTrip()
+{
+    mt19937 random(140);
+    for (size_t count : { size_t(0), size_t(1), size_t(15), size_t(16), size_t(17), size_t(1000), size_t(100003) }) {
+        vector<Point2> points = randomPoints(random, count);
+        CHECK(WritePointSet(pointSetPath, points.data(), points.size()));
+        CHECK(IsPointSetFile(pointSetPath));
+
+        PointSetFile file;
+        string error;
+        bool opened = file.Open(pointSetPath, &error);
+        if (!opened) {
+            fprintf(stderr, "%zu points: %s\n", count, error.c_str());
+        }
+        CHECK(opened);
+        CHECK(matchesFile(file, points));
+        CHECK(uintptr_t(file.X()) % 64 == 0 && uintptr_t(file.Y()) % 64 == 0);
+
+        vector<size_t> indices;
+        file.CalculateHull(indices);
+        vector<Point2> hull;
+        for (size_t index : indices) {
+            hull.push_back({ file.X()[index], file.Y()[index] });
+        }
+        CHECK(hull == ReferenceHull(points));
+        file.Close();
+
+        // The split-array writer gives the same file.
+        vector<float> x(count);
+        vector<float> y(count);
+        for (size_t i = 0; i < count; i++) {
+            x[i] = points[i].x;
+            y[i] = points[i].y;
+        }
+        CHECK(WritePointSet(pointSetPath, x.data(), y.data(), count));
+        CHECK(file.Open(pointSetPath) && matchesFile(file, points));
+    }
+}
+
+void testCorruptFiles()
+{
+    vector<Point2> points = { { 1, 2 }, { 3, 4 }, { 5, 6 } };
+    CHECK(WritePointSet(pointSetPath, points.data(), points.size()));
+    FILE* file = fopen(pointSetPath, "rb");
+    vector<char> bytes(1 << 10);
+    bytes.resize(fread(bytes.data(), 1, bytes.size(), file));
+    fclose(file);
+
+    auto rejects = [&](const vector<char>& content) {
+        FILE* out = fopen(pointSetPath, "wb");
+        fwrite(content.data(), 1, content.size(), out);
+        fclose(out);
+        PointSetFile reader;
+        string error;
+        return !reader.Open(pointSetPath, &error) && !error.empty();
+    };
+    CHECK(rejects(vector<char>(bytes.begin(), bytes.begin() + 40)));
+    CHECK(rejects(vector<char>(bytes.begin(), bytes.end() - 4)));
+    vector<char> badMagic = bytes;
+    badMagic[0] = 'X';
+    CHECK(rejects(badMagic));
+    vector<char> badVersion = bytes;
+    badVersion[offsetof(PointSetHeader, version)] = 9;
+    CHECK(rejects(badVersion));
+    remove(pointSetPath);
+    PointSetFile reader;
+    CHECK(!reader.Open(pointSetPath));
+}
+
+// Every float printed with %.9g reads back bit for bit, so the imported points
+// must equal the ones written. Lines mix the separators, carry extra columns,
+// and some are headers or junk that must be skipped.
+void testCsvImport(size_t count)
+{
+    mt19937 random{ unsigned(count) };
+    vector<Point2> points = randomPoints(random, count);
+    FILE* csv = fopen(csvPath, "w");
+    fprintf(csv, "id,x,y,label\n");
+    size_t skipped = 1;
+    for (size_t i = 0; i < points.size(); i++) {
+        const char* formats[] = { "%zu,%.9g,%.9g,a\n", "%zu; %.9g ;%.9g\n", "%zu\t%.9g\t%.9g\n", "  %zu   %.9g  %.9g\r\n" };
+        fprintf(csv, formats[i % 4], i, points[i].x, points[i].y);
+        if (i % 1000 == 7) {
+            fprintf(csv, "%zu,not a number,%.9g\n\n", i, points[i].y);
+            skipped++;
+        }
+    }
+    fclose(csv);
+
+    CsvImportOptions options;
+    options.xColumn = 1;
+    options.yColumn = 2;
+    CsvImportStats stats;
+    vector<Point2> read;
+    CHECK(ReadCsv(csvPath, options, TaskPool::Default(), read, &stats));
+    CHECK(read == points);
+    CHECK(stats.pointCount == count && stats.skippedCount == skipped && stats.lineCount == count + skipped);
+
+    CHECK(ImportCsv(csvPath, pointSetPath, options, TaskPool::Default(), &stats));
+    PointSetFile file;
+    CHECK(file.Open(pointSetPath) && matchesFile(file, points));
+    file.Close();
+    remove(csvPath);
+    remove(pointSetPath);
+}
+
+}
+
+int main()
+{
+    testRoundTrip();
+    testCorruptFiles();
+    testCsvImport(100);
+    // Over 4 MiB of text, so the importer parses several blocks in parallel.
+    testCsvImport(300000);
+    return TestResult();
+}
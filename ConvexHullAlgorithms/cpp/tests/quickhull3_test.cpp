@@ -0,0 +1,174 @@
+#include <algorithm>
+#include <cmath>
+#include <cstdio>
+#include <random>
+#include <set>
+#include <vector>
+
+#include "hullcore/quickhull3.h"
+#include "test_support.h"
+
+using namespace std;
+using namespace hullcore;
+
+namespace {
+
+vector<Point3> randomPoints(mt19937& random, int kind, size_t count)
+{
+    uniform_real_distribution<float> coordinate(-100.0f, 100.0f);
+    uniform_real_distribution<float> unit(-1.0f, 1.0f);
+    uniform_int_distribution<int> grid(-3, 3);
+    vector<Point3> points(count);
+    for (Point3& point : points) {
+        switch (kind) {
+        case 0:
+            point = { coordinate(random), coordinate(random), coordinate(random) };
+            break;
+        case 1: {
+            // On a sphere, so nearly every point is a vertex.
+            float x = unit(random), y = unit(random), z = unit(random);
+            float length = sqrt(x * x + y * y + z * z) + 1e-6f;
+            point = { 50 * x / length, 50 * y / length, 50 * z / length };
+            break;
+        }
+        default:
+            // A small grid: duplicates, and many points on each face plane.
+            point = { float(grid(random)), float(grid(random)), float(grid(random)) };
+            break;
+        }
+    }
+    return points;
+}
+
+// Structure of a closed, outward-facing triangle mesh around every input point.
+bool checkMesh(const HalfEdgeMesh& mesh, const vector<Point3>& points)
+{
+    bool ok = true;
+    size_t edgeCount = mesh.edges.size();
+    ok = ok && mesh.vertexIndices.size() == mesh.vertices.size() && edgeCount == 3 * mesh.faces.size();
+    for (size_t v = 0; ok && v < mesh.vertices.size(); v++) {
+        ok = mesh.vertexIndices[v] < points.size() && points[mesh.vertexIndices[v]] == mesh.vertices[v];
+    }
+
+    vector<bool> usedVertex(mesh.vertices.size());
+    for (uint32_t e = 0; ok && e < edgeCount; e++) {
+        const HalfEdgeMesh::HalfEdge& edge = mesh.edges[e];
+        ok = edge.twin < edgeCount && edge.next < edgeCount && edge.vertex < mesh.vertices.size() &&
+            edge.face < mesh.faces.size();
+        if (!ok)
+            break;
+        const HalfEdgeMesh::HalfEdge& twin = mesh.edges[edge.twin];
+        const HalfEdgeMesh::HalfEdge& next = mesh.edges[edge.next];
+        // Twins pair up and run the same edge the other way, between
+        // different faces; next cycles through three edges of one face.
+        ok = edge.twin != e && twin.twin == e && twin.face != edge.face && twin.vertex == next.vertex &&
+            mesh.edges[twin.next].vertex == edge.vertex && next.face == edge.face &&
+            mesh.edges[next.next].next == e;
+        usedVertex[edge.vertex] = true;
+    }
+    for (uint32_t f = 0; ok && f < mesh.faces.size(); f++) {
+        ok = mesh.faces[f] < edgeCount && mesh.edges[mesh.faces[f]].face == f;
+    }
+    ok = ok && count(usedVertex.begin(), usedVertex.end(), false) == 0;
+
+    // Euler's formula for a closed surface of genus 0: V - E + F = 2.
+    ok = ok && long(mesh.vertices.size()) - long(edgeCount / 2) + long(mesh.faces.size()) == 2;
+
+    // No input point above any face; every face is a proper triangle, so
+    // some vertex lies strictly below it.
+    for (uint32_t f = 0; ok && f < mesh.faces.size(); f++) {
+        uint32_t e = mesh.faces[f];
+        Point3 a = mesh.vertices[mesh.edges[e].vertex];
+        Point3 b = mesh.vertices[mesh.edges[mesh.edges[e].next].vertex];
+        Point3 c = mesh.vertices[mesh.edges[mesh.edges[mesh.edges[e].next].next].vertex];
+        bool below = false;
+        for (const Point3& point : points) {
+            double side = Orient3d(a, b, c, point);
+            ok = ok && side <= 0;
+            below = below || side < 0;
+        }
+        ok = ok && below;
+    }
+    return ok;
+}
+
+// In general position the hull facets are exactly the triangles of input
+// points with every other point strictly on one side.
+void testAgainstBruteForce()
+{
+    mt19937 random(21);
+    for (int round = 0; round < 100; round++) {
+        vector<Point3> points = randomPoints(random, round % 2, 4 + random() % 26);
+        size_t facetCount = 0;
+        set<size_t> vertices;
+        bool general = true;
+        for (size_t i = 0; i < points.size(); i++) {
+            for (size_t j = i + 1; j < points.size(); j++) {
+                for (size_t k = j + 1; k < points.size(); k++) {
+                    int above = 0;
+                    int below = 0;
+                    for (size_t m = 0; m < points.size(); m++) {
+                        if (m == i || m == j || m == k)
+                            continue;
+                        double side = Orient3d(points[i], points[j], points[k], points[m]);
+                        general = general && side != 0;
+                        (side > 0 ? above : below)++;
+                    }
+                    if (above == 0 || below == 0) {
+                        facetCount++;
+                        vertices.insert({ i, j, k });
+                    }
+                }
+            }
+        }
+        if (!general) {
+            continue;
+        }
+
+        HalfEdgeMesh mesh;
+        CHECK(CalculateQuickHull3(points.data(), points.size(), mesh));
+        CHECK(checkMesh(mesh, points));
+        CHECK(mesh.faces.size() == facetCount);
+        set<size_t> meshVertices(mesh.vertexIndices.begin(), mesh.vertexIndices.end());
+        CHECK(meshVertices == vertices);
+    }
+}
+
+void testMeshInvariants()
+{
+    mt19937 random(210);
+    for (int round = 0; round < 60; round++) {
+        vector<Point3> points = randomPoints(random, round % 3, 4 + random() % (round % 10 == 0 ? 5000 : 500));
+        HalfEdgeMesh mesh;
+        bool built = CalculateQuickHull3(points.data(), points.size(), mesh);
+        // Tiny grids can come out flat; then the mesh must be empty.
+        CHECK(built || (mesh.faces.empty() && mesh.vertices.empty()));
+        if (built) {
+            CHECK(checkMesh(mesh, points));
+        }
+    }
+}
+
+void testFlatInputs()
+{
+    HalfEdgeMesh mesh;
+    CHECK(!CalculateQuickHull3(nullptr, 0, mesh));
+    vector<Point3> plane;
+    for (int i = 0; i < 50; i++) {
+        plane.push_back({ float(i % 7), float(i / 7), float(2 * (i % 7) - 3 * (i / 7)) });
+    }
+    CHECK(!CalculateQuickHull3(plane.data(), plane.size(), mesh));
+    CHECK(mesh.faces.empty() && mesh.edges.empty() && mesh.vertices.empty());
+    vector<Point3> line = { { 0, 0, 0 }, { 1, 1, 1 }, { 2, 2, 2 }, { 2, 2, 2 } };
+    CHECK(!CalculateQuickHull3(line.data(), line.size(), mesh));
+}
+
+}
+
+int main()
+{
+    testAgainstBruteForce();
+    testMeshInvariants();
+    testFlatInputs();
+    return TestResult();
+}
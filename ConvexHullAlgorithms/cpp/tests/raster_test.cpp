@@ -0,0 +1,120 @@
+#include <cstdio>
+#include <cstring>
+#include <string>
+#include <vector>
+
+#include "scene/raster_canvas.h"
+#include "scene/shapes.h"
+#include "test_support.h"
+
+using namespace std;
+using hullcore::Point2;
+
+namespace {
+
+// Channel steps a pixel may differ by from the golden image, for compilers
+// that round the coverage math slightly differently.
+const int goldenTolerance = 2;
+
+// A small QuickHull scene with every primitive the canvas has: grid lines,
+// filled circles, hull edges, a polygon and a button.
+void drawScene(RasterCanvas& canvas)
+{
+    canvas.Clear(ColorFromRgb(0x000000));
+
+    Grid grid;
+    grid.lineSpacing = 25.0f;
+    grid.gridLinesStrokeWidth = 1.0f;
+    grid.axisLinesStrokeWidth = 2.0f;
+    grid.gridLinesColor = ColorFromRgb(0x808080);
+    grid.axisLinesColor = ColorFromRgb(0xFFFFFF);
+    grid.Draw(canvas);
+
+    const Point2 centers[] = {
+        { 40.5f, 30.25f }, { 150.0f, 22.0f }, { 178.75f, 95.5f }, { 120.0f, 131.0f }, { 30.0f, 118.0f },
+        { 95.0f, 70.0f }, { 70.25f, 45.75f }, { 132.0f, 88.0f }, { 60.0f, 100.0f }, { 105.5f, 35.5f },
+    };
+    QuickHull hull;
+    vector<MoveablePoint> points(sizeof(centers) / sizeof(centers[0]));
+    for (size_t i = 0; i < points.size(); i++) {
+        points[i].center = centers[i];
+        points[i].radius = 4.5f;
+        points[i].fillColor = ColorFromRgb(i % 3 ? 0x0000FF : 0xFF0000);
+        hull.points.push_back(&points[i]);
+    }
+    for (MoveablePoint& point : points) {
+        point.Draw(canvas);
+    }
+    hull.Draw(canvas);
+
+    NPolygon polygon;
+    polygon.points = { { 10, 140 }, { 60, 135 }, { 35, 145.5f } };
+    polygon.color = ColorFromRgb(0x00FFFF, 0.75f);
+    polygon.strokeWidth = 1.5f;
+    polygon.Draw(canvas);
+
+    Button button;
+    button.rectangle = { 8.5f, 6.5f, 60.0f, 20.0f };
+    button.fillColor = ColorFromRgb(0xFFFFFF);
+    button.outlineColor = ColorFromRgb(0xFF0000);
+    button.textColor = ColorFromRgb(0x000000);
+    button.text = "Hull";
+    button.outlineWidth = 2.0f;
+    button.Draw(canvas);
+    button.WriteText(canvas);
+}
+
+void testCompareImages()
+{
+    RasterCanvas a(8, 6);
+    RasterCanvas b(8, 6);
+    a.Clear(ColorFromRgb(0x102030));
+    b.Clear(ColorFromRgb(0x102030));
+    ImageDifference same = CompareImages(a, b);
+    CHECK(same.differentPixels == 0);
+    CHECK(same.maxChannelDelta == 0);
+
+    b.FillRectangle({ 2, 2, 3, 3 }, ColorFromRgb(0x102033));
+    ImageDifference one = CompareImages(a, b);
+    CHECK(one.differentPixels == 1);
+    CHECK(one.maxChannelDelta == 3);
+    CHECK(CompareImages(a, b, 3).differentPixels == 0);
+
+    RasterCanvas other(8, 7);
+    CHECK(CompareImages(a, other).differentPixels == 8 * 7);
+}
+
+// Run with --update to rewrite the golden image after an intended change.
+void testGoldenScene(bool update)
+{
+    RasterCanvas canvas(200, 150);
+    drawScene(canvas);
+    string path = TestDataPath("raster_scene.ppm");
+    if (update) {
+        CHECK(canvas.WritePpm(path.c_str()));
+        return;
+    }
+
+    RasterCanvas golden(0, 0);
+    bool loaded = golden.ReadPpm(path.c_str());
+    CHECK(loaded);
+    if (!loaded) {
+        return;
+    }
+    ImageDifference difference = CompareImages(canvas, golden, goldenTolerance);
+    if (difference.differentPixels) {
+        fprintf(stderr, "%zu pixels differ from %s, by up to %d\n", difference.differentPixels, path.c_str(),
+            difference.maxChannelDelta);
+    }
+    CHECK(difference.differentPixels == 0);
+}
+
+}
+
+int main(int argc, char** argv)
+{
+    bool update = argc > 1 && strcmp(argv[1], "--update") == 0;
+    testCompareImages();
+    testGoldenScene(update);
+    return TestResult();
+}
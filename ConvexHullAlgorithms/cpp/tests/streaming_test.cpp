@@ -0,0 +1,118 @@
+#include <cmath>
+#include <cstdio>
+#include <random>
+#include <string>
+#include <vector>
+
+#include "hullcore/streaming_hull.h"
+#include "test_support.h"
+
+using namespace std;
+using namespace hullcore;
+
+namespace {
+
+bool writeRaw(const char* path, const vector<Point2>& points, size_t extraBytes = 0)
+{
+    FILE* file = fopen(path, "wb");
+    if (!file) {
+        return false;
+    }
+    bool ok = fwrite(points.data(), sizeof(Point2), points.size(), file) == points.size();
+    for (size_t i = 0; i < extraBytes; i++) {
+        ok = ok && fputc(0, file) != EOF;
+    }
+    return fclose(file) == 0 && ok;
+}
+
+// The streamed hull must be the hull of the whole input, and each reported
+// index must name the stream point the vertex came from.
+bool matchesReference(const StreamingHull& hull, const vector<Point2>& points, const vector<Point2>& reference)
+{
+    const vector<Point2>& vertices = hull.Vertices();
+    if (vertices != reference || hull.Indices().size() != vertices.size() ||
+        hull.PointCount() != points.size()) {
+        return false;
+    }
+    for (size_t i = 0; i < vertices.size(); i++) {
+        if (hull.Indices()[i] >= points.size() || points[hull.Indices()[i]] != vertices[i]) {
+            return false;
+        }
+    }
+    return true;
+}
+
+vector<Point2> randomPoints(mt19937& random, size_t count, bool mixedScale)
+{
+    uniform_real_distribution<float> coordinate(-1000.0f, 1000.0f);
+    uniform_int_distribution<int> exponent(-30, 30);
+    uniform_int_distribution<int> grid(-6, 6);
+    vector<Point2> points(count);
+    for (Point2& point : points) {
+        if (mixedScale) {
+            point = { ldexp(float(grid(random)), exponent(random)), ldexp(float(grid(random)), exponent(random)) };
+        }
+        else {
+            point = { coordinate(random), coordinate(random) };
+        }
+    }
+    return points;
+}
+
+void testChunkedAdd()
+{
+    mt19937 random(13);
+    for (int round = 0; round < 100; round++) {
+        vector<Point2> points = randomPoints(random, 1 + random() % 3000, round % 2);
+        vector<Point2> reference = ReferenceHull(points);
+        size_t chunk = 1 + random() % 500;
+        HullEngine engine = round % 3 ? HullEngine::QuickHull : HullEngine::MonotoneChain;
+        StreamingHull hull(engine);
+        for (size_t begin = 0; begin < points.size(); begin += chunk) {
+            hull.Add(points.data() + begin, min(chunk, points.size() - begin));
+        }
+        CHECK(matchesReference(hull, points, reference));
+
+        hull.Reset();
+        CHECK(hull.Vertices().empty() && hull.PointCount() == 0);
+        hull.Add(points.data(), points.size());
+        CHECK(matchesReference(hull, points, reference));
+    }
+}
+
+void testFiles()
+{
+    const char* path = "streaming_test_points.bin";
+    mt19937 random(14);
+    for (int round = 0; round < 10; round++) {
+        vector<Point2> points = randomPoints(random, 1 + random() % 200000, round % 2);
+        vector<Point2> reference = ReferenceHull(points);
+        CHECK(writeRaw(path, points));
+        for (StreamSource source : { StreamSource::Read, StreamSource::Map }) {
+            for (size_t chunkPoints : { size_t(1) << 10, size_t(12345), size_t(1) << 20 }) {
+                StreamingOptions options;
+                options.chunkPoints = chunkPoints;
+                options.source = source;
+                StreamingHull hull;
+                CHECK(StreamFileHull(path, options, hull));
+                CHECK(matchesReference(hull, points, reference));
+            }
+        }
+    }
+
+    // A trailing partial point and a missing file are both refused.
+    CHECK(writeRaw(path, { { 1, 2 }, { 3, 4 } }, 3));
+    StreamingHull hull;
+    CHECK(!StreamFileHull(path, StreamingOptions(), hull));
+    remove(path);
+    CHECK(!StreamFileHull(path, StreamingOptions(), hull));
+}
+
+}
+
+int main()
+{
+    testChunkedAdd();
+    testFiles();
+    return TestResult();
+}
@@ -0,0 +1,160 @@
+#pragma once
+
+#include <algorithm>
+#include <cstdio>
+#include <cstdlib>
+#include <string>
+#include <vector>
+
+#include "hullcore/containment.h"
+#include "hullcore/hull.h"
+#include "hullcore/point.h"
+#include "hullcore/predicates.h"
+
+// The test executables need no framework: a failed CHECK reports where it
+// failed and the test keeps going, and main returns TestResult() so ctest sees
+// any failure.
+
+inline int& testFailures()
+{
+    static int failures = 0;
+    return failures;
+}
+
+#define CHECK(condition)                                                                    \
+    do {                                                                                    \
+        if (!(condition)) {                                                                 \
+            std::fprintf(stderr, "%s:%d: CHECK failed: %s\n", __FILE__, __LINE__, #condition); \
+            testFailures()++;                                                               \
+        }                                                                                   \
+    } while (0)
+
+inline int TestResult()
+{
+    if (testFailures()) {
+        std::fprintf(stderr, "%d check(s) failed\n", testFailures());
+        return 1;
+    }
+    return 0;
+}
+
+// Path of a file under tests/data.
+inline std::string TestDataPath(const char* name)
+{
+    return std::string(HULLCORE_TEST_DATA) + "/" + name;
+}
+
+// One point per line as two numbers; regression inputs are stored as hex
+// floats (%a) so they round-trip bit for bit. Lines starting with # are
+// comments.
+inline bool ReadPoints(const std::string& path, std::vector<hullcore::Point2>& points)
+{
+    FILE* file = std::fopen(path.c_str(), "r");
+    if (!file) {
+        return false;
+    }
+    points.clear();
+    char line[256];
+    while (std::fgets(line, sizeof(line), file)) {
+        if (line[0] == '#') {
+            continue;
+        }
+        char* end = line;
+        float x = std::strtof(end, &end);
+        char* yBegin = end;
+        float y = std::strtof(yBegin, &end);
+        if (end != yBegin) {
+            points.push_back({ x, y });
+        }
+    }
+    std::fclose(file);
+    return true;
+}
+
+// Hull in CalculateHull's order from a monotone chain that decides every turn
+// with the exact expansion alone, so it shares nothing with the filtered
+// predicates the engines use on their fast paths.
+inline std::vector<hullcore::Point2> ReferenceHull(std::vector<hullcore::Point2> points)
+{
+    using hullcore::Point2;
+    auto less = [](const Point2& a, const Point2& b) { return a.x < b.x || (a.x == b.x && a.y < b.y); };
+    std::sort(points.begin(), points.end(), less);
+    points.erase(std::unique(points.begin(), points.end()), points.end());
+    if (points.size() < 2) {
+        return points;
+    }
+
+    std::vector<Point2> hull(2 * points.size());
+    size_t k = 0;
+    for (size_t i = 0; i < points.size(); i++) {
+        while (k >= 2 && hullcore::Orient2dExact(hull[k - 2], hull[k - 1], points[i]) <= 0)
+            k--;
+        hull[k++] = points[i];
+    }
+    for (size_t i = points.size() - 1, lowerSize = k + 1; i > 0; i--) {
+        while (k >= lowerSize && hullcore::Orient2dExact(hull[k - 2], hull[k - 1], points[i - 1]) <= 0)
+            k--;
+        hull[k++] = points[i - 1];
+    }
+    hull.resize(k - 1);
+    return hull;
+}
+
+// The hull vertices themselves, in CalculateHull's order.
+inline std::vector<hullcore::Point2> HullOf(const std::vector<hullcore::Point2>& points)
+{
+    std::vector<size_t> indices;
+    hullcore::CalculateHull(points.data(), points.size(), indices);
+    std::vector<hullcore::Point2> hull;
+    for (size_t index : indices) {
+        hull.push_back(points[index]);
+    }
+    return hull;
+}
+
+// Where point lies against a hull in CalculateHull's order, from the exact
+// predicate alone. Hulls of one or two vertices are a point and a segment.
+inline hullcore::Containment ReferenceClassify(const std::vector<hullcore::Point2>& hull, hullcore::Point2 point)
+{
+    using hullcore::Containment;
+    if (hull.size() <= 2) {
+        if (hull.empty() || hullcore::Orient2dExact(hull.front(), hull.back(), point) != 0) {
+            return Containment::Outside;
+        }
+        bool between = std::min(hull.front().x, hull.back().x) <= point.x &&
+            point.x <= std::max(hull.front().x, hull.back().x) && std::min(hull.front().y, hull.back().y) <= point.y &&
+            point.y <= std::max(hull.front().y, hull.back().y);
+        return between ? Containment::Boundary : Containment::Outside;
+    }
+    bool boundary = false;
+    for (size_t i = 0; i < hull.size(); i++) {
+        double side = hullcore::Orient2dExact(hull[i], hull[(i + 1) % hull.size()], point);
+        if (side < 0) {
+            return Containment::Outside;
+        }
+        boundary = boundary || side == 0;
+    }
+    return boundary ? Containment::Boundary : Containment::Inside;
+}
+
+// Whether polygon is reference read from some starting vertex onwards.
+inline bool SameCycle(const std::vector<hullcore::Point2>& polygon, const std::vector<hullcore::Point2>& reference)
+{
+    if (polygon.size() != reference.size()) {
+        return false;
+    }
+    if (polygon.empty()) {
+        return true;
+    }
+    auto start = std::find(reference.begin(), reference.end(), polygon[0]);
+    if (start == reference.end()) {
+        return false;
+    }
+    size_t offset = size_t(start - reference.begin());
+    for (size_t i = 0; i < polygon.size(); i++) {
+        if (polygon[i] != reference[(offset + i) % reference.size()]) {
+            return false;
+        }
+    }
+    return true;
+}